@@ -0,0 +1,312 @@
+
+#include "headers.h"
+#include "bawriter.h"
+#include <ctime>
+
+/**
+ * layout checks : sizes of 32-bit MSVC engine build
+ */
+
+#define CHECK_CHUNK_SIZE(T,S) typedef char T##SizeCheck[ ( sizeof(ba::T) == (S) ) ? 1 : -1 ]
+
+CHECK_CHUNK_SIZE( ChunkHeader, 8 );
+CHECK_CHUNK_SIZE( AssetChunk, 28 );
+CHECK_CHUNK_SIZE( TextureChunk, 292 );
+CHECK_CHUNK_SIZE( ShaderChunk, 440 );
+CHECK_CHUNK_SIZE( GeometryChunk, 288 );
+CHECK_CHUNK_SIZE( PreparedChunk, 16 );
+CHECK_CHUNK_SIZE( Triangle, 12 );
+CHECK_CHUNK_SIZE( FrameChunk, 328 );
+CHECK_CHUNK_SIZE( AtomicChunk, 12 );
+CHECK_CHUNK_SIZE( ClumpChunk, 276 );
+
+/**
+ * module locals
+ */
+
+// Direct3D constants used by engine defaults
+static const int d3dTAddressWrap    = 1; // D3DTADDRESS_WRAP
+static const int d3dTexFLinear      = 2; // D3DTEXF_LINEAR
+static const int d3dBlendSrcAlpha   = 5; // D3DBLEND_SRCALPHA
+static const int d3dBlendInvSrcAlpha= 6; // D3DBLEND_INVSRCALPHA
+static const int d3dBlendOpAdd      = 1; // D3DBLENDOP_ADD
+static const int d3dCmpGreater      = 5; // D3DCMP_GREATER
+
+// engine::ShaderFlags
+static const unsigned int sfCulling   = 1;
+static const unsigned int sfCollision = 2;
+static const unsigned int sfCaching   = 32;
+static const unsigned int sfLighting  = 64;
+
+class ChunkWriter
+{
+private:
+    FILE*     _file;
+    ba::auid  _nextId;
+public:
+    ChunkWriter(FILE* file) : _file(file), _nextId(1) {}
+public:
+    // unique non-zero identifier (engine uses object addresses)
+    inline ba::auid newId(void) { return _nextId++; }
+    inline void write(const void* data, unsigned int size)
+    {
+        if( size && fwrite( data, size, 1, _file ) != 1 ) throw ConvException( "write error" );
+    }
+    inline void header(int type, unsigned int size)
+    {
+        ba::ChunkHeader chunkHeader;
+        chunkHeader.type = type;
+        chunkHeader.size = int( size );
+        write( &chunkHeader, sizeof(chunkHeader) );
+    }
+    inline void binary(const void* data, unsigned int size)
+    {
+        header( BA_BINARY, size );
+        write( data, size );
+    }
+};
+
+static void copyName(char* chunkName, const std::string& name)
+{
+    memset( chunkName, 0, ba::maxNameLength );
+    strncpy( chunkName, name.c_str(), ba::maxNameLength - 1 );
+}
+
+static inline ba::ColorValue colorValue(float r, float g, float b, float a)
+{
+    ba::ColorValue result;
+    result.r = r, result.g = g, result.b = b, result.a = a;
+    return result;
+}
+
+static void writeShader(ChunkWriter* writer, const SceneShader* shader, const std::vector<ba::auid>& textureIds, ba::auid shaderId)
+{
+    // see Geometry::captureMeshData() & Shader::Shader()
+    ba::ShaderChunk chunk;
+    memset( &chunk, 0, sizeof(chunk) );
+    chunk.id = shaderId;
+    copyName( chunk.name, shader->name );
+    chunk.numLayers = ( shader->textureId >= 0 ) ? 1 : 0;
+    if( shader->textureId >= 0 ) chunk.layerTexture[0] = textureIds[shader->textureId];
+    chunk.materialColor.diffuse  = colorValue( shader->diffuse[0], shader->diffuse[1], shader->diffuse[2], shader->diffuse[3] );
+    chunk.materialColor.ambient  = colorValue( 0,0,0,1 );
+    chunk.materialColor.specular = colorValue( shader->specular[0], shader->specular[1], shader->specular[2], shader->specular[3] );
+    chunk.materialColor.emissive = colorValue( 0,0,0,1 );
+    chunk.materialColor.power    = shader->power;
+    chunk.flags             = sfCulling | sfCollision | sfCaching | sfLighting;
+    chunk.lightset          = 0;
+    chunk.srcBlend          = d3dBlendSrcAlpha;
+    chunk.dstBlend          = d3dBlendInvSrcAlpha;
+    chunk.blendOp           = d3dBlendOpAdd;
+    chunk.alphaTestFunction = d3dCmpGreater;
+    chunk.alphaTestRef      = 128;
+    chunk.hasEffect         = false;
+
+    writer->header( BA_SHADER, sizeof(chunk) );
+    writer->write( &chunk, sizeof(chunk) );
+}
+
+static void writeGeometry(ChunkWriter* writer, const SceneGeometry* geometry, const std::vector<ba::auid>& textureIds, ba::auid geometryId)
+{
+    unsigned int numVertices = geometry->getNumVertices();
+    unsigned int i;
+
+    ba::GeometryChunk chunk;
+    memset( &chunk, 0, sizeof(chunk) );
+    chunk.id = geometryId;
+    copyName( chunk.name, geometry->name );
+    chunk.numVertices      = int( numVertices );
+    chunk.numTriangles     = int( geometry->triangles.size() );
+    chunk.numUVSets        = geometry->uvs.size() ? 1 : 0;
+    chunk.numShaders       = int( geometry->shaders.size() );
+    chunk.numPrelights     = geometry->prelights.size() ? 1 : 0;
+    chunk.numOcTreeSectors = 0;
+    chunk.sharedShaders    = false;
+    chunk.hasEffect        = false;
+    chunk.hasSkin          = false;
+    writer->header( BA_GEOMETRY, sizeof(chunk) );
+    writer->write( &chunk, sizeof(chunk) );
+
+    // shaders
+    std::vector<ba::auid> shaderIds( geometry->shaders.size() );
+    for( i=0; i<geometry->shaders.size(); i++ )
+    {
+        shaderIds[i] = writer->newId();
+        writeShader( writer, &geometry->shaders[i], textureIds, shaderIds[i] );
+    }
+
+    // vertex data
+    writer->binary( numVertices ? &geometry->vertices[0] : NULL, sizeof(float) * 3 * numVertices );
+    writer->binary( numVertices ? &geometry->normals[0] : NULL, sizeof(float) * 3 * numVertices );
+    if( chunk.numUVSets ) writer->binary( &geometry->uvs[0], sizeof(float) * 2 * numVertices );
+    if( chunk.numPrelights ) writer->binary( &geometry->prelights[0], sizeof(ba::dword) * numVertices );
+
+    // triangles
+    std::vector<ba::Triangle> triangles( geometry->triangles.size() );
+    for( i=0; i<triangles.size(); i++ )
+    {
+        memset( &triangles[i], 0, sizeof(ba::Triangle) );
+        triangles[i].vertexId[0] = ba::word( geometry->triangles[i].vertexId[0] );
+        triangles[i].vertexId[1] = ba::word( geometry->triangles[i].vertexId[1] );
+        triangles[i].vertexId[2] = ba::word( geometry->triangles[i].vertexId[2] );
+        triangles[i].shaderId    = geometry->triangles[i].shaderId;
+    }
+    writer->binary( triangles.size() ? &triangles[0] : NULL, sizeof(ba::Triangle) * triangles.size() );
+
+    // shader identifiers
+    writer->binary( shaderIds.size() ? &shaderIds[0] : NULL, sizeof(ba::auid) * shaderIds.size() );
+
+    // results of mesh preparation, engine instances such geometry without D3DX processing
+    bool hasTangents = ( geometry->tangents.size() == numVertices * 3 ) && ( geometry->binormals.size() == numVertices * 3 );
+    if( geometry->optimized || hasTangents )
+    {
+        ba::PreparedChunk preparedChunk;
+        memset( &preparedChunk, 0, sizeof(preparedChunk) );
+        preparedChunk.numVertices  = int( numVertices );
+        preparedChunk.numTriangles = int( geometry->triangles.size() );
+        preparedChunk.tangentUVSet = hasTangents ? 0 : -1;
+        preparedChunk.optimized    = geometry->optimized;
+        writer->header( BA_PREPARED, sizeof(preparedChunk) );
+        writer->write( &preparedChunk, sizeof(preparedChunk) );
+        if( hasTangents )
+        {
+            writer->binary( &geometry->tangents[0], sizeof(float) * 3 * numVertices );
+            writer->binary( &geometry->binormals[0], sizeof(float) * 3 * numVertices );
+        }
+    }
+}
+
+static void writeClump(ChunkWriter* writer, const SceneClump* clump, const std::vector<ba::auid>& textureIds)
+{
+    unsigned int i;
+
+    ba::ClumpChunk chunk;
+    memset( &chunk, 0, sizeof(chunk) );
+    chunk.id = writer->newId();
+    copyName( chunk.name, clump->name );
+    chunk.numFrames     = int( clump->frames.size() );
+    chunk.numGeometries = int( clump->geometries.size() );
+    chunk.numAtomics    = int( clump->atomics.size() );
+    chunk.numLights     = 0;
+    writer->header( BA_CLUMP, sizeof(chunk) );
+    writer->write( &chunk, sizeof(chunk) );
+
+    // frames, parents precede children
+    std::vector<ba::auid> frameIds( clump->frames.size() );
+    for( i=0; i<clump->frames.size(); i++ )
+    {
+        const SceneFrame* frame = &clump->frames[i];
+        frameIds[i] = writer->newId();
+        ba::FrameChunk frameChunk;
+        memset( &frameChunk, 0, sizeof(frameChunk) );
+        frameChunk.id = frameIds[i];
+        copyName( frameChunk.name, frame->name );
+        memcpy( frameChunk.matrix, frame->matrix, sizeof(frameChunk.matrix) );
+        frameChunk.parent = ( frame->parentId >= 0 ) ? frameIds[frame->parentId] : 0;
+        writer->header( BA_FRAME, sizeof(frameChunk) );
+        writer->write( &frameChunk, sizeof(frameChunk) );
+    }
+
+    // geometries
+    std::vector<ba::auid> geometryIds( clump->geometries.size() );
+    for( i=0; i<clump->geometries.size(); i++ )
+    {
+        geometryIds[i] = writer->newId();
+        writeGeometry( writer, &clump->geometries[i], textureIds, geometryIds[i] );
+    }
+
+    // atomics
+    for( i=0; i<clump->atomics.size(); i++ )
+    {
+        ba::AtomicChunk atomicChunk;
+        atomicChunk.id         = writer->newId();
+        atomicChunk.geometryId = geometryIds[clump->atomics[i].geometryId];
+        atomicChunk.frameId    = frameIds[clump->atomics[i].frameId];
+        writer->header( BA_ATOMIC, sizeof(atomicChunk) );
+        writer->write( &atomicChunk, sizeof(atomicChunk) );
+    }
+}
+
+/**
+ * binary asset writing
+ */
+
+void writeBinaryAsset(const SceneClump* clump, const char* fileName)
+{
+    // asset is written to temporary file first, so interrupted
+    // conversion never leaves truncated asset under the real name
+    std::string tempName = fileName;
+    tempName += ".tmp";
+
+    FILE* file = fopen( tempName.c_str(), "wb" );
+    if( !file ) throw ConvException( "can't write \"%s\"", tempName.c_str() );
+
+    try
+    {
+        ChunkWriter writer( file );
+        unsigned int i;
+
+        // asset chunk
+        time_t currentTime = time( NULL );
+        struct tm* utc = gmtime( &currentTime );
+        ba::AssetChunk chunk;
+        memset( &chunk, 0, sizeof(chunk) );
+        chunk.numTextures = int( clump->textures.size() );
+        chunk.numBSPs     = 0;
+        chunk.numClumps   = 1;
+        if( utc )
+        {
+            chunk.creationTime.year      = ba::word( utc->tm_year + 1900 );
+            chunk.creationTime.month     = ba::word( utc->tm_mon + 1 );
+            chunk.creationTime.dayOfWeek = ba::word( utc->tm_wday );
+            chunk.creationTime.day       = ba::word( utc->tm_mday );
+            chunk.creationTime.hour      = ba::word( utc->tm_hour );
+            chunk.creationTime.minute    = ba::word( utc->tm_min );
+            chunk.creationTime.second    = ba::word( utc->tm_sec );
+        }
+        writer.header( BA_ASSET, sizeof(chunk) );
+        writer.write( &chunk, sizeof(chunk) );
+
+        // textures, filtering is the same as engine sets for x-file textures
+        std::vector<ba::auid> textureIds( clump->textures.size() );
+        for( i=0; i<clump->textures.size(); i++ )
+        {
+            textureIds[i] = writer.newId();
+            ba::TextureChunk textureChunk;
+            memset( &textureChunk, 0, sizeof(textureChunk) );
+            textureChunk.id = textureIds[i];
+            copyName( textureChunk.name, clump->textures[i].name );
+            textureChunk.addressTypeU  = d3dTAddressWrap;
+            textureChunk.addressTypeV  = d3dTAddressWrap;
+            textureChunk.borderColor   = 0xFF000000;
+            textureChunk.magFilter     = d3dTexFLinear;
+            textureChunk.minFilter     = d3dTexFLinear;
+            textureChunk.mipFilter     = d3dTexFLinear;
+            textureChunk.maxAnisotropy = 1;
+            textureChunk.lodBias       = 0.0f;
+            writer.header( BA_TEXTURE, sizeof(textureChunk) );
+            writer.write( &textureChunk, sizeof(textureChunk) );
+        }
+
+        // clump
+        writeClump( &writer, clump, textureIds );
+    }
+    catch( ConvException& )
+    {
+        fclose( file );
+        remove( tempName.c_str() );
+        throw;
+    }
+
+    if( fclose( file ) != 0 )
+    {
+        remove( tempName.c_str() );
+        throw ConvException( "can't write \"%s\"", tempName.c_str() );
+    }
+    remove( fileName );
+    if( rename( tempName.c_str(), fileName ) != 0 )
+    {
+        remove( tempName.c_str() );
+        throw ConvException( "can't write \"%s\"", fileName );
+    }
+}
@@ -0,0 +1,173 @@
+/**
+ * This source code is a part of D3 game project.
+ * (c) Digital Dimension Development, 2004-2005
+ *
+ * @description asset converter : binary asset writer
+ *
+ * @author bad3p
+ */
+
+#ifndef ASSETCONV_BAWRITER_INCLUDED
+#define ASSETCONV_BAWRITER_INCLUDED
+
+#include "headers.h"
+#include "scene.h"
+
+/**
+ * chunk layouts below are the exact copies of chunks used by engine
+ * (see engine/asset.h and Chunk structures of engine classes);
+ * they are declared with portable types, so the layout is the same
+ * for 32-bit MSVC build and for 32/64-bit GCC builds; any change of
+ * engine chunk must be reflected here
+ */
+
+#define BA_ASSET     0x61623364
+#define BA_TEXTURE   0x7478740D
+#define BA_CLUMP     0x706C630D
+#define BA_FRAME     0x6D72660D
+#define BA_GEOMETRY  0x6F65670D
+#define BA_SHADER    0x6468730D
+#define BA_ATOMIC    0x6F74610D
+#define BA_BINARY    0x6E69620D
+#define BA_PREPARED  0x7072700D
+
+namespace ba
+{
+
+typedef unsigned int   auid;
+typedef unsigned int   dword;
+typedef unsigned short word;
+
+const int maxNameLength    = 256; // engine::maxNameLength
+const int maxTextureLayers = 4;   // engine::maxTextureLayers
+
+struct ColorValue { float r, g, b, a; };                                  // D3DCOLORVALUE
+struct Material   { ColorValue diffuse, ambient, specular, emissive; float power; }; // D3DMATERIAL9
+struct SystemTime { word year, month, dayOfWeek, day, hour, minute, second, milliseconds; }; // SYSTEMTIME
+
+struct ChunkHeader
+{
+public:
+    int type;
+    int size;
+};
+
+struct AssetChunk // BinaryAsset::Chunk
+{
+public:
+    int        numTextures;
+    int        numBSPs;
+    int        numClumps;
+    SystemTime creationTime;
+};
+
+struct TextureChunk // Texture::Chunk
+{
+public:
+    auid  id;
+    char  name[maxNameLength];
+    int   addressTypeU;
+    int   addressTypeV;
+    dword borderColor;
+    int   magFilter;
+    int   minFilter;
+    int   mipFilter;
+    dword maxAnisotropy;
+    float lodBias;
+};
+
+struct ShaderChunk // Shader::Chunk
+{
+public:
+    auid     id;
+    char     name[maxNameLength];
+    int      numLayers;
+    auid     layerTexture[maxTextureLayers];
+    int      layerBlending[maxTextureLayers];
+    int      layerUV[maxTextureLayers];
+    dword    layerConstant[maxTextureLayers];
+    Material materialColor;
+    auid     normalMap;
+    int      normalMapUV;
+    auid     environmentMap;
+    unsigned int flags;
+    unsigned int lightset;
+    int      srcBlend;
+    int      dstBlend;
+    int      blendOp;
+    int      alphaTestFunction;
+    dword    alphaTestRef;
+    bool     hasEffect;
+};
+
+struct GeometryChunk // Geometry::Chunk
+{
+public:
+    auid id;
+    char name[maxNameLength];
+    int  numVertices;
+    int  numTriangles;
+    int  numUVSets;
+    int  numShaders;
+    int  numPrelights;
+    int  numOcTreeSectors;
+    bool sharedShaders;
+    bool hasEffect;
+    bool hasSkin;
+};
+
+struct PreparedChunk // Geometry::PreparedChunk
+{
+public:
+    int  numVertices;
+    int  numTriangles;
+    int  tangentUVSet;
+    bool optimized;
+};
+
+struct Triangle // Triangle
+{
+public:
+    word  vertexId[3];
+    dword shaderId;
+};
+
+struct FrameChunk // Frame::Chunk
+{
+public:
+    auid  id;
+    char  name[maxNameLength];
+    float matrix[16];
+    auid  parent;
+};
+
+struct AtomicChunk // Atomic::Chunk
+{
+public:
+    auid id;
+    auid geometryId;
+    auid frameId;
+};
+
+struct ClumpChunk // Clump::Chunk
+{
+public:
+    auid id;
+    char name[maxNameLength];
+    int  numFrames;
+    int  numGeometries;
+    int  numAtomics;
+    int  numLights;
+};
+
+}
+
+/**
+ * writes clump to binary asset file, texture files are not written
+ * (engine expects them in "textures/<name>.dds" near the asset file);
+ * throws ConvException
+ */
+
+void writeBinaryAsset(const SceneClump* clump, const char* fileName);
+
+#endif
@@ -0,0 +1,154 @@
+
+#include "headers.h"
+#include "filesys.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <direct.h>
+#else
+    #include <sys/stat.h>
+    #include <sys/types.h>
+    #include <dirent.h>
+#endif
+
+/**
+ * content hashing
+ */
+
+ContentHash hashContent(const void* data, unsigned int size, ContentHash seed)
+{
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>( data );
+    ContentHash result = seed;
+    for( unsigned int i=0; i<size; i++ )
+    {
+        result ^= bytes[i];
+        result *= 0x100000001b3ULL;
+    }
+    return result;
+}
+
+ContentHash hashFile(const std::string& fileName)
+{
+    std::vector<char> contents;
+    if( !readFile( fileName, contents ) ) return 0;
+    return hashContent( contents.size() ? &contents[0] : NULL, contents.size() );
+}
+
+/**
+ * files
+ */
+
+bool readFile(const std::string& fileName, std::vector<char>& contents)
+{
+    FILE* file = fopen( fileName.c_str(), "rb" );
+    if( !file ) return false;
+    fseek( file, 0, SEEK_END );
+    long fileSize = ftell( file );
+    fseek( file, 0, SEEK_SET );
+    if( fileSize < 0 )
+    {
+        fclose( file );
+        return false;
+    }
+    contents.resize( fileSize );
+    bool result = ( fileSize == 0 ) || ( fread( &contents[0], fileSize, 1, file ) == 1 );
+    fclose( file );
+    return result;
+}
+
+bool fileExists(const std::string& fileName)
+{
+    FILE* file = fopen( fileName.c_str(), "rb" );
+    if( !file ) return false;
+    fclose( file );
+    return true;
+}
+
+bool copyFile(const std::string& sourceName, const std::string& destName)
+{
+    std::vector<char> contents;
+    if( !readFile( sourceName, contents ) ) return false;
+    FILE* file = fopen( destName.c_str(), "wb" );
+    if( !file ) return false;
+    bool result = contents.empty() || ( fwrite( &contents[0], contents.size(), 1, file ) == 1 );
+    if( fclose( file ) != 0 ) result = false;
+    return result;
+}
+
+/**
+ * directories
+ */
+
+bool isDirectory(const std::string& path)
+{
+    #ifdef _WIN32
+        DWORD attributes = GetFileAttributesA( path.c_str() );
+        return ( attributes != INVALID_FILE_ATTRIBUTES ) && ( attributes & FILE_ATTRIBUTE_DIRECTORY );
+    #else
+        struct stat status;
+        return ( stat( path.c_str(), &status ) == 0 ) && S_ISDIR( status.st_mode );
+    #endif
+}
+
+bool makeDirectory(const std::string& path)
+{
+    std::string directory = convSlash( path );
+    while( directory.length() && directory[directory.length()-1] == '/' ) directory.erase( directory.length()-1 );
+    if( directory.empty() || isDirectory( directory ) ) return true;
+
+    // parent first
+    std::string::size_type pos = directory.find_last_of( '/' );
+    if( pos != std::string::npos && pos > 0 ) makeDirectory( directory.substr( 0, pos ) );
+
+    #ifdef _WIN32
+        _mkdir( directory.c_str() );
+    #else
+        mkdir( directory.c_str(), 0755 );
+    #endif
+    // directory may be created concurrently by other worker
+    return isDirectory( directory );
+}
+
+void scanDirectory(const std::string& path, const char* extension, std::vector<std::string>& fileNames)
+{
+    std::string directory = convSlash( path );
+    if( directory.length() && directory[directory.length()-1] != '/' ) directory += '/';
+
+    std::vector<std::string> entries;
+    #ifdef _WIN32
+        WIN32_FIND_DATAA findData;
+        HANDLE findHandle = FindFirstFileA( ( directory + "*" ).c_str(), &findData );
+        if( findHandle == INVALID_HANDLE_VALUE ) return;
+        do
+        {
+            entries.push_back( findData.cFileName );
+        }
+        while( FindNextFileA( findHandle, &findData ) );
+        FindClose( findHandle );
+    #else
+        DIR* dir = opendir( directory.c_str() );
+        if( !dir ) return;
+        struct dirent* entry;
+        while( ( entry = readdir( dir ) ) != NULL )
+        {
+            entries.push_back( entry->d_name );
+        }
+        closedir( dir );
+    #endif
+
+    // sorted order keeps job order independent of file system
+    std::sort( entries.begin(), entries.end() );
+    for( unsigned int i=0; i<entries.size(); i++ )
+    {
+        if( entries[i] == "." || entries[i] == ".." ) continue;
+        std::string entryPath = directory + entries[i];
+        if( isDirectory( entryPath ) )
+        {
+            scanDirectory( entryPath, extension, fileNames );
+        }
+        else if( convExtension( entryPath ) == extension )
+        {
+            fileNames.push_back( entryPath );
+        }
+    }
+}
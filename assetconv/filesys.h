@@ -0,0 +1,38 @@
+/**
+ * This source code is a part of D3 game project.
+ * (c) Digital Dimension Development, 2004-2005
+ *
+ * @description asset converter : portable file system routines & content hashing
+ *
+ * @author bad3p
+ */
+
+#ifndef ASSETCONV_FILESYS_INCLUDED
+#define ASSETCONV_FILESYS_INCLUDED
+
+#include "headers.h"
+
+typedef unsigned long long ContentHash;
+
+// FNV-1a hash of given data, can be chained by passing previous result as seed
+ContentHash hashContent(const void* data, unsigned int size, ContentHash seed = 0xcbf29ce484222325ULL);
+
+// reads whole file, returns false if file can't be read
+bool readFile(const std::string& fileName, std::vector<char>& contents);
+
+// hash of file contents, or 0 if file can't be read
+ContentHash hashFile(const std::string& fileName);
+
+bool fileExists(const std::string& fileName);
+
+bool copyFile(const std::string& sourceName, const std::string& destName);
+
+// creates directory & all missing parent directories
+bool makeDirectory(const std::string& path);
+
+// appends paths of files with given extension (lowercase) found in directory and its subdirectories
+void scanDirectory(const std::string& path, const char* extension, std::vector<std::string>& fileNames);
+
+bool isDirectory(const std::string& path);
+
+#endif
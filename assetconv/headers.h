@@ -0,0 +1,109 @@
+/**
+ * This source code is a part of D3 game project.
+ * (c) Digital Dimension Development, 2004-2005
+ *
+ * @description asset converter : common headers
+ *
+ * @author bad3p
+ */
+
+#ifndef ASSETCONV_HEADERS_INCLUDED
+#define ASSETCONV_HEADERS_INCLUDED
+
+/**
+ * converter is a standalone console tool, it doesn't depend on Direct3D,
+ * engine or core modules, so it can be built on build machines without
+ * GPU and DirectX SDK:
+ *
+ *   Windows : assetconv.vcxproj
+ *   Linux   : g++ -O2 -o assetconv *.cpp -lpthread (in assetconv directory)
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdarg>
+#include <cmath>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <set>
+#include <algorithm>
+#include <new>
+
+#ifdef _WIN32
+    #pragma warning(disable:4996)
+    #define strtoull _strtoui64
+#endif
+
+/**
+ * conversion error
+ */
+
+class ConvException
+{
+private:
+    std::string _message;
+public:
+    ConvException(const char* format, ...)
+    {
+        char buffer[1024];
+        va_list args;
+        va_start( args, format );
+        vsnprintf( buffer, sizeof(buffer), format, args );
+        va_end( args );
+        buffer[sizeof(buffer)-1] = 0;
+        _message = buffer;
+    }
+    inline const char* getMessage(void) const { return _message.c_str(); }
+};
+
+/**
+ * path utilities ("/" and "\" are both accepted as separators)
+ */
+
+static inline std::string convSlash(const std::string& path)
+{
+    std::string result = path;
+    for( unsigned int i=0; i<result.length(); i++ )
+    {
+        if( result[i] == '\\' ) result[i] = '/';
+    }
+    return result;
+}
+
+// directory part of path, including trailing separator
+static inline std::string convPath(const std::string& path)
+{
+    std::string result = convSlash( path );
+    std::string::size_type pos = result.find_last_of( '/' );
+    if( pos == std::string::npos ) return "";
+    return result.substr( 0, pos + 1 );
+}
+
+// file name without directory and extension (same rule as engine's exname())
+static inline std::string convName(const std::string& path)
+{
+    std::string result = convSlash( path );
+    std::string::size_type pos = result.find_last_of( '/' );
+    if( pos != std::string::npos ) result = result.substr( pos + 1 );
+    pos = result.find( '.' );
+    if( pos != std::string::npos ) result = result.substr( 0, pos );
+    return result;
+}
+
+// lowercase extension of file name, without dot
+static inline std::string convExtension(const std::string& path)
+{
+    std::string result = convSlash( path );
+    std::string::size_type slash = result.find_last_of( '/' );
+    std::string::size_type pos = result.find_last_of( '.' );
+    if( pos == std::string::npos || ( slash != std::string::npos && pos < slash ) ) return "";
+    result = result.substr( pos + 1 );
+    for( unsigned int i=0; i<result.length(); i++ ) result[i] = char( tolower( result[i] ) );
+    return result;
+}
+
+#endif
@@ -0,0 +1,346 @@
+/**
+ * This source code is a part of D3 game project.
+ * (c) Digital Dimension Development, 2004-2005
+ *
+ * @description asset converter : converts x-files to D3 binary assets in batch
+ *
+ * @author bad3p
+ */
+
+#include "headers.h"
+#include "filesys.h"
+#include "thread.h"
+#include "manifest.h"
+#include "xfile.h"
+#include "scene.h"
+#include "meshprep.h"
+#include "bawriter.h"
+
+/**
+ * options
+ */
+
+struct Options
+{
+public:
+    std::string  outputDir;    // empty : assets are written near sources
+    std::string  textureDir;   // additional texture search path
+    std::string  manifestName;
+    unsigned int numThreads;
+    bool         force;
+    bool         verbose;
+public:
+    Options() : manifestName("assetconv.manifest"), numThreads(0), force(false), verbose(false) {}
+};
+
+static void usage(void)
+{
+    printf(
+        "usage : assetconv [options] <file.x | directory> ...\n"
+        "\n"
+        "converts text x-files (static meshes) to D3 binary assets (.ba),\n"
+        "referenced DDS textures are copied to \"textures\" subdirectory of output,\n"
+        "meshes are optimized for vertex cache and provided with tangents\n"
+        "\n"
+        "options :\n"
+        "  -o <dir>   output directory (default : directory of source file)\n"
+        "  -t <dir>   additional texture search directory\n"
+        "  -j <n>     number of worker threads (default : number of processors)\n"
+        "  -m <file>  build manifest (default : assetconv.manifest)\n"
+        "  -f         force conversion of up-to-date assets\n"
+        "  -v         verbose output\n"
+    );
+}
+
+/**
+ * conversion state shared by workers
+ */
+
+struct Conversion
+{
+public:
+    const Options*                     options;
+    std::vector<std::string>           sources;
+    std::vector<std::string>           outputs;
+    Manifest                           manifest;
+    Mutex                              mutex;          // protects members below & console
+    std::map<std::string,ContentHash>  copiedTextures; // output path -> content hash
+    unsigned int                       numConverted;
+    unsigned int                       numSkipped;
+    unsigned int                       numFailed;
+    unsigned int                       numWarnings;
+    JobQueue*                          queue;
+public:
+    Conversion() : options(NULL), numConverted(0), numSkipped(0), numFailed(0), numWarnings(0), queue(NULL) {}
+};
+
+static void report(Conversion* conversion, FILE* stream, const char* format, ...)
+{
+    char buffer[2048];
+    va_list args;
+    va_start( args, format );
+    vsnprintf( buffer, sizeof(buffer), format, args );
+    va_end( args );
+    buffer[sizeof(buffer)-1] = 0;
+
+    MutexLock lock( &conversion->mutex );
+    fprintf( stream, "%s\n", buffer );
+    fflush( stream );
+}
+
+static std::string fileNameOf(const std::string& path)
+{
+    std::string result = convSlash( path );
+    std::string::size_type pos = result.find_last_of( '/' );
+    return ( pos == std::string::npos ) ? result : result.substr( pos + 1 );
+}
+
+static std::string replaceExtension(const std::string& path, const char* extension)
+{
+    std::string result = convSlash( path );
+    std::string::size_type slash = result.find_last_of( '/' );
+    std::string::size_type dot = result.find_last_of( '.' );
+    if( dot != std::string::npos && ( slash == std::string::npos || dot > slash ) ) result.erase( dot );
+    return result + "." + extension;
+}
+
+// locates DDS file for texture referenced by source asset, all checked
+// locations are reported as candidates
+static bool findTextureSource(const Options* options, const std::string& sourceDir, const SceneTexture* texture, std::string& result, std::vector<std::string>& candidates)
+{
+    candidates.clear();
+    candidates.push_back( texture->sourcePath );
+    candidates.push_back( sourceDir + texture->sourcePath );
+    candidates.push_back( sourceDir + fileNameOf( texture->sourcePath ) );
+    candidates.push_back( sourceDir + "textures/" + fileNameOf( texture->sourcePath ) );
+    if( options->textureDir.length() )
+    {
+        candidates.push_back( convSlash( options->textureDir ) + "/" + fileNameOf( texture->sourcePath ) );
+    }
+    for( unsigned int i=0; i<candidates.size(); i++ )
+    {
+        candidates[i] = replaceExtension( candidates[i], "dds" );
+        if( fileExists( candidates[i] ) )
+        {
+            result = candidates[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+static void convertAsset(Conversion* conversion, unsigned int jobId)
+{
+    const Options*     options = conversion->options;
+    const std::string& source  = conversion->sources[jobId];
+    const std::string& output  = conversion->outputs[jobId];
+
+    std::vector<char> contents;
+    if( !readFile( source, contents ) ) throw ConvException( "can't read file" );
+    ContentHash hash = hashContent( contents.size() ? &contents[0] : NULL, contents.size() );
+
+    if( !options->force && conversion->manifest.isUpToDate( source, hash, output ) )
+    {
+        MutexLock lock( &conversion->mutex );
+        conversion->numSkipped++;
+        if( options->verbose ) printf( "%s : up to date\n", source.c_str() );
+        return;
+    }
+
+    // parse & build scene
+    XFile xFile( contents.size() ? &contents[0] : "", contents.size() );
+    SceneClump clump;
+    buildClump( &xFile, &clump );
+
+    // vertex cache order & tangents, so engine doesn't run D3DX on them at load time
+    for( unsigned int i=0; i<clump.geometries.size(); i++ ) prepareGeometry( &clump.geometries[i] );
+
+    Manifest::Entry entry;
+    entry.hash   = hash;
+    entry.output = output;
+
+    // copy textures to the place where engine looks for them
+    std::string outputDir  = convPath( output );
+    std::string textureDir = outputDir + "textures/";
+    if( clump.textures.size() && !makeDirectory( textureDir ) )
+    {
+        throw ConvException( "can't create directory \"%s\"", textureDir.c_str() );
+    }
+    for( unsigned int i=0; i<clump.textures.size(); i++ )
+    {
+        const SceneTexture* texture = &clump.textures[i];
+        std::string textureSource;
+        std::vector<std::string> candidates;
+        if( !findTextureSource( options, convPath( source ), texture, textureSource, candidates ) )
+        {
+            // asset is rebuilt as soon as texture appears in one of checked locations
+            for( unsigned int j=0; j<candidates.size(); j++ )
+            {
+                entry.dependencies.push_back( Manifest::Dependency( candidates[j], 0 ) );
+            }
+            report( conversion, stderr, "%s : warning : DDS file for texture \"%s\" not found", source.c_str(), texture->sourcePath.c_str() );
+            MutexLock lock( &conversion->mutex );
+            conversion->numWarnings++;
+            continue;
+        }
+
+        ContentHash textureHash = hashFile( textureSource );
+        std::string textureOutput = textureDir + texture->name + ".dds";
+        entry.dependencies.push_back( Manifest::Dependency( textureSource, textureHash ) );
+        entry.dependencies.push_back( Manifest::Dependency( textureOutput, textureHash ) );
+
+        // texture may be shared by assets processed by other workers
+        bool copy = false;
+        {
+            MutexLock lock( &conversion->mutex );
+            std::map<std::string,ContentHash>::iterator copiedI = conversion->copiedTextures.find( textureOutput );
+            if( copiedI == conversion->copiedTextures.end() )
+            {
+                conversion->copiedTextures.insert( std::pair<std::string,ContentHash>( textureOutput, textureHash ) );
+                copy = true;
+            }
+            else if( copiedI->second != textureHash )
+            {
+                fprintf( stderr, "%s : warning : texture \"%s\" differs from texture of the same name used by other asset\n", source.c_str(), textureSource.c_str() );
+                conversion->numWarnings++;
+            }
+        }
+        if( copy && hashFile( textureOutput ) != textureHash && !copyFile( textureSource, textureOutput ) )
+        {
+            throw ConvException( "can't copy texture \"%s\" to \"%s\"", textureSource.c_str(), textureOutput.c_str() );
+        }
+    }
+
+    // write asset
+    if( outputDir.length() && !makeDirectory( outputDir ) )
+    {
+        throw ConvException( "can't create directory \"%s\"", outputDir.c_str() );
+    }
+    writeBinaryAsset( &clump, output.c_str() );
+    conversion->manifest.update( source, entry );
+
+    unsigned int numTriangles = 0;
+    for( unsigned int i=0; i<clump.geometries.size(); i++ ) numTriangles += clump.geometries[i].triangles.size();
+
+    MutexLock lock( &conversion->mutex );
+    conversion->numConverted++;
+    printf(
+        "%s -> %s (%d frames, %d geometries, %d triangles, %d textures)\n",
+        source.c_str(), output.c_str(),
+        int( clump.frames.size() ), int( clump.geometries.size() ), numTriangles, int( clump.textures.size() )
+    );
+    fflush( stdout );
+}
+
+static void conversionWorker(unsigned int, void* data)
+{
+    Conversion* conversion = reinterpret_cast<Conversion*>( data );
+    unsigned int jobId;
+    while( conversion->queue->pop( &jobId ) )
+    {
+        try
+        {
+            convertAsset( conversion, jobId );
+        }
+        catch( ConvException& exception )
+        {
+            conversion->manifest.invalidate( conversion->sources[jobId] );
+            report( conversion, stderr, "%s : error : %s", conversion->sources[jobId].c_str(), exception.getMessage() );
+            MutexLock lock( &conversion->mutex );
+            conversion->numFailed++;
+        }
+        catch( std::bad_alloc& )
+        {
+            conversion->manifest.invalidate( conversion->sources[jobId] );
+            report( conversion, stderr, "%s : error : out of memory", conversion->sources[jobId].c_str() );
+            MutexLock lock( &conversion->mutex );
+            conversion->numFailed++;
+        }
+    }
+}
+
+/**
+ * entry point
+ */
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    std::vector<std::string> inputs;
+    for( int i=1; i<argc; i++ )
+    {
+        std::string arg = argv[i];
+        bool hasValue = ( i+1 < argc );
+        if( arg == "-o" && hasValue ) options.outputDir = convSlash( argv[++i] );
+        else if( arg == "-t" && hasValue ) options.textureDir = argv[++i];
+        else if( arg == "-m" && hasValue ) options.manifestName = argv[++i];
+        else if( arg == "-j" && hasValue ) options.numThreads = atoi( argv[++i] );
+        else if( arg == "-f" ) options.force = true;
+        else if( arg == "-v" ) options.verbose = true;
+        else if( arg.length() && arg[0] == '-' )
+        {
+            usage();
+            return 2;
+        }
+        else inputs.push_back( arg );
+    }
+    if( inputs.empty() )
+    {
+        usage();
+        return 2;
+    }
+
+    // collect sources
+    Conversion conversion;
+    conversion.options = &options;
+    unsigned int i;
+    for( i=0; i<inputs.size(); i++ )
+    {
+        if( isDirectory( inputs[i] ) ) scanDirectory( inputs[i], "x", conversion.sources );
+        else conversion.sources.push_back( convSlash( inputs[i] ) );
+    }
+
+    // assign outputs, several sources can't share the same output
+    std::map<std::string,std::string> outputSources;
+    std::vector<std::string> sources;
+    for( i=0; i<conversion.sources.size(); i++ )
+    {
+        const std::string& source = conversion.sources[i];
+        std::string outputDir = options.outputDir.length() ? options.outputDir + "/" : convPath( source );
+        std::string output = outputDir + convName( source ) + ".ba";
+        std::map<std::string,std::string>::iterator outputI = outputSources.find( output );
+        if( outputI != outputSources.end() )
+        {
+            if( outputI->second != source )
+            {
+                fprintf( stderr, "%s : error : output \"%s\" is already produced from \"%s\"\n", source.c_str(), output.c_str(), outputI->second.c_str() );
+                conversion.numFailed++;
+            }
+            continue;
+        }
+        outputSources.insert( std::pair<std::string,std::string>( output, source ) );
+        sources.push_back( source );
+        conversion.outputs.push_back( output );
+    }
+    conversion.sources = sources;
+
+    // convert
+    conversion.manifest.load( options.manifestName.c_str() );
+    unsigned int numThreads = options.numThreads ? options.numThreads : getNumProcessors();
+    numThreads = std::max( 1u, std::min( numThreads, (unsigned int)( conversion.sources.size() ) ) );
+    JobQueue queue( conversion.sources.size() );
+    conversion.queue = &queue;
+    runWorkers( numThreads, conversionWorker, &conversion );
+
+    if( !conversion.manifest.save( options.manifestName.c_str() ) )
+    {
+        fprintf( stderr, "error : can't write manifest \"%s\"\n", options.manifestName.c_str() );
+        conversion.numFailed++;
+    }
+
+    printf(
+        "%d converted, %d up to date, %d failed, %d warnings (%d threads)\n",
+        conversion.numConverted, conversion.numSkipped, conversion.numFailed, conversion.numWarnings, numThreads
+    );
+    return conversion.numFailed ? 1 : 0;
+}
@@ -0,0 +1,149 @@
+
+#include "headers.h"
+#include "manifest.h"
+
+/**
+ * module locals
+ */
+
+// version is increased whenever converter output changes, so older outputs get rebuilt
+static const char* manifestHeader = "# assetconv manifest 2";
+
+// splits "<keyword> [<hash>] <path>" line
+static bool parseLine(const char* line, bool hasHash, std::string& keyword, ContentHash& hash, std::string& path)
+{
+    const char* separator = strchr( line, ' ' );
+    if( !separator ) return false;
+    keyword.assign( line, separator - line );
+    line = separator + 1;
+    hash = 0;
+    if( hasHash )
+    {
+        char* end = NULL;
+        hash = strtoull( line, &end, 16 );
+        if( end == line || *end != ' ' ) return false;
+        line = end + 1;
+    }
+    path = line;
+    return path.length() > 0;
+}
+
+/**
+ * class implementation
+ */
+
+void Manifest::load(const char* fileName)
+{
+    MutexLock lock( &_mutex );
+    _entries.clear();
+
+    FILE* file = fopen( fileName, "rt" );
+    if( !file ) return;
+
+    char buffer[4096];
+    if( !fgets( buffer, sizeof(buffer), file ) || strncmp( buffer, manifestHeader, strlen( manifestHeader ) ) != 0 )
+    {
+        // unknown manifest version : rebuild everything
+        fclose( file );
+        return;
+    }
+
+    Entry*      entry = NULL;
+    std::string keyword, path;
+    ContentHash hash;
+    while( fgets( buffer, sizeof(buffer), file ) )
+    {
+        // strip line end
+        unsigned int length = strlen( buffer );
+        while( length && ( buffer[length-1] == '\n' || buffer[length-1] == '\r' ) ) buffer[--length] = 0;
+        if( !length ) continue;
+
+        if( strncmp( buffer, "asset ", 6 ) == 0 && parseLine( buffer, true, keyword, hash, path ) )
+        {
+            entry = &_entries[path];
+            entry->hash = hash;
+            entry->output = "";
+            entry->dependencies.clear();
+        }
+        else if( entry && strncmp( buffer, "output ", 7 ) == 0 && parseLine( buffer, false, keyword, hash, path ) )
+        {
+            entry->output = path;
+        }
+        else if( entry && strncmp( buffer, "depends ", 8 ) == 0 && parseLine( buffer, true, keyword, hash, path ) )
+        {
+            entry->dependencies.push_back( Dependency( path, hash ) );
+        }
+    }
+    fclose( file );
+}
+
+bool Manifest::save(const char* fileName)
+{
+    MutexLock lock( &_mutex );
+
+    std::string tempName = fileName;
+    tempName += ".tmp";
+    FILE* file = fopen( tempName.c_str(), "wt" );
+    if( !file ) return false;
+
+    fprintf( file, "%s\n", manifestHeader );
+    for( EntryI entryI = _entries.begin(); entryI != _entries.end(); entryI++ )
+    {
+        fprintf( file, "asset %016llx %s\n", entryI->second.hash, entryI->first.c_str() );
+        fprintf( file, "output %s\n", entryI->second.output.c_str() );
+        for( unsigned int i=0; i<entryI->second.dependencies.size(); i++ )
+        {
+            const Dependency& dependency = entryI->second.dependencies[i];
+            fprintf( file, "depends %016llx %s\n", dependency.second, dependency.first.c_str() );
+        }
+    }
+
+    if( fclose( file ) != 0 ) return false;
+    remove( fileName );
+    return rename( tempName.c_str(), fileName ) == 0;
+}
+
+bool Manifest::isUpToDate(const std::string& source, ContentHash hash, const std::string& output)
+{
+    Entry entry;
+    {
+        MutexLock lock( &_mutex );
+        EntryI entryI = _entries.find( source );
+        if( entryI == _entries.end() ) return false;
+        entry = entryI->second;
+    }
+    if( entry.hash != hash || entry.output != output || !fileExists( output ) ) return false;
+
+    // dependencies are hashed outside of lock
+    for( unsigned int i=0; i<entry.dependencies.size(); i++ )
+    {
+        if( hashFile( entry.dependencies[i].first ) != entry.dependencies[i].second ) return false;
+    }
+    return true;
+}
+
+void Manifest::update(const std::string& source, const Entry& entry)
+{
+    // the same file may be referenced by several textures of asset (e.g. missing
+    // texture checked in the same locations), it is stored once
+    Entry uniqueEntry;
+    uniqueEntry.hash   = entry.hash;
+    uniqueEntry.output = entry.output;
+    std::set<std::string> paths;
+    for( unsigned int i=0; i<entry.dependencies.size(); i++ )
+    {
+        if( paths.insert( entry.dependencies[i].first ).second )
+        {
+            uniqueEntry.dependencies.push_back( entry.dependencies[i] );
+        }
+    }
+
+    MutexLock lock( &_mutex );
+    _entries[source] = uniqueEntry;
+}
+
+void Manifest::invalidate(const std::string& source)
+{
+    MutexLock lock( &_mutex );
+    _entries.erase( source );
+}
@@ -0,0 +1,59 @@
+/**
+ * This source code is a part of D3 game project.
+ * (c) Digital Dimension Development, 2004-2005
+ *
+ * @description asset converter : build manifest for incremental conversion
+ *
+ * @author bad3p
+ */
+
+#ifndef ASSETCONV_MANIFEST_INCLUDED
+#define ASSETCONV_MANIFEST_INCLUDED
+
+#include "headers.h"
+#include "filesys.h"
+#include "thread.h"
+
+/**
+ * manifest remembers content hashes of source assets and of all files
+ * they depend on (textures), asset is rebuilt only if some of hashes
+ * changed, or output is missing; manifest is a text file:
+ *
+ *   asset <hash> <source path>
+ *   output <output path>
+ *   depends <hash> <dependency path>
+ *   ...
+ */
+
+class Manifest
+{
+public:
+    typedef std::pair<std::string,ContentHash> Dependency;
+    typedef std::vector<Dependency> DependencyV;
+    struct Entry
+    {
+    public:
+        ContentHash  hash;
+        std::string  output;
+        DependencyV  dependencies;
+    };
+private:
+    typedef std::map<std::string,Entry> EntryM;
+    typedef EntryM::iterator EntryI;
+private:
+    Mutex  _mutex;
+    EntryM _entries;
+public:
+    // reads manifest, missing file gives empty manifest
+    void load(const char* fileName);
+    bool save(const char* fileName);
+public:
+    // checks whether output of given source is up to date
+    bool isUpToDate(const std::string& source, ContentHash hash, const std::string& output);
+    // stores results of successful conversion
+    void update(const std::string& source, const Entry& entry);
+    // forgets source, so it is rebuilt next time
+    void invalidate(const std::string& source);
+};
+
+#endif
@@ -0,0 +1,346 @@
+
+#include "headers.h"
+#include "meshprep.h"
+
+/**
+ * module locals : vertex cache optimization
+ *
+ * greedy triangle ordering by T.Forsyth "Linear-Speed Vertex Cache Optimisation":
+ * every vertex is scored by its position in simulated LRU cache and by number
+ * of triangles still using it, the next triangle emitted is the one with
+ * highest sum of vertex scores
+ */
+
+static const int   cacheSize         = 32;
+static const float cacheDecayPower   = 1.5f;
+static const float lastTriangleScore = 0.75f;
+static const float valenceBoostScale = 2.0f;
+static const float valenceBoostPower = 0.5f;
+
+static float vertexScore(int cachePosition, int numActiveTriangles)
+{
+    // vertex isn't used by remaining triangles
+    if( numActiveTriangles == 0 ) return -1.0f;
+
+    float score = 0.0f;
+    if( cachePosition >= 0 )
+    {
+        if( cachePosition < 3 )
+        {
+            // vertices of the last triangle get fixed score, so the strips
+            // don't go the same direction all the time
+            score = lastTriangleScore;
+        }
+        else
+        {
+            float scaler = 1.0f / float( cacheSize - 3 );
+            score = 1.0f - float( cachePosition - 3 ) * scaler;
+            score = powf( score, cacheDecayPower );
+        }
+    }
+    // boost vertices with few remaining triangles, to get rid of lone triangles
+    score += valenceBoostScale * powf( float( numActiveTriangles ), -valenceBoostPower );
+    return score;
+}
+
+struct CacheVertex
+{
+public:
+    int               cachePosition;
+    int               numActiveTriangles;
+    float             score;
+    std::vector<int>  triangles; // local indices of triangles using vertex
+};
+
+// reorders triangles [first,last) of geometry for vertex cache
+static void optimizeRange(SceneGeometry* geometry, unsigned int first, unsigned int last, std::vector<CacheVertex>& vertices)
+{
+    unsigned int numTriangles = last - first;
+    if( numTriangles < 2 ) return;
+
+    unsigned int i, j;
+    const SceneTriangle* triangles = &geometry->triangles[first];
+
+    // reset vertices used by range
+    for( i=0; i<numTriangles; i++ ) for( j=0; j<3; j++ )
+    {
+        CacheVertex* vertex = &vertices[triangles[i].vertexId[j]];
+        vertex->cachePosition      = -1;
+        vertex->numActiveTriangles = 0;
+        vertex->triangles.clear();
+    }
+    for( i=0; i<numTriangles; i++ ) for( j=0; j<3; j++ )
+    {
+        CacheVertex* vertex = &vertices[triangles[i].vertexId[j]];
+        vertex->numActiveTriangles++;
+        vertex->triangles.push_back( int( i ) );
+    }
+    for( i=0; i<numTriangles; i++ ) for( j=0; j<3; j++ )
+    {
+        CacheVertex* vertex = &vertices[triangles[i].vertexId[j]];
+        vertex->score = vertexScore( vertex->cachePosition, vertex->numActiveTriangles );
+    }
+
+    std::vector<float> triangleScores( numTriangles );
+    std::vector<bool>  triangleAdded( numTriangles, false );
+    for( i=0; i<numTriangles; i++ )
+    {
+        triangleScores[i] = vertices[triangles[i].vertexId[0]].score +
+                            vertices[triangles[i].vertexId[1]].score +
+                            vertices[triangles[i].vertexId[2]].score;
+    }
+
+    std::vector<SceneTriangle> result;
+    result.reserve( numTriangles );
+    std::vector<unsigned int> cache, newCache;
+    cache.reserve( cacheSize + 3 );
+    newCache.reserve( cacheSize + 3 );
+    unsigned int scanPosition = 0;
+    int          bestTriangle = -1;
+
+    while( result.size() < numTriangles )
+    {
+        // no candidate among triangles of cached vertices : take the best of the rest
+        if( bestTriangle < 0 )
+        {
+            float bestScore = -1.0f;
+            while( scanPosition < numTriangles && triangleAdded[scanPosition] ) scanPosition++;
+            for( i=scanPosition; i<numTriangles; i++ )
+            {
+                if( !triangleAdded[i] && triangleScores[i] > bestScore )
+                {
+                    bestScore    = triangleScores[i];
+                    bestTriangle = int( i );
+                }
+            }
+            assert( bestTriangle >= 0 );
+        }
+
+        // emit triangle
+        const SceneTriangle* triangle = &triangles[bestTriangle];
+        triangleAdded[bestTriangle] = true;
+        result.push_back( *triangle );
+        for( j=0; j<3; j++ )
+        {
+            CacheVertex* vertex = &vertices[triangle->vertexId[j]];
+            vertex->numActiveTriangles--;
+            std::vector<int>::iterator triangleI = std::find( vertex->triangles.begin(), vertex->triangles.end(), bestTriangle );
+            assert( triangleI != vertex->triangles.end() );
+            vertex->triangles.erase( triangleI );
+        }
+
+        // update simulated cache : vertices of emitted triangle go first
+        newCache.clear();
+        for( j=0; j<3; j++ ) newCache.push_back( triangle->vertexId[j] );
+        for( i=0; i<cache.size(); i++ )
+        {
+            if( cache[i] != triangle->vertexId[0] &&
+                cache[i] != triangle->vertexId[1] &&
+                cache[i] != triangle->vertexId[2] )
+            {
+                newCache.push_back( cache[i] );
+            }
+        }
+        cache.swap( newCache );
+
+        // rescore cached vertices, and triangles using them
+        for( i=0; i<cache.size(); i++ )
+        {
+            CacheVertex* vertex = &vertices[cache[i]];
+            vertex->cachePosition = ( i < (unsigned int)( cacheSize ) ) ? int( i ) : -1;
+            vertex->score = vertexScore( vertex->cachePosition, vertex->numActiveTriangles );
+        }
+        bestTriangle = -1;
+        float bestScore = -1.0f;
+        for( i=0; i<cache.size(); i++ )
+        {
+            CacheVertex* vertex = &vertices[cache[i]];
+            for( j=0; j<vertex->triangles.size(); j++ )
+            {
+                int triangleId = vertex->triangles[j];
+                triangleScores[triangleId] = vertices[triangles[triangleId].vertexId[0]].score +
+                                             vertices[triangles[triangleId].vertexId[1]].score +
+                                             vertices[triangles[triangleId].vertexId[2]].score;
+                if( triangleScores[triangleId] > bestScore )
+                {
+                    bestScore    = triangleScores[triangleId];
+                    bestTriangle = triangleId;
+                }
+            }
+        }
+        if( cache.size() > (unsigned int)( cacheSize ) ) cache.resize( cacheSize );
+    }
+
+    std::copy( result.begin(), result.end(), geometry->triangles.begin() + first );
+}
+
+static bool triangleShaderLess(const SceneTriangle& t1, const SceneTriangle& t2)
+{
+    return t1.shaderId < t2.shaderId;
+}
+
+// rearranges per-vertex array of given element size by vertex map
+template<class T> void remapVertices(std::vector<T>& data, unsigned int elementSize, const std::vector<int>& vertexMap, unsigned int numNewVertices)
+{
+    if( data.empty() ) return;
+    std::vector<T> result( numNewVertices * elementSize );
+    for( unsigned int i=0; i<vertexMap.size(); i++ )
+    {
+        if( vertexMap[i] < 0 ) continue;
+        for( unsigned int j=0; j<elementSize; j++ ) result[vertexMap[i]*elementSize+j] = data[i*elementSize+j];
+    }
+    data.swap( result );
+}
+
+/**
+ * module locals : tangent space
+ */
+
+static inline float dot(const float* v1, const float* v2)
+{
+    return v1[0]*v2[0] + v1[1]*v2[1] + v1[2]*v2[2];
+}
+
+static inline void cross(float* result, const float* v1, const float* v2)
+{
+    result[0] = v1[1]*v2[2] - v1[2]*v2[1];
+    result[1] = v1[2]*v2[0] - v1[0]*v2[2];
+    result[2] = v1[0]*v2[1] - v1[1]*v2[0];
+}
+
+static inline bool normalize(float* v)
+{
+    float length = sqrtf( dot( v, v ) );
+    if( length < 1e-12f ) return false;
+    v[0] /= length, v[1] /= length, v[2] /= length;
+    return true;
+}
+
+/**
+ * mesh preparation
+ */
+
+void optimizeGeometry(SceneGeometry* geometry)
+{
+    unsigned int numVertices  = geometry->getNumVertices();
+    unsigned int numTriangles = geometry->triangles.size();
+    unsigned int i, j;
+
+    // attribute sort, stable to keep source order of equal shaders
+    std::stable_sort( geometry->triangles.begin(), geometry->triangles.end(), triangleShaderLess );
+
+    // vertex cache, for each shader separately
+    std::vector<CacheVertex> cacheVertices( numVertices );
+    unsigned int first = 0;
+    while( first < numTriangles )
+    {
+        unsigned int last = first + 1;
+        while( last < numTriangles && geometry->triangles[last].shaderId == geometry->triangles[first].shaderId ) last++;
+        optimizeRange( geometry, first, last, cacheVertices );
+        first = last;
+    }
+
+    // vertices are numbered by first use, unused vertices are dropped
+    std::vector<int> vertexMap( numVertices, -1 );
+    unsigned int numNewVertices = 0;
+    for( i=0; i<numTriangles; i++ ) for( j=0; j<3; j++ )
+    {
+        unsigned int& vertexId = geometry->triangles[i].vertexId[j];
+        if( vertexMap[vertexId] < 0 ) vertexMap[vertexId] = int( numNewVertices++ );
+        vertexId = (unsigned int)( vertexMap[vertexId] );
+    }
+    remapVertices( geometry->vertices, 3, vertexMap, numNewVertices );
+    remapVertices( geometry->normals, 3, vertexMap, numNewVertices );
+    remapVertices( geometry->uvs, 2, vertexMap, numNewVertices );
+    remapVertices( geometry->prelights, 1, vertexMap, numNewVertices );
+    remapVertices( geometry->tangents, 3, vertexMap, numNewVertices );
+    remapVertices( geometry->binormals, 3, vertexMap, numNewVertices );
+
+    geometry->optimized = true;
+}
+
+void calculateTangents(SceneGeometry* geometry)
+{
+    if( geometry->uvs.empty() ) throw ConvException( "can't calculate tangents of \"%s\" : no UV-set", geometry->name.c_str() );
+
+    unsigned int numVertices = geometry->getNumVertices();
+    unsigned int i, j;
+
+    // accumulate UV-gradients of adjacent triangles
+    std::vector<float> uDirections( numVertices * 3, 0.0f );
+    std::vector<float> vDirections( numVertices * 3, 0.0f );
+    for( i=0; i<geometry->triangles.size(); i++ )
+    {
+        const unsigned int* ids = geometry->triangles[i].vertexId;
+        const float* p0 = &geometry->vertices[ids[0]*3];
+        const float* p1 = &geometry->vertices[ids[1]*3];
+        const float* p2 = &geometry->vertices[ids[2]*3];
+        const float* t0 = &geometry->uvs[ids[0]*2];
+        const float* t1 = &geometry->uvs[ids[1]*2];
+        const float* t2 = &geometry->uvs[ids[2]*2];
+
+        float e1[3] = { p1[0]-p0[0], p1[1]-p0[1], p1[2]-p0[2] };
+        float e2[3] = { p2[0]-p0[0], p2[1]-p0[1], p2[2]-p0[2] };
+        float du1 = t1[0]-t0[0], dv1 = t1[1]-t0[1];
+        float du2 = t2[0]-t0[0], dv2 = t2[1]-t0[1];
+
+        // triangle with degenerated mapping doesn't contribute
+        float determinant = du1 * dv2 - du2 * dv1;
+        if( fabs( determinant ) < 1e-12f ) continue;
+        float r = 1.0f / determinant;
+
+        float uDirection[3], vDirection[3];
+        for( j=0; j<3; j++ )
+        {
+            uDirection[j] = ( e1[j] * dv2 - e2[j] * dv1 ) * r;
+            vDirection[j] = ( e2[j] * du1 - e1[j] * du2 ) * r;
+        }
+        for( j=0; j<3; j++ )
+        {
+            float* u = &uDirections[ids[j]*3];
+            float* v = &vDirections[ids[j]*3];
+            u[0] += uDirection[0], u[1] += uDirection[1], u[2] += uDirection[2];
+            v[0] += vDirection[0], v[1] += vDirection[1], v[2] += vDirection[2];
+        }
+    }
+
+    // orthonormalize against vertex normal
+    geometry->tangents.resize( numVertices * 3 );
+    geometry->binormals.resize( numVertices * 3 );
+    for( i=0; i<numVertices; i++ )
+    {
+        float normal[3] = { geometry->normals[i*3+0], geometry->normals[i*3+1], geometry->normals[i*3+2] };
+        if( !normalize( normal ) ) normal[0] = 0, normal[1] = 1, normal[2] = 0;
+
+        float* tangent  = &geometry->tangents[i*3];
+        float* binormal = &geometry->binormals[i*3];
+        const float* u  = &uDirections[i*3];
+        const float* v  = &vDirections[i*3];
+
+        float projection = dot( normal, u );
+        tangent[0] = u[0] - normal[0] * projection;
+        tangent[1] = u[1] - normal[1] * projection;
+        tangent[2] = u[2] - normal[2] * projection;
+        if( !normalize( tangent ) )
+        {
+            // unmapped vertex : any direction perpendicular to normal
+            float axis[3] = { 1, 0, 0 };
+            if( fabs( normal[0] ) > 0.9f ) axis[0] = 0, axis[1] = 1;
+            cross( tangent, axis, normal );
+            normalize( tangent );
+        }
+
+        // binormal keeps handedness of V-gradient (mirrored mapping)
+        cross( binormal, normal, tangent );
+        if( dot( binormal, v ) < 0.0f )
+        {
+            binormal[0] = -binormal[0], binormal[1] = -binormal[1], binormal[2] = -binormal[2];
+        }
+    }
+}
+
+void prepareGeometry(SceneGeometry* geometry)
+{
+    optimizeGeometry( geometry );
+    if( geometry->uvs.size() && geometry->prelights.empty() ) calculateTangents( geometry );
+}
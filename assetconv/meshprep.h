@@ -0,0 +1,36 @@
+/**
+ * This source code is a part of D3 game project.
+ * (c) Digital Dimension Development, 2004-2005
+ *
+ * @description asset converter : offline mesh preparation
+ *
+ * @author bad3p
+ */
+
+#ifndef ASSETCONV_MESHPREP_INCLUDED
+#define ASSETCONV_MESHPREP_INCLUDED
+
+#include "headers.h"
+#include "scene.h"
+
+/**
+ * mesh preparation replaces the work engine does with D3DX for each
+ * geometry at load time (see Geometry::instance() & Mesh class):
+ *
+ *  - optimizeGeometry() sorts triangles by shader, reorders triangles of each
+ *    shader for post-transform vertex cache, and compacts & reorders vertices
+ *    by first use (D3DXMESHOPT_ATTRSORT | VERTEXCACHE | COMPACT);
+ *  - calculateTangents() computes per-vertex tangents & binormals for
+ *    UV-set 0 (D3DXComputeTangent);
+ *
+ * both functions are device independent and don't depend on D3DX
+ */
+
+void optimizeGeometry(SceneGeometry* geometry);
+void calculateTangents(SceneGeometry* geometry);
+
+// applies both steps, tangents are calculated only for geometries
+// engine renders with tangent vertex declaration (UV-set & no prelights)
+void prepareGeometry(SceneGeometry* geometry);
+
+#endif
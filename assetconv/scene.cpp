@@ -0,0 +1,392 @@
+
+#include "headers.h"
+#include "scene.h"
+
+/**
+ * module locals
+ */
+
+static const float identityMatrix[16] =
+{
+    1,0,0,0,
+    0,1,0,0,
+    0,0,1,0,
+    0,0,0,1
+};
+
+static const unsigned int maxGeometryVertices = 0xFFFF; // geometry triangles use WORD indices
+
+struct BuildContext
+{
+public:
+    const XFile*                         xFile;
+    SceneClump*                          clump;
+    std::map<const XObject*,unsigned int> geometries; // mesh object -> geometry index
+};
+
+// resolves reference to named object
+static const XObject* resolve(BuildContext* context, const XObject* object)
+{
+    if( !object->isReference() ) return object;
+    const XObject* result = context->xFile->findNamed( object->name );
+    if( !result ) throw ConvException( "unresolved reference to \"%s\"", object->name.c_str() );
+    return result;
+}
+
+static unsigned int findTexture(SceneClump* clump, const std::string& path)
+{
+    // textures are shared by name, like they are shared in Texture::textures
+    std::string textureName = convName( path );
+    for( unsigned int i=0; i<clump->textures.size(); i++ )
+    {
+        if( clump->textures[i].name == textureName ) return i;
+    }
+    SceneTexture texture;
+    texture.name       = textureName;
+    texture.sourcePath = convSlash( path );
+    clump->textures.push_back( texture );
+    return clump->textures.size() - 1;
+}
+
+static void buildShader(BuildContext* context, const XObject* material, SceneGeometry* geometry, unsigned int shaderId)
+{
+    char shaderName[1024];
+    sprintf( shaderName, "%.960s_shader_%d", geometry->name.c_str(), shaderId );
+
+    // defaults are the same as Shader constructor uses
+    SceneShader shader;
+    shader.name      = shaderName;
+    shader.textureId = -1;
+    shader.diffuse[0] = shader.diffuse[1] = shader.diffuse[2] = shader.diffuse[3] = 1.0f;
+    shader.specular[0] = shader.specular[1] = shader.specular[2] = 0.0f, shader.specular[3] = 1.0f;
+    shader.power     = 0.0f;
+
+    if( material )
+    {
+        // Material { faceColor; power; specularColor; emissiveColor; [TextureFilename] }
+        XReader reader( material );
+        shader.diffuse[0]  = reader.getFloat();
+        shader.diffuse[1]  = reader.getFloat();
+        shader.diffuse[2]  = reader.getFloat();
+        shader.diffuse[3]  = reader.getFloat();
+        shader.power       = reader.getFloat();
+        shader.specular[0] = reader.getFloat();
+        shader.specular[1] = reader.getFloat();
+        shader.specular[2] = reader.getFloat();
+        shader.specular[3] = 1.0f;
+
+        const XObject* textureFilename = material->findChild( "TextureFilename" );
+        if( textureFilename && textureFilename->strings.size() && textureFilename->strings[0].length() )
+        {
+            shader.textureId = int( findTexture( context->clump, textureFilename->strings[0] ) );
+        }
+    }
+
+    geometry->shaders.push_back( shader );
+}
+
+// reads face indices of "Mesh" or "MeshNormals" data, starting from current reader position
+static void readFaces(XReader& reader, std::vector< std::vector<unsigned int> >& faces, unsigned int numIndices)
+{
+    unsigned int numFaces = reader.getCount();
+    faces.resize( numFaces );
+    for( unsigned int i=0; i<numFaces; i++ )
+    {
+        unsigned int numFaceVertices = reader.getCount();
+        if( numFaceVertices < 3 ) throw ConvException( "degenerate face (%d vertices)", numFaceVertices );
+        faces[i].resize( numFaceVertices );
+        for( unsigned int j=0; j<numFaceVertices; j++ )
+        {
+            faces[i][j] = reader.getCount();
+            if( faces[i][j] >= numIndices ) throw ConvException( "face index %d is out of range", faces[i][j] );
+        }
+    }
+}
+
+static inline unsigned int packColor(float r, float g, float b, float a)
+{
+    #define CHANNEL(X) ( (unsigned int)( std::min( std::max( X, 0.0f ), 1.0f ) * 255.0f + 0.5f ) )
+    return ( CHANNEL(a) << 24 ) | ( CHANNEL(r) << 16 ) | ( CHANNEL(g) << 8 ) | CHANNEL(b);
+    #undef CHANNEL
+}
+
+static unsigned int buildGeometry(BuildContext* context, const XObject* mesh)
+{
+    std::map<const XObject*,unsigned int>::iterator geometryI = context->geometries.find( mesh );
+    if( geometryI != context->geometries.end() ) return geometryI->second;
+
+    if( mesh->findChild( "XSkinMeshHeader" ) || mesh->findChild( "SkinWeights" ) )
+    {
+        throw ConvException( "mesh \"%s\" is skinned, skinned meshes are not supported", mesh->name.c_str() );
+    }
+
+    context->clump->geometries.push_back( SceneGeometry() );
+    unsigned int geometryId = context->clump->geometries.size() - 1;
+    context->geometries.insert( std::pair<const XObject*,unsigned int>( mesh, geometryId ) );
+    SceneGeometry* geometry = &context->clump->geometries.back();
+    geometry->name = mesh->name.length() ? mesh->name : "NamelessGeometry";
+
+    // positions & faces
+    XReader reader( mesh );
+    unsigned int i, j;
+    unsigned int numPositions = reader.getCount();
+    std::vector<float> positions( numPositions * 3 );
+    for( i=0; i<numPositions*3; i++ ) positions[i] = reader.getFloat();
+    std::vector< std::vector<unsigned int> > faces;
+    readFaces( reader, faces, numPositions );
+
+    // normals
+    const XObject* meshNormals = mesh->findChild( "MeshNormals" );
+    std::vector<float> normals;
+    std::vector< std::vector<unsigned int> > normalFaces;
+    if( meshNormals )
+    {
+        XReader normalReader( meshNormals );
+        unsigned int numNormals = normalReader.getCount();
+        normals.resize( numNormals * 3 );
+        for( i=0; i<numNormals*3; i++ ) normals[i] = normalReader.getFloat();
+        readFaces( normalReader, normalFaces, numNormals );
+        if( normalFaces.size() != faces.size() ) throw ConvException( "inconsistent number of normal faces" );
+        for( i=0; i<faces.size(); i++ )
+        {
+            if( normalFaces[i].size() != faces[i].size() ) throw ConvException( "inconsistent normal face %d", i );
+        }
+    }
+    else
+    {
+        // no normals in source : smooth normals weighted by face area
+        normals.assign( numPositions * 3, 0.0f );
+        normalFaces = faces;
+        for( i=0; i<faces.size(); i++ )
+        {
+            for( j=1; j+1<faces[i].size(); j++ )
+            {
+                const float* v0 = &positions[faces[i][0]*3];
+                const float* v1 = &positions[faces[i][j]*3];
+                const float* v2 = &positions[faces[i][j+1]*3];
+                float e1[3] = { v1[0]-v0[0], v1[1]-v0[1], v1[2]-v0[2] };
+                float e2[3] = { v2[0]-v0[0], v2[1]-v0[1], v2[2]-v0[2] };
+                // same orientation as Geometry::setMesh() uses
+                float n[3] = { e2[1]*e1[2]-e2[2]*e1[1], e2[2]*e1[0]-e2[0]*e1[2], e2[0]*e1[1]-e2[1]*e1[0] };
+                unsigned int ids[3] = { faces[i][0], faces[i][j], faces[i][j+1] };
+                for( unsigned int k=0; k<3; k++ )
+                {
+                    normals[ids[k]*3+0] += n[0], normals[ids[k]*3+1] += n[1], normals[ids[k]*3+2] += n[2];
+                }
+            }
+        }
+        for( i=0; i<numPositions; i++ )
+        {
+            float* n = &normals[i*3];
+            float length = sqrt( n[0]*n[0] + n[1]*n[1] + n[2]*n[2] );
+            if( length > 0 ) n[0] /= length, n[1] /= length, n[2] /= length;
+        }
+    }
+
+    // texture coordinates & vertex colors are specified per position
+    const XObject* meshTextureCoords = mesh->findChild( "MeshTextureCoords" );
+    std::vector<float> uvs;
+    if( meshTextureCoords )
+    {
+        XReader uvReader( meshTextureCoords );
+        if( uvReader.getCount() != numPositions ) throw ConvException( "inconsistent number of texture coordinates" );
+        uvs.resize( numPositions * 2 );
+        for( i=0; i<numPositions*2; i++ ) uvs[i] = uvReader.getFloat();
+    }
+    const XObject* meshVertexColors = mesh->findChild( "MeshVertexColors" );
+    std::vector<unsigned int> colors;
+    if( meshVertexColors )
+    {
+        XReader colorReader( meshVertexColors );
+        unsigned int numColors = colorReader.getCount();
+        colors.assign( numPositions, 0xFFFFFFFF );
+        for( i=0; i<numColors; i++ )
+        {
+            unsigned int index = colorReader.getCount();
+            float r = colorReader.getFloat();
+            float g = colorReader.getFloat();
+            float b = colorReader.getFloat();
+            float a = colorReader.getFloat();
+            if( index < numPositions ) colors[index] = packColor( r, g, b, a );
+        }
+    }
+
+    // materials
+    std::vector<unsigned int> faceShaders( faces.size(), 0 );
+    const XObject* materialList = mesh->findChild( "MeshMaterialList" );
+    if( materialList )
+    {
+        XReader materialReader( materialList );
+        unsigned int numMaterials = materialReader.getCount();
+        unsigned int numFaceIndices = materialReader.getCount();
+        for( i=0; i<numFaceIndices; i++ )
+        {
+            unsigned int shaderId = materialReader.getCount();
+            if( i < faceShaders.size() ) faceShaders[i] = shaderId;
+        }
+        // missing face indices repeat the last one
+        for( i=numFaceIndices; i<faceShaders.size() && numFaceIndices; i++ )
+        {
+            faceShaders[i] = faceShaders[numFaceIndices-1];
+        }
+        for( i=0; i<materialList->children.size(); i++ )
+        {
+            const XObject* material = resolve( context, materialList->children[i] );
+            if( material->type != "Material" ) continue;
+            buildShader( context, material, geometry, geometry->shaders.size() );
+        }
+        if( geometry->shaders.size() != numMaterials )
+        {
+            throw ConvException( "mesh \"%s\" declares %d materials, but has %d", geometry->name.c_str(), numMaterials, int( geometry->shaders.size() ) );
+        }
+    }
+    // geometry without materials gets a default shader
+    if( geometry->shaders.empty() ) buildShader( context, NULL, geometry, 0 );
+    for( i=0; i<faceShaders.size(); i++ )
+    {
+        if( faceShaders[i] >= geometry->shaders.size() ) throw ConvException( "face %d refers to missing material", i );
+    }
+
+    // split positions with different normals into separate vertices
+    std::map< std::pair<unsigned int,unsigned int>, unsigned int > vertexMap;
+    std::vector< std::vector<unsigned int> > vertexFaces( faces.size() );
+    for( i=0; i<faces.size(); i++ )
+    {
+        vertexFaces[i].resize( faces[i].size() );
+        for( j=0; j<faces[i].size(); j++ )
+        {
+            std::pair<unsigned int,unsigned int> key( faces[i][j], normalFaces[i][j] );
+            std::map< std::pair<unsigned int,unsigned int>, unsigned int >::iterator vertexI = vertexMap.find( key );
+            if( vertexI != vertexMap.end() )
+            {
+                vertexFaces[i][j] = vertexI->second;
+                continue;
+            }
+            unsigned int vertexId = geometry->getNumVertices();
+            if( vertexId >= maxGeometryVertices )
+            {
+                throw ConvException( "mesh \"%s\" has too many vertices", geometry->name.c_str() );
+            }
+            vertexMap.insert( std::pair< std::pair<unsigned int,unsigned int>, unsigned int >( key, vertexId ) );
+            vertexFaces[i][j] = vertexId;
+            geometry->vertices.insert( geometry->vertices.end(), &positions[key.first*3], &positions[key.first*3] + 3 );
+            geometry->normals.insert( geometry->normals.end(), &normals[key.second*3], &normals[key.second*3] + 3 );
+            if( uvs.size() ) geometry->uvs.insert( geometry->uvs.end(), &uvs[key.first*2], &uvs[key.first*2] + 2 );
+            if( colors.size() ) geometry->prelights.push_back( colors[key.first] );
+        }
+    }
+
+    // triangulate faces as fans
+    SceneTriangle triangle;
+    for( i=0; i<vertexFaces.size(); i++ )
+    {
+        for( j=1; j+1<vertexFaces[i].size(); j++ )
+        {
+            triangle.vertexId[0] = vertexFaces[i][0];
+            triangle.vertexId[1] = vertexFaces[i][j];
+            triangle.vertexId[2] = vertexFaces[i][j+1];
+            triangle.shaderId    = faceShaders[i];
+            geometry->triangles.push_back( triangle );
+        }
+    }
+
+    return geometryId;
+}
+
+static std::string childFrameName(SceneClump* clump, int parentId, unsigned int childId)
+{
+    // same rule as XAsset::resolveNamelessFrames()
+    if( parentId < 0 ) return "Root";
+    char frameName[1024];
+    sprintf( frameName, "%.960s_child%d", clump->frames[parentId].name.c_str(), childId );
+    return frameName;
+}
+
+static void buildFrame(BuildContext* context, const XObject* frame, int parentId, unsigned int childId)
+{
+    SceneFrame sceneFrame;
+    sceneFrame.name = frame->name.length() ? frame->name : childFrameName( context->clump, parentId, childId );
+    sceneFrame.parentId = parentId;
+    memcpy( sceneFrame.matrix, identityMatrix, sizeof(identityMatrix) );
+
+    const XObject* transformation = frame->findChild( "FrameTransformMatrix" );
+    if( transformation )
+    {
+        XReader reader( transformation );
+        for( unsigned int i=0; i<16; i++ ) sceneFrame.matrix[i] = reader.getFloat();
+    }
+
+    context->clump->frames.push_back( sceneFrame );
+    int frameId = int( context->clump->frames.size() ) - 1;
+
+    // meshes & child frames, in order of declaration
+    unsigned int numChildFrames = 0;
+    for( unsigned int i=0; i<frame->children.size(); i++ )
+    {
+        const XObject* child = resolve( context, frame->children[i] );
+        if( child->type == "Mesh" )
+        {
+            SceneAtomic atomic;
+            atomic.geometryId = buildGeometry( context, child );
+            atomic.frameId    = frameId;
+            context->clump->atomics.push_back( atomic );
+        }
+        else if( child->type == "Frame" )
+        {
+            buildFrame( context, child, frameId, numChildFrames++ );
+        }
+    }
+}
+
+/**
+ * scene building
+ */
+
+void buildClump(const XFile* xFile, SceneClump* clump)
+{
+    BuildContext context;
+    context.xFile = xFile;
+    context.clump = clump;
+
+    clump->name = "SCENE_ROOT";
+
+    // analyze top-level objects
+    const XObject* root = xFile->getRoot();
+    std::vector<const XObject*> topLevel;
+    unsigned int i;
+    for( i=0; i<root->children.size(); i++ )
+    {
+        const XObject* object = root->children[i];
+        if( object->type == "AnimationSet" || object->type == "Animation" )
+        {
+            throw ConvException( "file contains animations, animated assets are not supported" );
+        }
+        if( object->type == "Frame" || object->type == "Mesh" ) topLevel.push_back( object );
+    }
+    if( topLevel.empty() ) throw ConvException( "file contains no frames and meshes" );
+
+    // single top-level frame is the root frame, otherwise top-level
+    // frames and meshes are gathered under the common root
+    if( topLevel.size() == 1 && topLevel[0]->type == "Frame" )
+    {
+        buildFrame( &context, topLevel[0], -1, 0 );
+    }
+    else
+    {
+        XObject rootFrame;
+        rootFrame.type = "Frame";
+        rootFrame.name = "Root";
+        for( i=0; i<topLevel.size(); i++ ) rootFrame.children.push_back( const_cast<XObject*>( topLevel[i] ) );
+        try
+        {
+            buildFrame( &context, &rootFrame, -1, 0 );
+        }
+        catch( ... )
+        {
+            rootFrame.children.clear();
+            throw;
+        }
+        // children are owned by file
+        rootFrame.children.clear();
+    }
+}
@@ -0,0 +1,98 @@
+/**
+ * This source code is a part of D3 game project.
+ * (c) Digital Dimension Development, 2004-2005
+ *
+ * @description asset converter : device-independent scene description
+ *
+ * @author bad3p
+ */
+
+#ifndef ASSETCONV_SCENE_INCLUDED
+#define ASSETCONV_SCENE_INCLUDED
+
+#include "headers.h"
+#include "xfile.h"
+
+/**
+ * scene objects are plain copies of data the engine keeps in
+ * Texture, Shader, Geometry, Frame & Atomic classes, and they are
+ * built following the same rules the engine uses for x-file import
+ * (see XAsset & Geometry::captureMeshData())
+ */
+
+struct SceneTexture
+{
+public:
+    std::string name;       // engine texture name (file name without extension)
+    std::string sourcePath; // path of texture file referenced by source asset
+};
+
+struct SceneShader
+{
+public:
+    std::string name;
+    int         textureId;  // index in SceneClump::textures, or -1
+    float       diffuse[4];
+    float       specular[4];
+    float       power;
+};
+
+struct SceneTriangle
+{
+public:
+    unsigned int vertexId[3];
+    unsigned int shaderId;
+};
+
+struct SceneGeometry
+{
+public:
+    std::string                name;
+    std::vector<float>         vertices;  // xyz
+    std::vector<float>         normals;   // xyz
+    std::vector<float>         uvs;       // uv, empty if geometry has no UV-set
+    std::vector<unsigned int>  prelights; // ARGB, empty if geometry has no prelights
+    std::vector<SceneTriangle> triangles;
+    std::vector<SceneShader>   shaders;
+    std::vector<float>         tangents;  // xyz, empty if tangents aren't calculated (see meshprep.h)
+    std::vector<float>         binormals; // xyz, ditto
+    bool                       optimized; // triangles & vertices are ordered by optimizeGeometry()
+public:
+    SceneGeometry() : optimized(false) {}
+public:
+    inline unsigned int getNumVertices(void) const { return vertices.size() / 3; }
+};
+
+struct SceneFrame
+{
+public:
+    std::string name;
+    float       matrix[16];
+    int         parentId;   // index in SceneClump::frames, or -1 for root frame
+};
+
+struct SceneAtomic
+{
+public:
+    unsigned int geometryId;
+    unsigned int frameId;
+};
+
+struct SceneClump
+{
+public:
+    std::string                name;
+    std::vector<SceneFrame>    frames;     // root first, parents precede children
+    std::vector<SceneGeometry> geometries;
+    std::vector<SceneAtomic>   atomics;
+    std::vector<SceneTexture>  textures;
+};
+
+/**
+ * builds clump from x-file contents, throws ConvException
+ * for data which can't be represented by binary asset
+ */
+
+void buildClump(const XFile* xFile, SceneClump* clump);
+
+#endif
@@ -0,0 +1,148 @@
+
+#include "headers.h"
+#include "thread.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
+
+/**
+ * mutex
+ */
+
+Mutex::Mutex()
+{
+    #ifdef _WIN32
+        CRITICAL_SECTION* cs = new CRITICAL_SECTION;
+        InitializeCriticalSection( cs );
+        _handle = cs;
+    #else
+        pthread_mutex_t* mutex = new pthread_mutex_t;
+        pthread_mutex_init( mutex, NULL );
+        _handle = mutex;
+    #endif
+}
+
+Mutex::~Mutex()
+{
+    #ifdef _WIN32
+        CRITICAL_SECTION* cs = reinterpret_cast<CRITICAL_SECTION*>( _handle );
+        DeleteCriticalSection( cs );
+        delete cs;
+    #else
+        pthread_mutex_t* mutex = reinterpret_cast<pthread_mutex_t*>( _handle );
+        pthread_mutex_destroy( mutex );
+        delete mutex;
+    #endif
+}
+
+void Mutex::lock(void)
+{
+    #ifdef _WIN32
+        EnterCriticalSection( reinterpret_cast<CRITICAL_SECTION*>( _handle ) );
+    #else
+        pthread_mutex_lock( reinterpret_cast<pthread_mutex_t*>( _handle ) );
+    #endif
+}
+
+void Mutex::unlock(void)
+{
+    #ifdef _WIN32
+        LeaveCriticalSection( reinterpret_cast<CRITICAL_SECTION*>( _handle ) );
+    #else
+        pthread_mutex_unlock( reinterpret_cast<pthread_mutex_t*>( _handle ) );
+    #endif
+}
+
+/**
+ * worker pool
+ */
+
+struct WorkerStart
+{
+public:
+    unsigned int workerId;
+    WorkerProc   proc;
+    void*        data;
+};
+
+#ifdef _WIN32
+    static DWORD WINAPI workerEntry(void* param)
+    {
+        WorkerStart* start = reinterpret_cast<WorkerStart*>( param );
+        start->proc( start->workerId, start->data );
+        return 0;
+    }
+#else
+    static void* workerEntry(void* param)
+    {
+        WorkerStart* start = reinterpret_cast<WorkerStart*>( param );
+        start->proc( start->workerId, start->data );
+        return NULL;
+    }
+#endif
+
+void runWorkers(unsigned int numWorkers, WorkerProc proc, void* data)
+{
+    if( numWorkers < 1 ) numWorkers = 1;
+
+    // single worker runs in calling thread
+    if( numWorkers == 1 )
+    {
+        proc( 0, data );
+        return;
+    }
+
+    std::vector<WorkerStart> starts( numWorkers );
+    unsigned int i;
+    for( i=0; i<numWorkers; i++ )
+    {
+        starts[i].workerId = i;
+        starts[i].proc     = proc;
+        starts[i].data     = data;
+    }
+
+    #ifdef _WIN32
+        std::vector<HANDLE> threads( numWorkers, HANDLE( NULL ) );
+        for( i=0; i<numWorkers; i++ )
+        {
+            threads[i] = CreateThread( NULL, 0, workerEntry, &starts[i], 0, NULL );
+            // failed to start : do the work in calling thread
+            if( threads[i] == NULL ) proc( i, data );
+        }
+        for( i=0; i<numWorkers; i++ )
+        {
+            if( threads[i] == NULL ) continue;
+            WaitForSingleObject( threads[i], INFINITE );
+            CloseHandle( threads[i] );
+        }
+    #else
+        std::vector<pthread_t> threads( numWorkers );
+        std::vector<bool>      started( numWorkers, false );
+        for( i=0; i<numWorkers; i++ )
+        {
+            started[i] = ( pthread_create( &threads[i], NULL, workerEntry, &starts[i] ) == 0 );
+            // failed to start : do the work in calling thread
+            if( !started[i] ) proc( i, data );
+        }
+        for( i=0; i<numWorkers; i++ )
+        {
+            if( started[i] ) pthread_join( threads[i], NULL );
+        }
+    #endif
+}
+
+unsigned int getNumProcessors(void)
+{
+    #ifdef _WIN32
+        SYSTEM_INFO systemInfo;
+        GetSystemInfo( &systemInfo );
+        return systemInfo.dwNumberOfProcessors > 0 ? systemInfo.dwNumberOfProcessors : 1;
+    #else
+        long numProcessors = sysconf( _SC_NPROCESSORS_ONLN );
+        return numProcessors > 0 ? (unsigned int)( numProcessors ) : 1;
+    #endif
+}
@@ -0,0 +1,80 @@
+/**
+ * This source code is a part of D3 game project.
+ * (c) Digital Dimension Development, 2004-2005
+ *
+ * @description asset converter : portable threading primitives
+ *
+ * @author bad3p
+ */
+
+#ifndef ASSETCONV_THREAD_INCLUDED
+#define ASSETCONV_THREAD_INCLUDED
+
+#include "headers.h"
+
+/**
+ * mutual exclusion lock
+ */
+
+class Mutex
+{
+private:
+    void* _handle;
+public:
+    Mutex();
+    ~Mutex();
+public:
+    void lock(void);
+    void unlock(void);
+};
+
+/**
+ * scoped lock
+ */
+
+class MutexLock
+{
+private:
+    Mutex* _mutex;
+public:
+    MutexLock(Mutex* mutex) : _mutex(mutex) { _mutex->lock(); }
+    ~MutexLock() { _mutex->unlock(); }
+};
+
+/**
+ * worker pool : runs given procedure in specified number of threads and
+ * waits for all of them; workers are expected to pull their jobs from
+ * a shared queue (see JobQueue)
+ */
+
+typedef void (*WorkerProc)(unsigned int workerId, void* data);
+
+void runWorkers(unsigned int numWorkers, WorkerProc proc, void* data);
+
+// number of hardware threads available to process
+unsigned int getNumProcessors(void);
+
+/**
+ * shared queue of job indices
+ */
+
+class JobQueue
+{
+private:
+    Mutex        _mutex;
+    unsigned int _numJobs;
+    unsigned int _nextJob;
+public:
+    JobQueue(unsigned int numJobs) : _numJobs(numJobs), _nextJob(0) {}
+public:
+    // retrieves next job index, returns false if queue is exhausted
+    bool pop(unsigned int* jobId)
+    {
+        MutexLock lock( &_mutex );
+        if( _nextJob >= _numJobs ) return false;
+        *jobId = _nextJob++;
+        return true;
+    }
+};
+
+#endif
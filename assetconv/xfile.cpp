@@ -0,0 +1,257 @@
+
+#include "headers.h"
+#include "xfile.h"
+
+/**
+ * x-object
+ */
+
+XObject::~XObject()
+{
+    for( unsigned int i=0; i<children.size(); i++ ) delete children[i];
+}
+
+const XObject* XObject::findChild(const char* childType) const
+{
+    for( unsigned int i=0; i<children.size(); i++ )
+    {
+        if( children[i]->type == childType ) return children[i];
+    }
+    return NULL;
+}
+
+/**
+ * tokens
+ */
+
+enum TokenType
+{
+    tkName,   // identifier
+    tkNumber, // integer or float
+    tkString, // quoted string
+    tkGuid,   // <guid>
+    tkOpen,   // {
+    tkClose   // }
+};
+
+struct XFile::Token
+{
+public:
+    TokenType   type;
+    std::string text;
+    double      number;
+    unsigned int line;
+};
+
+static inline bool isDelimiter(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' ||
+           c == ',' || c == ';' || c == '{' || c == '}' || c == '"' || c == '<';
+}
+
+void XFile::tokenize(const char* text, unsigned int size, TokenV& tokens)
+{
+    unsigned int line = 1;
+    unsigned int i = 0;
+    Token token;
+    while( i < size )
+    {
+        char c = text[i];
+        if( c == '\n' )
+        {
+            line++, i++;
+        }
+        else if( c == ' ' || c == '\t' || c == '\r' || c == ',' || c == ';' )
+        {
+            i++;
+        }
+        else if( c == '#' || ( c == '/' && i+1 < size && text[i+1] == '/' ) )
+        {
+            // comment till the end of line
+            while( i < size && text[i] != '\n' ) i++;
+        }
+        else if( c == '{' || c == '}' )
+        {
+            token.type = ( c == '{' ) ? tkOpen : tkClose;
+            token.text = c;
+            token.line = line;
+            tokens.push_back( token );
+            i++;
+        }
+        else if( c == '"' )
+        {
+            unsigned int start = ++i;
+            while( i < size && text[i] != '"' )
+            {
+                if( text[i] == '\n' ) line++;
+                i++;
+            }
+            token.type = tkString;
+            token.text.assign( text + start, i - start );
+            // "\\" is an escaped backslash
+            for( std::string::size_type pos = token.text.find( "\\\\" ); pos != std::string::npos; pos = token.text.find( "\\\\", pos + 1 ) )
+            {
+                token.text.erase( pos, 1 );
+            }
+            token.line = line;
+            tokens.push_back( token );
+            i++;
+        }
+        else if( c == '<' )
+        {
+            unsigned int start = ++i;
+            while( i < size && text[i] != '>' ) i++;
+            token.type = tkGuid;
+            token.text.assign( text + start, i - start );
+            token.line = line;
+            tokens.push_back( token );
+            i++;
+        }
+        else
+        {
+            unsigned int start = i;
+            while( i < size && !isDelimiter( text[i] ) ) i++;
+            token.text.assign( text + start, i - start );
+            token.line = line;
+            // numbers are tokens which are completely consumed by strtod
+            char* end = NULL;
+            token.number = strtod( token.text.c_str(), &end );
+            bool numeric = ( end == token.text.c_str() + token.text.length() ) &&
+                           ( isdigit( c ) || c == '-' || c == '+' || c == '.' );
+            token.type = numeric ? tkNumber : tkName;
+            tokens.push_back( token );
+        }
+    }
+}
+
+/**
+ * parser
+ */
+
+void XFile::parseObject(const TokenV& tokens, unsigned int& position, XObject* object)
+{
+    // object header : type [name] { [guid]
+    object->type = tokens[position++].text;
+    if( position < tokens.size() && tokens[position].type == tkName )
+    {
+        object->name = tokens[position++].text;
+    }
+    if( position >= tokens.size() || tokens[position].type != tkOpen )
+    {
+        throw ConvException(
+            "line %d : \"{\" expected after \"%s\"",
+            position < tokens.size() ? tokens[position].line : tokens.back().line,
+            object->type.c_str()
+        );
+    }
+    position++;
+    if( position < tokens.size() && tokens[position].type == tkGuid ) position++;
+
+    if( object->name.length() ) _namedObjects[object->name] = object;
+
+    // object data
+    while( position < tokens.size() )
+    {
+        const Token& token = tokens[position];
+        switch( token.type )
+        {
+        case tkClose:
+            position++;
+            return;
+        case tkNumber:
+            object->numbers.push_back( token.number );
+            position++;
+            break;
+        case tkString:
+            object->strings.push_back( token.text );
+            position++;
+            break;
+        case tkGuid:
+            position++;
+            break;
+        case tkOpen:
+            // reference : { name } or { name <guid> } or { <guid> },
+            // kept in order with nested objects as an object without type
+            position++;
+            if( position < tokens.size() && tokens[position].type == tkName )
+            {
+                XObject* reference = new XObject;
+                reference->name = tokens[position].text;
+                object->children.push_back( reference );
+            }
+            while( position < tokens.size() && tokens[position].type != tkClose ) position++;
+            position++;
+            break;
+        case tkName:
+            {
+                XObject* child = new XObject;
+                object->children.push_back( child );
+                parseObject( tokens, position, child );
+            }
+            break;
+        }
+    }
+    throw ConvException( "unexpected end of file in \"%s\"", object->type.c_str() );
+}
+
+void XFile::skipBlock(const TokenV& tokens, unsigned int& position)
+{
+    // skip till the opening brace, then till the matching closing brace
+    while( position < tokens.size() && tokens[position].type != tkOpen ) position++;
+    int depth = 0;
+    while( position < tokens.size() )
+    {
+        if( tokens[position].type == tkOpen ) depth++;
+        if( tokens[position].type == tkClose ) depth--;
+        position++;
+        if( depth == 0 ) break;
+    }
+}
+
+/**
+ * class implementation
+ */
+
+XFile::XFile(const char* buffer, unsigned int size)
+{
+    // header : "xof 0303txt 0032"
+    if( size < 16 || strncmp( buffer, "xof ", 4 ) != 0 )
+    {
+        throw ConvException( "not a DirectX file" );
+    }
+    if( strncmp( buffer + 8, "txt ", 4 ) != 0 )
+    {
+        throw ConvException(
+            "unsupported DirectX file format \"%.4s\", only text files are supported",
+            buffer + 8
+        );
+    }
+
+    TokenV tokens;
+    tokenize( buffer + 16, size - 16, tokens );
+
+    unsigned int position = 0;
+    while( position < tokens.size() )
+    {
+        const Token& token = tokens[position];
+        if( token.type != tkName )
+        {
+            throw ConvException( "line %d : unexpected \"%s\"", token.line, token.text.c_str() );
+        }
+        if( token.text == "template" )
+        {
+            skipBlock( tokens, position );
+            continue;
+        }
+        XObject* object = new XObject;
+        _root.children.push_back( object );
+        parseObject( tokens, position, object );
+    }
+}
+
+const XObject* XFile::findNamed(const std::string& objectName) const
+{
+    std::map<std::string,XObject*>::const_iterator objectI = _namedObjects.find( objectName );
+    if( objectI == _namedObjects.end() ) return NULL;
+    return objectI->second;
+}
@@ -0,0 +1,98 @@
+/**
+ * This source code is a part of D3 game project.
+ * (c) Digital Dimension Development, 2004-2005
+ *
+ * @description asset converter : DirectX text file parser
+ *
+ * @author bad3p
+ */
+
+#ifndef ASSETCONV_XFILE_INCLUDED
+#define ASSETCONV_XFILE_INCLUDED
+
+#include "headers.h"
+
+/**
+ * data object of x-file, data members of the object are not interpreted
+ * by parser : numbers & strings are stored in order of their appearance,
+ * nested objects are stored separately; references to named objects
+ * are stored among nested objects as objects with empty type
+ */
+
+class XObject
+{
+public:
+    typedef std::vector<XObject*> XObjectV;
+    typedef std::vector<std::string> StringV;
+public:
+    std::string         type;
+    std::string         name;
+    std::vector<double> numbers;
+    StringV             strings;
+    XObjectV            children;
+public:
+    XObject() {}
+    ~XObject();
+public:
+    inline bool isReference(void) const { return type.empty(); }
+    // first child of given type, or NULL
+    const XObject* findChild(const char* childType) const;
+};
+
+/**
+ * sequential reader of object numbers
+ */
+
+class XReader
+{
+private:
+    const XObject* _object;
+    unsigned int   _position;
+public:
+    XReader(const XObject* object) : _object(object), _position(0) {}
+public:
+    inline double getNumber(void)
+    {
+        if( _position >= _object->numbers.size() )
+        {
+            throw ConvException( "unexpected end of \"%s\" data", _object->type.c_str() );
+        }
+        return _object->numbers[_position++];
+    }
+    inline float getFloat(void) { return float( getNumber() ); }
+    inline int getInt(void) { return int( getNumber() ); }
+    inline unsigned int getCount(void)
+    {
+        int result = getInt();
+        if( result < 0 ) throw ConvException( "negative element count in \"%s\"", _object->type.c_str() );
+        return (unsigned int)( result );
+    }
+};
+
+/**
+ * text x-file
+ */
+
+class XFile
+{
+private:
+    XObject                           _root;
+    std::map<std::string,XObject*>    _namedObjects;
+private:
+    struct Token;
+    typedef std::vector<Token> TokenV;
+private:
+    static void tokenize(const char* text, unsigned int size, TokenV& tokens);
+    static void skipBlock(const TokenV& tokens, unsigned int& position);
+    void parseObject(const TokenV& tokens, unsigned int& position, XObject* object);
+public:
+    // parse file contents, throws ConvException for unsupported formats
+    XFile(const char* buffer, unsigned int size);
+public:
+    // top-level objects
+    inline const XObject* getRoot(void) const { return &_root; }
+    // object declared with given name anywhere in file, or NULL
+    const XObject* findNamed(const std::string& objectName) const;
+};
+
+#endif
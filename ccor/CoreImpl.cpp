@@ -44,11 +44,9 @@ CoreImpl * SingleCore::instance = 0;
 
 
 CoreImpl::CoreImpl() {
-    flog = NULL;
     coreParamPack = NULL;
     paramPackFactory = new ParamPackFactory();
     EntityBase::icore = this;
-    htmlLog = false;
     xdata = NULL;
 }
 
@@ -67,6 +65,7 @@ void CoreImpl::init() {
     }
     else logMessage("ccor : warning : can't open id database!");
     resMgr.loadPathMap("cfg/resmgr.config");
+    pacer.init(coreParamPack);
     // reset random seed
     paramid_t pidRandomize = coreParamPack->find("randomize");
     if (pidRandomize >= 0) {
@@ -95,11 +94,9 @@ void CoreImpl::release() {
         paramPackFactory = NULL;
     }
 
-    if (NULL!=flog) {
-        if (htmlLog) ::fprintf(flog, "</pre></body></html>\n");
-        ::fclose(flog);
-        flog = NULL;
-    }
+    pacer.release();
+
+    logMgr.stop();
 }
 
 
@@ -116,58 +113,44 @@ void CoreImpl::act() {
         processSystemMessages();
 
         tm.checkTriggers(&em);
+
+        pacer.endFrame();
     }
 }
 
 
 void CoreImpl::logMessageV(const char * fmt, va_list vl) {
-    if (flog) {
-        if (htmlLog) {
-            char buf[8192];
-            ::vsprintf(buf,fmt,vl);
-            if (::strstr(buf, "rror")!=0) {
-                ::fprintf(flog,"<div class=error>%s</div>", buf);
-            }
-            else if (::strstr(buf, "arning")!=0) {
-                ::fprintf(flog,"<div class=warning>%s</div>", buf);
-            }
-            else if (::strstr(buf, "xception")!=0) {
-                ::fprintf(flog,"<div class=exception>%s</div>", buf);
-            }
-            else if (::strstr(buf, "*** >")!=0) {
-                ::fprintf(flog,"<div class=console>%s</div>", buf);
-            }
-            else if (::strstr(buf, "***")!=0) {
-                ::fprintf(flog,"<div class=asterisks>%s</div>", buf);
-            }
-            else if (::strstr(buf, "core:")!=0) {
-                ::fprintf(flog,"<div class=core>%s</div>", buf);
-            }
-            else ::fprintf(flog,"<div class=text>%s</div>", buf);
-        }
-        else {
-            // put message to log
-            ::vfprintf(flog,fmt,vl);
-        }
-        ::fputc('\n',flog);
-        ::fflush(flog);
-    }    
+    logMgr.postUnclassified(fmt,vl);
 }
 
 
 void CoreImpl::startLog() {
     // Determine log type
+    bool htmlLog = false;
     paramid_t idLogType=coreParamPack->find("log.type");
     if (idLogType>=0) {
         const char * logType=coreParamPack->gets(idLogType);
         if (stricmp(logType,"html")==0) htmlLog=true;
     }
-    if (htmlLog) {
-        flog = ::fopen( htmlLog?"game_log.html":"game.log", "wt" );
-        if (flog) ::fprintf(flog, "<html><head><link href='log.css' "
-            "rel='stylesheet' type='text/css'></head><body><pre>");
+    // Minimal severity of messages: debug, info, warning, error or exception
+    paramid_t idLogLevel=coreParamPack->find("log.level");
+    if (idLogLevel>=0) {
+        static const char * levelNames[] = { "debug", "info", "warning", "error", "exception" };
+        const char * levelName=coreParamPack->gets(idLogLevel);
+        for (int i=0; i<sizeof(levelNames)/sizeof(levelNames[0]); ++i) {
+            if (stricmp(levelName,levelNames[i])==0) logMgr.setLevel(LogLevel(i));
+        }
     }
-    else flog = ::fopen("game.log", "wt");
+    // Writing in background thread (on by default)
+    int async = 1;
+    paramid_t idLogAsync=coreParamPack->find("log.async");
+    if (idLogAsync>=0) coreParamPack->get(idLogAsync,async);
+    // Max number of repeats of the same leveled message per second (0 - unlimited, default)
+    int rateLimit = 0;
+    paramid_t idLogRateLimit=coreParamPack->find("log.ratelimit");
+    if (idLogRateLimit>=0) coreParamPack->get(idLogRateLimit,rateLimit);
+
+    logMgr.start(htmlLog?"game_log.html":"game.log", htmlLog, async!=0, rateLimit>0 ? rateLimit : 0);
     logMessage(g_comLabel,"");
 }
 
@@ -14,6 +14,8 @@
 #include "Idset.h"
 #include "RandToolkit.h"
 #include "TimeMgr.h"
+#include "LogMgr.h"
+#include "FramePacer.h"
 namespace ccor {
 
 class CoreImpl;
@@ -71,6 +73,23 @@ public:
 
     virtual void __stdcall logMessageV(const char * fmt, va_list vl);
 
+    virtual void __stdcall logMessageLV(LogLevel level, const char * fmt, va_list vl) { logMgr.post(level,fmt,vl); }
+
+    virtual LogLevel __stdcall getLogLevel() { return logMgr.getLevel(); }
+
+    virtual void __stdcall setLogLevel(LogLevel level) { logMgr.setLevel(level); }
+
+    virtual void __stdcall flushLog() { logMgr.flush(); }
+
+    virtual unsigned int __stdcall copyRecentLog(char * buffer, unsigned int size) { return logMgr.copyRecent(buffer,size); }
+
+    virtual void __stdcall setPacingState(PacingState state, bool active) { pacer.setState(state,active); }
+
+    virtual void __stdcall getFrameStatistics(FrameStatistics * stats) { pacer.getStatistics(stats); }
+
+    // Write recent log messages to crash report file
+    void dumpRecentLog(const char * fileName) { logMgr.dumpRecent(fileName); }
+
     // Execute core entities
     void __stdcall act();
 
@@ -167,13 +186,13 @@ private:
     /** @link aggregation */
     TimeMgr timeMgr;
     
-    std::vector<std::string> logBuffered;
-
-    Object * xdata;
+    /** @link aggregation */
+    LogMgr logMgr;
 
-    FILE * flog;
+    /** @link aggregation */
+    FramePacer pacer;
 
-    bool htmlLog;
+    Object * xdata;
 
     void processSystemMessages();
 
@@ -0,0 +1,156 @@
+/**
+ * This source code is a part of Metathrone game project.
+ * (c) Perfect Play 2003.
+ */
+
+#include "headers.h"
+#include <windows.h>
+#include <mmsystem.h>
+#include <cmath>
+#include "FramePacer.h"
+#include "../common/profiler.h"
+#pragma comment(lib, "winmm.lib")
+namespace ccor {
+
+static const char * g_rateParams[] = {
+    "pacing.gameplay",
+    "pacing.menu",
+    "pacing.background",
+    "pacing.minimized"
+};
+
+static const float g_defaultRates[] = { 0.0f, 60.0f, 20.0f, 5.0f };
+
+
+FramePacer::FramePacer() {
+    for (int i=0; i<NUM_STATES; ++i) {
+        targetRate[i] = g_defaultRates[i];
+        activeState[i] = false;
+    }
+    activeState[pacingGameplay] = true;
+    frequency = 1;
+    lastFrame = nextFrame = 0;
+    spinTime = 0;
+    timerPeriodSet = false;
+    numFrames = 0;
+}
+
+
+FramePacer::~FramePacer() {
+    release();
+}
+
+
+void FramePacer::init(IParamPack * ppack) {
+    for (int i=0; i<NUM_STATES; ++i) {
+        paramid_t pid = ppack->find(g_rateParams[i]);
+        if (pid >= 0) {
+            ppack->get(pid, targetRate[i]);
+            if (targetRate[i] < 0) targetRate[i] = 0;
+        }
+    }
+
+    // 1 ms scheduler granularity makes Sleep() precise enough for pacing,
+    // the rest of the frame slice is spent spinning
+    timerPeriodSet = (timeBeginPeriod(1)==TIMERR_NOERROR);
+
+    ::QueryPerformanceFrequency((LARGE_INTEGER*)(&frequency));
+    spinTime = frequency * (timerPeriodSet ? 2 : 16) / 1000;
+    lastFrame = nextFrame = getPerformanceCounter();
+}
+
+
+void FramePacer::release() {
+    if (timerPeriodSet) {
+        timeEndPeriod(1);
+        timerPeriodSet = false;
+    }
+}
+
+
+void FramePacer::setState(PacingState state, bool active) {
+    assert(state >= 0 && state < NUM_STATES);
+    if (state!=pacingGameplay) activeState[state] = active;
+}
+
+
+float FramePacer::currentRate() {
+    // states are ordered by priority
+    for (int i=NUM_STATES-1; i>=0; --i) {
+        if (activeState[i]) return targetRate[i];
+    }
+    return 0;
+}
+
+
+void FramePacer::sleepUntil(__int64 deadline) {
+    for (;;) {
+        __int64 remaining = deadline - getPerformanceCounter();
+        if (remaining <= 0) break;
+        if (remaining > spinTime) {
+            DWORD ms = DWORD((remaining - spinTime) * 1000 / frequency);
+            Sleep(ms > 0 ? ms : 1);
+        }
+        else {
+            Sleep(0);
+        }
+    }
+}
+
+
+void FramePacer::endFrame() {
+    __int64 now = getPerformanceCounter();
+    float sleepSeconds = 0;
+
+    float rate = currentRate();
+    if (rate > 0) {
+        __int64 period = __int64(frequency / rate);
+        nextFrame += period;
+        // don't try to catch up if we are late more than a frame
+        if (nextFrame < now - period) nextFrame = now;
+        if (nextFrame > now) {
+            sleepUntil(nextFrame);
+            __int64 wake = getPerformanceCounter();
+            sleepSeconds = convertCounterToSeconds(wake - now);
+            now = wake;
+        }
+    }
+    else {
+        nextFrame = now;
+    }
+
+    unsigned int i = numFrames & (HISTORY_SIZE-1);
+    frameTime[i] = float(double(now - lastFrame) / double(frequency));
+    sleepTime[i] = sleepSeconds;
+    ++numFrames;
+    lastFrame = now;
+}
+
+
+void FramePacer::getStatistics(FrameStatistics * stats) {
+    assert(stats);
+    stats->targetRate = currentRate();
+    stats->meanTime = stats->deviation = 0;
+    stats->minTime = stats->maxTime = 0;
+    stats->sleepTime = 0;
+
+    unsigned int n = numFrames < HISTORY_SIZE ? numFrames : HISTORY_SIZE;
+    if (0==n) return;
+
+    double sum = 0, sumSq = 0, sumSleep = 0;
+    stats->minTime = stats->maxTime = frameTime[0];
+    for (unsigned int i=0; i<n; ++i) {
+        sum += frameTime[i];
+        sumSq += double(frameTime[i]) * frameTime[i];
+        sumSleep += sleepTime[i];
+        if (frameTime[i] < stats->minTime) stats->minTime = frameTime[i];
+        if (frameTime[i] > stats->maxTime) stats->maxTime = frameTime[i];
+    }
+    double mean = sum / n;
+    double variance = sumSq / n - mean * mean;
+    stats->meanTime = float(mean);
+    stats->deviation = float(variance > 0 ? sqrt(variance) : 0);
+    stats->sleepTime = float(sumSleep / n);
+}
+
+}
@@ -0,0 +1,68 @@
+/**
+ * This source code is a part of Metathrone game project.
+ * (c) Perfect Play 2003.
+ *
+ * @description Frame pacing: limits rate of core act() cycles according to
+ *              the most restrictive of active pacing states
+ */
+
+#ifndef H214B72CA_7630_4321_94CC_824D6F1D524C
+#define H214B72CA_7630_4321_94CC_824D6F1D524C
+#include "../shared/ccor.h"
+namespace ccor {
+
+class FramePacer {
+public:
+    FramePacer();
+    ~FramePacer();
+
+    // Load target rates from core param pack and start timing
+    void init(IParamPack * ppack);
+
+    void release();
+
+    void setState(PacingState state, bool active);
+
+    // Finish frame: sleep until the next frame is due and collect frame time
+    void endFrame();
+
+    void getStatistics(FrameStatistics * stats);
+
+private:
+
+    enum {
+        NUM_STATES   = pacingMinimized + 1,
+        HISTORY_SIZE = 128      // must be power of 2
+    };
+
+    // target frame rate for each state (0 - unlimited)
+    float targetRate[NUM_STATES];
+
+    bool activeState[NUM_STATES];
+
+    // counter frequency & the time when the next frame is due
+    __int64 frequency;
+
+    __int64 lastFrame;
+
+    __int64 nextFrame;
+
+    // time slice left to spinning after coarse sleep
+    __int64 spinTime;
+
+    bool timerPeriodSet;
+
+    float frameTime[HISTORY_SIZE];
+
+    float sleepTime[HISTORY_SIZE];
+
+    unsigned int numFrames;
+
+    float currentRate();
+
+    void sleepUntil(__int64 deadline);
+
+};
+
+}
+#endif
@@ -0,0 +1,355 @@
+/**
+ * This source code is a part of Metathrone game project.
+ * (c) Perfect Play 2003.
+ */
+
+#include "headers.h"
+#include <windows.h>
+#include "LogMgr.h"
+namespace ccor {
+
+static const char g_levelChar[] = { 'D', 'I', 'W', 'E', 'X' };
+
+
+// Guess message severity and html class by its text (legacy messages)
+static const char * classifyMessage(const char * text, LogLevel & msgLevel) {
+    msgLevel = logInfo;
+    if (::strstr(text, "rror")!=0) {
+        msgLevel = logError;
+        return "error";
+    }
+    else if (::strstr(text, "arning")!=0) {
+        msgLevel = logWarning;
+        return "warning";
+    }
+    else if (::strstr(text, "xception")!=0) {
+        msgLevel = logException;
+        return "exception";
+    }
+    else if (::strstr(text, "*** >")!=0) return "console";
+    else if (::strstr(text, "***")!=0) return "asterisks";
+    else if (::strstr(text, "core:")!=0) return "core";
+    return "text";
+}
+
+
+static const char * levelClass(LogLevel msgLevel) {
+    switch (msgLevel) {
+    case logWarning: return "warning";
+    case logError: return "error";
+    case logException: return "exception";
+    default: return "text";
+    }
+}
+
+
+LogMgr::LogMgr() {
+    level = logInfo;
+    flog = NULL;
+    htmlLog = false;
+    asyncLog = false;
+    rateLimit = 0;
+    startTime = 0;
+    slots = NULL;
+    enqueuePos = dequeuePos = writtenPos = 0;
+    dropped = 0;
+    recentPos = 0;
+    writerThread = NULL;
+    writerEvent = NULL;
+    stopping = false;
+    ::memset(rateTable, 0, sizeof(rateTable));
+    ::memset(recent, 0, sizeof(recent));
+    CRITICAL_SECTION * cs = new CRITICAL_SECTION;
+    InitializeCriticalSection(cs);
+    syncLock = cs;
+    cs = new CRITICAL_SECTION;
+    InitializeCriticalSection(cs);
+    rateLock = cs;
+}
+
+
+LogMgr::~LogMgr() {
+    stop();
+    CRITICAL_SECTION * cs = reinterpret_cast<CRITICAL_SECTION*>(syncLock);
+    DeleteCriticalSection(cs);
+    delete cs;
+    cs = reinterpret_cast<CRITICAL_SECTION*>(rateLock);
+    DeleteCriticalSection(cs);
+    delete cs;
+}
+
+
+void LogMgr::start(const char * fileName, bool html, bool async, unsigned int limit) {
+    assert(NULL==flog);
+    htmlLog = html;
+    rateLimit = limit;
+    startTime = GetTickCount();
+    flog = ::fopen(fileName, "wt");
+    if (NULL==flog) return;
+    if (htmlLog) ::fprintf(flog, "<html><head><link href='log.css' "
+        "rel='stylesheet' type='text/css'></head><body><pre>");
+    if (async) {
+        slots = new Slot[QUEUE_SIZE];
+        for (long i=0; i<QUEUE_SIZE; ++i) slots[i].sequence = i;
+        enqueuePos = dequeuePos = writtenPos = 0;
+        stopping = false;
+        writerEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+        writerThread = CreateThread(NULL, 0, writerProc, this, 0, NULL);
+        asyncLog = (writerThread!=NULL);
+    }
+}
+
+
+void LogMgr::stop() {
+    if (writerThread) {
+        stopping = true;
+        SetEvent(writerEvent);
+        WaitForSingleObject(writerThread, INFINITE);
+        CloseHandle(writerThread);
+        writerThread = NULL;
+    }
+    if (writerEvent) {
+        CloseHandle(writerEvent);
+        writerEvent = NULL;
+    }
+    asyncLog = false;
+    if (slots) {
+        delete [] slots;
+        slots = NULL;
+    }
+    if (flog) {
+        // report repeats that were suppressed in the last rate window
+        for (int i=0; i<RATE_TABLE_SIZE; ++i) {
+            if (rateTable[i].suppressed > 0) {
+                enqueuef(logInfo, "log: %d repeats suppressed: %s",
+                    rateTable[i].suppressed, rateTable[i].fmt);
+                rateTable[i].suppressed = 0;
+            }
+        }
+        if (htmlLog) ::fprintf(flog, "</pre></body></html>\n");
+        ::fclose(flog);
+        flog = NULL;
+    }
+}
+
+
+void LogMgr::post(LogLevel msgLevel, const char * fmt, va_list vl) {
+    if (msgLevel < level) return;
+    if (!checkRate(msgLevel, fmt)) return;
+    enqueue(msgLevel, false, fmt, vl);
+}
+
+
+void LogMgr::postUnclassified(const char * fmt, va_list vl) {
+    if (level > logInfo) {
+        // message may be filtered out, so guess its severity by format string right now,
+        // otherwise leave the guessing to the writer thread
+        LogLevel msgLevel;
+        classifyMessage(fmt, msgLevel);
+        if (msgLevel < level) return;
+    }
+    // legacy messages aren't rate-limited: their format strings ("%s" etc.)
+    // are shared by unrelated call sites, or come from reused buffers
+    enqueue(logInfo, true, fmt, vl);
+}
+
+
+bool LogMgr::checkRate(LogLevel msgLevel, const char * fmt) {
+    if (0==rateLimit || msgLevel >= logException) return true;
+
+    // repeats are detected by format string address & level
+    size_t key = (reinterpret_cast<size_t>(fmt) >> 2) ^ (size_t(msgLevel) * 97);
+    RateEntry & entry = rateTable[key & (RATE_TABLE_SIZE-1)];
+    unsigned int now = GetTickCount();
+    const char * prevFmt = NULL;
+    long suppressed = 0;
+    bool pass = true;
+
+    // entry is updated by several threads
+    CRITICAL_SECTION * cs = reinterpret_cast<CRITICAL_SECTION*>(rateLock);
+    EnterCriticalSection(cs);
+    if (entry.fmt!=fmt || entry.level!=msgLevel || now - entry.windowStart > RATE_WINDOW) {
+        prevFmt = entry.fmt;
+        suppressed = entry.suppressed;
+        entry.fmt = fmt;
+        entry.level = msgLevel;
+        entry.windowStart = now;
+        entry.count = 1;
+        entry.suppressed = 0;
+    }
+    else if (++entry.count > long(rateLimit)) {
+        entry.suppressed++;
+        pass = false;
+    }
+    LeaveCriticalSection(cs);
+
+    if (suppressed > 0) enqueuef(logInfo, "log: %d repeats suppressed: %s", suppressed, prevFmt);
+    return pass;
+}
+
+
+void LogMgr::enqueuef(LogLevel msgLevel, const char * fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    enqueue(msgLevel, false, fmt, args);
+    va_end(args);
+}
+
+
+void LogMgr::enqueue(LogLevel msgLevel, bool classify, const char * fmt, va_list vl) {
+    if (NULL==flog) return;
+
+    if (!asyncLog) {
+        Slot slot;
+        slot.level = msgLevel;
+        slot.classify = classify;
+        slot.time = GetTickCount() - startTime;
+        slot.thread = GetCurrentThreadId();
+        ::_vsnprintf(slot.text, MESSAGE_SIZE-1, fmt, vl);
+        slot.text[MESSAGE_SIZE-1] = 0;
+        CRITICAL_SECTION * cs = reinterpret_cast<CRITICAL_SECTION*>(syncLock);
+        EnterCriticalSection(cs);
+        write(slot);
+        ::fflush(flog);
+        LeaveCriticalSection(cs);
+        return;
+    }
+
+    // reserve slot in the bounded queue (multiple producers, single consumer)
+    Slot * slot;
+    long pos = enqueuePos;
+    for (;;) {
+        slot = slots + (pos & (QUEUE_SIZE-1));
+        long dif = slot->sequence - pos;
+        if (dif==0) {
+            if (InterlockedCompareExchange(&enqueuePos, pos+1, pos)==pos) break;
+        }
+        else if (dif < 0) {
+            // queue is full: drop ordinary messages, wait for writer with important ones
+            if (msgLevel < logError) {
+                InterlockedIncrement(&dropped);
+                return;
+            }
+            SetEvent(writerEvent);
+            Sleep(0);
+        }
+        pos = enqueuePos;
+    }
+
+    slot->level = msgLevel;
+    slot->classify = classify;
+    slot->time = GetTickCount() - startTime;
+    slot->thread = GetCurrentThreadId();
+    ::_vsnprintf(slot->text, MESSAGE_SIZE-1, fmt, vl);
+    slot->text[MESSAGE_SIZE-1] = 0;
+
+    // publish the message
+    InterlockedExchange(&slot->sequence, pos+1);
+
+    // writer polls the queue periodically, wake it up only when it is worth it
+    if (msgLevel >= logError || pos - dequeuePos > QUEUE_SIZE/2) SetEvent(writerEvent);
+}
+
+
+bool LogMgr::drain() {
+    bool written = false;
+    long pos = dequeuePos;
+    for (;;) {
+        Slot * slot = slots + (pos & (QUEUE_SIZE-1));
+        if (slot->sequence - (pos+1) < 0) break;
+        write(*slot);
+        InterlockedExchange(&slot->sequence, pos+QUEUE_SIZE);
+        InterlockedExchange(&dequeuePos, ++pos);
+        written = true;
+    }
+
+    long lost = InterlockedExchange(&dropped, 0);
+    if (lost > 0) {
+        Slot notice;
+        notice.level = logWarning;
+        notice.classify = false;
+        notice.time = GetTickCount() - startTime;
+        notice.thread = GetCurrentThreadId();
+        ::_snprintf(notice.text, MESSAGE_SIZE-1, "log: warning : queue overflow, %d messages lost", lost);
+        notice.text[MESSAGE_SIZE-1] = 0;
+        write(notice);
+        written = true;
+    }
+
+    if (written) ::fflush(flog);
+    InterlockedExchange(&writtenPos, pos);
+    return written;
+}
+
+
+void LogMgr::write(const Slot & slot) {
+    LogLevel msgLevel = slot.level;
+    const char * cls = slot.classify ? classifyMessage(slot.text, msgLevel) : levelClass(msgLevel);
+
+    if (htmlLog) ::fprintf(flog,"<div class=%s>%s</div>", cls, slot.text);
+    else ::fputs(slot.text, flog);
+    ::fputc('\n',flog);
+
+    // keep the message in the ring of recent messages
+    RecentEntry & entry = recent[recentPos & (RECENT_SIZE-1)];
+    entry.level = msgLevel;
+    entry.time = slot.time;
+    ::strncpy(entry.text, slot.text, RECENT_LENGTH-1);
+    entry.text[RECENT_LENGTH-1] = 0;
+    InterlockedIncrement(&recentPos);
+}
+
+
+void LogMgr::flush() {
+    if (!asyncLog) return;
+    // don't hang forever if the writer thread is not able to proceed (e.g. crash handler)
+    DWORD timeout = GetTickCount() + 2000;
+    while (writtenPos!=enqueuePos && GetTickCount() < timeout) {
+        SetEvent(writerEvent);
+        Sleep(1);
+    }
+}
+
+
+unsigned int LogMgr::copyRecent(char * buffer, unsigned int size) {
+    if (0==size) return 0;
+    unsigned int length = 0;
+    long last = recentPos;
+    long first = last > RECENT_SIZE ? last - RECENT_SIZE : 0;
+    for (long i=first; i<last && length+1<size; ++i) {
+        const RecentEntry & entry = recent[i & (RECENT_SIZE-1)];
+        int n = ::_snprintf(buffer+length, size-length-1, "[%6u.%03u] %c %s\n",
+            entry.time/1000, entry.time%1000, g_levelChar[entry.level], entry.text);
+        if (n < 0) {
+            length = size-1;
+            break;
+        }
+        length += n;
+    }
+    buffer[length] = 0;
+    return length;
+}
+
+
+void LogMgr::dumpRecent(const char * fileName) {
+    flush();
+    FILE * f = ::fopen(fileName, "wt");
+    if (NULL==f) return;
+    std::vector<char> buffer(RECENT_SIZE * (RECENT_LENGTH+16));
+    unsigned int length = copyRecent(&buffer[0], buffer.size());
+    ::fwrite(&buffer[0], 1, length, f);
+    ::fclose(f);
+}
+
+
+unsigned long LogMgr::writerProc(void * param) {
+    LogMgr * mgr = reinterpret_cast<LogMgr*>(param);
+    while (!mgr->stopping) {
+        WaitForSingleObject(mgr->writerEvent, 50);
+        mgr->drain();
+    }
+    mgr->drain();
+    return 0;
+}
+
+}
@@ -0,0 +1,132 @@
+/**
+ * This source code is a part of Metathrone game project.
+ * (c) Perfect Play 2003.
+ *
+ * @description Log manager implementation: messages are formatted on the
+ *              calling thread, passed through lock-free queue and written
+ *              to the log file by the background writer thread
+ */
+
+#ifndef HF55BAEA7_D2BB_4013_8E59_B8581259E702
+#define HF55BAEA7_D2BB_4013_8E59_B8581259E702
+#include "../shared/ccor.h"
+namespace ccor {
+
+class LogMgr {
+public:
+    LogMgr();
+    ~LogMgr();
+
+    // Open log file and start writer thread (synchronous writing if async is false)
+    void start(const char * fileName, bool html, bool async, unsigned int rateLimit);
+
+    // Write all pending messages, stop writer thread and close log file
+    void stop();
+
+    LogLevel getLevel() const { return level; }
+
+    void setLevel(LogLevel value) { level = value; }
+
+    // Post message of known severity
+    void post(LogLevel msgLevel, const char * fmt, va_list vl);
+
+    // Post message which severity is guessed from its text (ICore::logMessageV)
+    void postUnclassified(const char * fmt, va_list vl);
+
+    // Wait until all posted messages are written
+    void flush();
+
+    // Copy recent messages into buffer (zero-terminated), return number of characters copied
+    unsigned int copyRecent(char * buffer, unsigned int size);
+
+    // Write recent messages to separate file
+    void dumpRecent(const char * fileName);
+
+private:
+
+    enum {
+        QUEUE_SIZE      = 1024,     // must be power of 2
+        MESSAGE_SIZE    = 1024,
+        RECENT_SIZE     = 64,       // must be power of 2
+        RECENT_LENGTH   = 256,
+        RATE_TABLE_SIZE = 256,      // must be power of 2
+        RATE_WINDOW     = 1000      // ms
+    };
+
+    struct Slot {
+        volatile long sequence;
+        LogLevel      level;
+        bool          classify;
+        unsigned int  time;
+        unsigned int  thread;
+        char          text[MESSAGE_SIZE];
+    };
+
+    struct RateEntry {
+        const char *  fmt;
+        LogLevel      level;
+        long          count;
+        long          suppressed;
+        unsigned int  windowStart;
+    };
+
+    struct RecentEntry {
+        LogLevel      level;
+        unsigned int  time;
+        char          text[RECENT_LENGTH];
+    };
+
+    volatile LogLevel level;
+
+    FILE * flog;
+
+    bool htmlLog;
+
+    bool asyncLog;
+
+    unsigned int rateLimit;
+
+    unsigned int startTime;
+
+    Slot * slots;
+
+    volatile long enqueuePos;
+
+    volatile long dequeuePos;
+
+    volatile long writtenPos;
+
+    volatile long dropped;
+
+    RateEntry rateTable[RATE_TABLE_SIZE];
+
+    RecentEntry recent[RECENT_SIZE];
+
+    volatile long recentPos;
+
+    void * writerThread;
+
+    void * writerEvent;
+
+    void * syncLock;
+
+    void * rateLock;
+
+    volatile bool stopping;
+
+    bool checkRate(LogLevel msgLevel, const char * fmt);
+
+    void enqueue(LogLevel msgLevel, bool classify, const char * fmt, va_list vl);
+
+    void enqueuef(LogLevel msgLevel, const char * fmt, ...);
+
+    bool drain();
+
+    void write(const Slot & slot);
+
+    static unsigned long __stdcall writerProc(void * param);
+
+};
+
+}
+#endif
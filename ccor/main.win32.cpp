@@ -47,6 +47,19 @@ static const void parseCommandLine(LPSTR cmdLine) {
 }
 
 
+// Save recent log messages when the process is about to crash
+static LONG WINAPI crashFilter(EXCEPTION_POINTERS * exceptionInfo) {
+    ICore * c = SingleCore::getInstance();
+    if (c) {
+        c->logMessage(logException, "core: Unhandled exception 0x%08X at 0x%p", 
+            exceptionInfo->ExceptionRecord->ExceptionCode, 
+            exceptionInfo->ExceptionRecord->ExceptionAddress);
+        static_cast<CoreImpl*>(c)->dumpRecentLog("game_crash.log");
+    }
+    return EXCEPTION_CONTINUE_SEARCH;
+}
+
+
 int PASCAL WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR cmdLine, int cmdShow)
 {
     // --------------------------------------------
@@ -60,6 +73,7 @@ int PASCAL WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR cmdLine, in
 
         ICore * c = SingleCore::getInstance();
         static_cast<CoreImpl*>(c)->init();
+        SetUnhandledExceptionFilter(crashFilter);
         IParamPack * ppack = c->getCoreParamPack();
 
         parseCommandLine(cmdLine);
@@ -81,6 +95,7 @@ int PASCAL WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR cmdLine, in
     }
     catch(const Exception& e) {
         SingleCore::getInstance()->logMessage("Exception! %s", e.getMsg());
+        static_cast<CoreImpl*>(SingleCore::getInstance())->dumpRecentLog("game_crash.log");
         MessageBoxA(NULL,_T(e.getMsg()),_T("exception"),MB_OK | MB_ICONSTOP);
         rcode = 1;
 #ifdef _DEBUG
@@ -92,6 +107,7 @@ int PASCAL WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR cmdLine, in
 #ifndef _DEBUG
     catch(...) {
         SingleCore::getInstance()->logMessage("Unhandled exception!");
+        static_cast<CoreImpl*>(SingleCore::getInstance())->dumpRecentLog("game_crash.log");
         MessageBoxA(NULL,_T(""),_T("unhandled exception"),MB_OK | MB_ICONSTOP);
         rcode = 1;
     }
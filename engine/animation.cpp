@@ -621,6 +621,21 @@ void AnimationController::blend(float interpolator)
     _hierarchy->dirty();
 }
 
+void AnimationController::copyPose(engine::IAnimationController* source)
+{
+    AnimationController* sourceController = dynamic_cast<AnimationController*>( source );
+    assert( sourceController );
+    assert( sourceController->_animationSet == _animationSet );
+
+    for( unsigned int i=0; i<_animationSet->getNumAnimations(); i++ )
+    {
+        *_animationOutput[i] = *sourceController->_animationOutput[i];
+    }
+
+    _hierarchy->dirty();
+    Engine::statistics.animationPoseCopies++;
+}
+
 /**
  * weight set manipulation
  */
@@ -170,6 +170,7 @@ public:
     virtual void __stdcall captureBlendSrc(void);
     virtual void __stdcall captureBlendDst(void);
     virtual void __stdcall blend(float interpolator);
+    virtual void __stdcall copyPose(engine::IAnimationController* source);
     // IAnimationController : weight set manipulation
     virtual unsigned int __stdcall getNumAnimations(void);
     virtual void __stdcall createWeightSet(const char* weightSetName);
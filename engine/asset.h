@@ -128,6 +128,7 @@ public:
 #define BA_EFFECT    0x7866650D 
 #define BA_BINARY    0x6E69620D
 #define BA_EXTENSION 0x7478650D
+#define BA_PREPARED  0x7072700D
 
 // binary asset extension types
 #define BAEXT_LIGHTMAPS 0x6D746C0D
@@ -250,9 +251,11 @@ class XAsset : public Asset
 private:
     void resolveNamelessFrames(Clump* clump);
     void createD3HierarchyClasses(Clump* clump, D3DXFRAME* frame);
+    void load(const char* resourcePath, const void* buffer, unsigned int size);
 public:
     // class implementation
     XAsset(const char* resourcePath);
+    XAsset(const char* resourcePath, const void* data, unsigned int size);
     virtual ~XAsset(void);
 public:
     // IAsset
@@ -195,6 +195,11 @@ void Atomic::render(void)
     {
         if( reinterpret_cast<BSP*>(_bsp)->getRenderFrameId() == _renderFrameId ) return;
         _renderFrameId = reinterpret_cast<BSP*>(_bsp)->getRenderFrameId();
+        if( reinterpret_cast<BSP*>(_bsp)->isOccluded( &_boundingSphere ) )
+        {
+            Engine::statistics.atomicsOccluded++;
+            return;
+        }
     }
     if( _frame && _geometry )
     {
@@ -254,6 +259,11 @@ void Atomic::renderDepthMap(void)
     {
         if( reinterpret_cast<BSP*>(_bsp)->getRenderFrameId() == _renderFrameId ) return;
         _renderFrameId = reinterpret_cast<BSP*>(_bsp)->getRenderFrameId();
+        if( reinterpret_cast<BSP*>(_bsp)->isOccluded( &_boundingSphere ) )
+        {
+            Engine::statistics.atomicsOccluded++;
+            return;
+        }
     }
     if( _frame && _geometry )
     {
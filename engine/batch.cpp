@@ -283,6 +283,12 @@ void Batch::updateLODs(Sector* sector)
 {
     if( ::intersectAABBFrustum( &sector->boundingBox, Camera::frustrum ) )
     {
+        // hidden behind occluders?
+        if( BSP::currentBSP && BSP::currentBSP->isOccluded( &sector->boundingBox ) )
+        {
+            Engine::statistics.batchSectorsOccluded++;
+            return;
+        }
         // leaf?
         if( sector->left == NULL && sector->right == NULL )
         {
@@ -6,6 +6,7 @@
 #include "collision.h"
 #include "camera.h"
 #include "gui.h"
+#include "sprite.h"
 
 BSP*       BSP::currentBSP = NULL;
 BSPSector* BSPSector::currentSector = NULL;
@@ -54,6 +55,7 @@ BSPSector::BSPSector(BSP* bsp, BSPSector* parent, AABB boundingBox, Geometry* ge
         _bsp->_root = this;
     }
     _boundingBox = boundingBox;
+    _center = 0.5f * ( _boundingBox.inf + _boundingBox.sup );
     _geometry = geometry;
     if( _geometry ) _geometry->_numReferences++;
     _lightmap = NULL;
@@ -378,23 +380,18 @@ BSPSector* BSP::sectorRender(BSPSector* sector)
 {
     if( intersectAABBFrustum( &sector->_boundingBox, Camera::frustrum ) )
     {
+        if( sector->_bsp->isOccluded( &sector->_boundingBox ) )
+        {
+            Engine::statistics.bspOccluded++;
+            return sector;
+        }
         if( sector->_leftSubset )
         {
-            sector->_lsc = sector->_leftSubset->getBoundingBox()->inf + 0.5f * ( sector->_leftSubset->getBoundingBox()->sup - sector->_leftSubset->getBoundingBox()->inf );
-            sector->_rsc = sector->_rightSubset->getBoundingBox()->inf + 0.5f * ( sector->_rightSubset->getBoundingBox()->sup - sector->_rightSubset->getBoundingBox()->inf );
-            sector->_lsd = Camera::eyePos - sector->_lsc;
-            sector->_rsd = Camera::eyePos - sector->_rsd;
-
-            if( D3DXVec3LengthSq( &sector->_lsd ) < D3DXVec3LengthSq( &sector->_rsd ) )
-            {
-                sectorRender( sector->_leftSubset );
-                sectorRender( sector->_rightSubset );
-            }
-            else
-            {
-                sectorRender( sector->_rightSubset );
-                sectorRender( sector->_leftSubset );
-            }
+            BSPSector* nearSubset;
+            BSPSector* farSubset;
+            sector->getOrderedSubsets( Camera::eyePos, &nearSubset, &farSubset );
+            sectorRender( nearSubset );
+            sectorRender( farSubset );
         }
         else
         {
@@ -448,6 +445,9 @@ BSP::BSP(const char* bspName, AABB boundingBox, int numShaders)
 
     _postRenderCallback = NULL;
     _postRenderCallbackData = NULL;
+
+    _occlusionBuffer  = NULL;
+    _occlusionCulling = false;
 }
 
 BSP::~BSP()
@@ -480,6 +480,7 @@ BSP::~BSP()
     for( int i=0; i<_numShaders; i++ ) _shaders[i]->release();
     delete _shaders;
     delete _shadowVolume;
+    if( _occlusionBuffer ) delete _occlusionBuffer;
 }
 
 const char* BSP::getName(void)
@@ -769,6 +770,7 @@ void BSP::render(void)
     }
 
     // render all opaque geometry
+    beginOcclusionCulling();
     sectorRender( _root );
 
     // render all batched geometries
@@ -780,6 +782,9 @@ void BSP::render(void)
     // render all transparent geometry
     renderAlphaGeometry();
 
+    // shadows of hidden objects may be visible
+    endOcclusionCulling();
+
     {
         // find light for shadow casting
         Light* caster = NULL;
@@ -818,6 +823,9 @@ void BSP::render(void)
         (*pSysI)->render();
     }
 
+    // glows of renderings are collected by sprite batch
+    SpriteBatch::flush();
+
     if( _postRenderCallback ) _postRenderCallback( _postRenderCallbackData );
 
     // bugfix (render state corrector)
@@ -1218,4 +1226,52 @@ void BSP::setPostRenderCallback(engine::BSPRenderCallback callback, void* data)
 {
     _postRenderCallback = callback;
     _postRenderCallbackData = data;
-}
\ No newline at end of file
+}
+
+/**
+ * occlusion culling
+ */
+
+void BSP::addOccluder(engine::IAtomic* atomic)
+{
+    Atomic*   a        = dynamic_cast<Atomic*>( atomic ); assert( a );
+    Geometry* geometry = a->geometry();
+    if( geometry == NULL ) return;
+
+    Matrix*   ltm       = &a->frame()->LTM;
+    Vector*   vertices  = geometry->getVertices();
+    Triangle* triangles = geometry->getTriangles();
+    Vector    vertex;
+    _occluders.reserve( _occluders.size() + 3 * geometry->getNumTriangles() );
+    for( int i=0; i<geometry->getNumTriangles(); i++ )
+    {
+        for( int j=0; j<3; j++ )
+        {
+            D3DXVec3TransformCoord( &vertex, vertices + triangles[i].vertexId[j], ltm );
+            _occluders.push_back( vertex );
+        }
+    }
+}
+
+void BSP::removeOccluders(void)
+{
+    _occluders.clear();
+    _occlusionCulling = false;
+}
+
+void BSP::beginOcclusionCulling(void)
+{
+    _occlusionCulling = !_occluders.empty();
+    if( !_occlusionCulling ) return;
+
+    if( _occlusionBuffer == NULL ) _occlusionBuffer = new OcclusionBuffer( 256, 128 );
+
+    Matrix viewProj = Camera::viewMatrix * Camera::projectionMatrix;
+    _occlusionBuffer->clear( &viewProj );
+    _occlusionBuffer->rasterize( &_occluders[0], _occluders.size() / 3 );
+}
+
+void BSP::endOcclusionCulling(void)
+{
+    _occlusionCulling = false;
+}
@@ -21,6 +21,7 @@
 #include "psys.h"
 #include "batch.h"
 #include "shadows.h"
+#include "occlusion.h"
 
 /**
  * IBSPSector
@@ -57,7 +58,7 @@ private:
     LightS       _lightsInSector;
     Geometry*    _geometry;
     Texture*     _lightmap;
-    Vector       _lsc, _rsc, _lsd, _rsd; // temporary data
+    Vector       _center; // center of bounding box
 public:
     // class implementation
     BSPSector(BSP* bsp, BSPSector* parent, AABB boundingBox, Geometry* geometry);
@@ -75,6 +76,20 @@ public:
     inline Geometry* geometry(void) { return _geometry; }
     inline BSP* bsp(void) { return _bsp; }
     inline Texture* lightmap(void) { return _lightmap; }
+    inline void getOrderedSubsets(const Vector& eyePos, BSPSector** nearSubset, BSPSector** farSubset)
+    {
+        // front-to-back order of subsets relative to the eye position
+        Vector ld = eyePos - _leftSubset->_center;
+        Vector rd = eyePos - _rightSubset->_center;
+        if( D3DXVec3LengthSq( &ld ) < D3DXVec3LengthSq( &rd ) )
+        {
+            *nearSubset = _leftSubset, *farSubset = _rightSubset;
+        }
+        else
+        {
+            *nearSubset = _rightSubset, *farSubset = _leftSubset;
+        }
+    }
 public:
     // module local
     BSPSector* getSectorAroundPoint(const Vector& point);
@@ -161,6 +176,9 @@ private:
     ShadowVolume*             _shadowVolume;
     engine::BSPRenderCallback _postRenderCallback;
     void*                     _postRenderCallbackData;
+    std::vector<Vector>       _occluders;        // occluder triangles (world space)
+    OcclusionBuffer*          _occlusionBuffer;  // occluders rasterized for current camera
+    bool                      _occlusionCulling; // occlusion buffer is valid in current pass
 private:
     // internals
     static engine::IAtomic* setAtomicWorldCB(engine::IAtomic* atomic, void* data);
@@ -175,6 +193,8 @@ private:
     static engine::ILight* findShadowCastLightCB(engine::ILight* light, void* data);
     static engine::IClump* findShadowCastLightCB(engine::IClump* clump, void* data);
     static void renderLensFlares(Light* light);
+    void beginOcclusionCulling(void);
+    void endOcclusionCulling(void);
 public:
     // class implementation
     BSP(const char* bspName, AABB boundingBox, int numShaders);
@@ -219,6 +239,9 @@ public:
     // IBSP : miscellaneous
     virtual Vector4f __stdcall getAmbient(unsigned int lightset = 0);
     virtual void __stdcall setPostRenderCallback(engine::BSPRenderCallback callback, void* data);
+    // IBSP : occlusion culling
+    virtual void __stdcall addOccluder(engine::IAtomic* atomic);
+    virtual void __stdcall removeOccluders(void);
 public:
     // module locals : inlines
     inline unsigned int getRenderFrameId(void) { return _renderFrameId; }
@@ -227,6 +250,8 @@ public:
     inline int getNumShaders(void) { return _numShaders; }
     inline Shader** getShaders(void) { return _shaders; }
     inline Shader* getShader(int id) { return _shaders[id]; }
+    inline bool isOccluded(const AABB* box) { return _occlusionCulling && !_occlusionBuffer->isVisible( box ); }
+    inline bool isOccluded(const Sphere* sphere) { return _occlusionCulling && !_occlusionBuffer->isVisible( sphere ); }
 public:
     // module locals
     void setShader(int id, Shader* shader);
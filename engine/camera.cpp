@@ -3,6 +3,7 @@
 #include "camera.h"
 #include "wire.h"
 #include "sprite.h"
+#include "effect.h"
 
 /**
  * current camera properties
@@ -346,6 +347,9 @@ void ScreenCamera::beginScene(unsigned int clearMode, const Vector4f& clearColor
 
     // update frustrum planes
     updateFrustrum();
+
+    // per-frame parameters of effects
+    Effect::beginFrame();
 }
 
 void ScreenCamera::endScene(void)
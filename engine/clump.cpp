@@ -163,7 +163,7 @@ engine::IClump* Clump::clone(const char* cloneName)
     Clump* result = new Clump( cloneName );
     
     // process hierarchy, clone frames, atomics and light sources
-    cloneFrameHierarchy( _frame, result );
+    cloneFrameHierarchy( _frame, NULL, result );
     
     // clone attached objects
     cloneAttachedObjects( result );
@@ -175,29 +175,29 @@ engine::IClump* Clump::clone(const char* cloneName)
     return result;
 }
 
-void Clump::cloneFrameHierarchy(Frame* frame, Clump* clone)
+void Clump::cloneFrameHierarchy(Frame* frame, Frame* clonedParent, Clump* clone)
 {
     Frame* clonedFrame = new Frame( frame->getName() );
     clonedFrame->setMatrix( frame->getMatrix() );
     
-    if( frame->pParentFrame == NULL ) 
+    // cloned parent is passed down the recursion, so the name index of 
+    // cloned hierarchy is built only once, by the first search
+    if( clonedParent == NULL ) 
     {
         clone->setFrame( clonedFrame );
     }
     else
     {
-        Frame* parentFrame = clone->frame()->findFrame( frame->pParentFrame->Name );
-        assert( parentFrame );
-        clonedFrame->setParent( parentFrame );
+        clonedFrame->setParent( clonedParent );
     }
 
     if( frame->pFrameSibling ) 
     {
-        cloneFrameHierarchy( static_cast<Frame*>( frame->pFrameSibling ), clone );
+        cloneFrameHierarchy( static_cast<Frame*>( frame->pFrameSibling ), clonedParent, clone );
     }
     if( frame->pFrameFirstChild )
     {
-        cloneFrameHierarchy( static_cast<Frame*>( frame->pFrameFirstChild ), clone );
+        cloneFrameHierarchy( static_cast<Frame*>( frame->pFrameFirstChild ), clonedFrame, clone );
     }
 }
 
@@ -38,7 +38,9 @@ void BSP::renderDepthMap(void)
     }
 
     // render bsp sectors
+    beginOcclusionCulling();
     sectorRenderDepthMap( _root );
+    endOcclusionCulling();
 
     // reset fog
     dxSetRenderState( D3DRS_FOGENABLE, FALSE );        
@@ -48,23 +50,18 @@ BSPSector* BSP::sectorRenderDepthMap(BSPSector* sector)
 {   
     if( intersectAABBFrustum( &sector->_boundingBox, Camera::frustrum ) )
     {
+        if( sector->_bsp->isOccluded( &sector->_boundingBox ) )
+        {
+            Engine::statistics.bspOccluded++;
+            return sector;
+        }
         if( sector->_leftSubset )
         {
-            sector->_lsc = sector->_leftSubset->getBoundingBox()->inf + 0.5f * ( sector->_leftSubset->getBoundingBox()->sup - sector->_leftSubset->getBoundingBox()->inf );
-            sector->_rsc = sector->_rightSubset->getBoundingBox()->inf + 0.5f * ( sector->_rightSubset->getBoundingBox()->sup - sector->_rightSubset->getBoundingBox()->inf );
-            sector->_lsd = Camera::eyePos - sector->_lsc;
-            sector->_rsd = Camera::eyePos - sector->_rsd;
-
-            if( D3DXVec3LengthSq( &sector->_lsd ) < D3DXVec3LengthSq( &sector->_rsd ) )
-            {
-                sectorRenderDepthMap( sector->_leftSubset );
-                sectorRenderDepthMap( sector->_rightSubset );
-            }
-            else
-            {
-                sectorRenderDepthMap( sector->_rightSubset );
-                sectorRenderDepthMap( sector->_leftSubset );
-            }
+            BSPSector* nearSubset;
+            BSPSector* farSubset;
+            sector->getOrderedSubsets( Camera::eyePos, &nearSubset, &farSubset );
+            sectorRenderDepthMap( nearSubset );
+            sectorRenderDepthMap( farSubset );
         }
         else
         {
@@ -35,6 +35,8 @@ Effect::HLSLMap Effect::_hlslMap;
 IParamPack*     Effect::_hlslConfig = NULL;
 StaticLostable* Effect::_hlslLostable = NULL;
 
+Effect::FrameParameters Effect::_frameParameters;
+
 Effect::~Effect()
 {
     for( EffectI effectI = _animatedEffects.begin();
@@ -183,12 +185,56 @@ void Effect::update(float dt)
     }
 }
 
+/**
+ * per-frame parameter block
+ */
+
+void Effect::beginFrame(void)
+{
+    _frameParameters.frameId++;
+    D3DXMatrixMultiply( &_frameParameters.viewProj, &Camera::viewMatrix, &Camera::projectionMatrix );
+}
+
+void Effect::resolveSurfaceHandles(ID3DXEffect* effect, SurfaceHandles* handles)
+{
+    handles->ambientColor     = effect->GetParameterByName( NULL, "ambientColor" );
+    handles->cameraPos        = effect->GetParameterByName( NULL, "cameraPos" );
+    handles->cameraDir        = effect->GetParameterByName( NULL, "cameraDir" );
+    handles->lightPos         = effect->GetParameterByName( NULL, "lightPos" );
+    handles->lightColor       = effect->GetParameterByName( NULL, "lightColor" );
+    handles->materialDiffuse  = effect->GetParameterByName( NULL, "materialDiffuse" );
+    handles->materialSpecular = effect->GetParameterByName( NULL, "materialSpecular" );
+    handles->materialPower    = effect->GetParameterByName( NULL, "materialPower" );
+    handles->worldViewProj    = effect->GetParameterByName( NULL, "worldViewProj" );
+    handles->baseTexture      = effect->GetParameterByName( NULL, "baseTexture" );
+    handles->normalMap        = effect->GetParameterByName( NULL, "normalMap" );
+}
+
+bool Effect::uploadFrameBlock(ID3DXEffect* effect, const SurfaceHandles* handles, FrameBlock* block)
+{
+    // global ambient may be changed by lightset
+    if( block->frameId == _frameParameters.frameId &&
+        memcmp( &block->ambient, Shader::globalAmbient(), sizeof(D3DCOLORVALUE) ) == 0 )
+    {
+        return false;
+    }
+
+    block->frameId = _frameParameters.frameId;
+    block->ambient = *Shader::globalAmbient();
+    setVector( effect, handles->ambientColor, (D3DXVECTOR4*)( &block->ambient ) );
+    Engine::statistics.effectFrameBlocks++;
+    return true;
+}
+
 /** 
  * system routine
  */
 
 void Effect::init(void)
 {
+    _frameParameters.frameId = 0;
+    D3DXMatrixIdentity( &_frameParameters.viewProj );
+
     _hlslConfig = getCore()->getParamPackFactory()->load( "./res/effects/hlsl.config" );
     assert( _hlslConfig );
 
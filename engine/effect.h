@@ -44,10 +44,77 @@ private:
     };
 protected:
     friend class Geometry;
+protected:
+    /**
+     * per-frame parameter block: the parameters which don't depend on rendered
+     * object are computed once per camera frame (see Camera::beginScene), and each
+     * effect uploads them once per frame; subsets bind per-object data only
+     */
+    struct FrameParameters
+    {
+    public:
+        unsigned int frameId;  // camera frame the block is computed for
+        Matrix       viewProj; // view & projection transformation
+    };
+protected:
+    static FrameParameters _frameParameters;
+protected:
+    /**
+     * parameters of lit surface effects (water, waterfall)
+     */
+    struct SurfaceHandles
+    {
+        D3DXHANDLE ambientColor;
+        D3DXHANDLE cameraPos;
+        D3DXHANDLE cameraDir;
+        D3DXHANDLE lightPos;
+        D3DXHANDLE lightColor;
+        D3DXHANDLE materialDiffuse;
+        D3DXHANDLE materialSpecular;
+        D3DXHANDLE materialPower;
+        D3DXHANDLE worldViewProj;
+        D3DXHANDLE baseTexture;
+        D3DXHANDLE normalMap;
+    };
+    /**
+     * state of frame block uploaded to HLSL-effect
+     */
+    struct FrameBlock
+    {
+    public:
+        unsigned int  frameId; // camera frame of uploaded block
+        D3DCOLORVALUE ambient; // ambient color of uploaded block
+    };
+protected:
+    static void resolveSurfaceHandles(ID3DXEffect* effect, SurfaceHandles* handles);
+    // uploads frame block if it is obsolete, returns true if block is uploaded
+    static bool uploadFrameBlock(ID3DXEffect* effect, const SurfaceHandles* handles, FrameBlock* block);
 protected:
     // support of cooperative work
     static void onLostDevice(void);
     static void onResetDevice(void);
+protected:
+    // parameter upload, counted by render statistics
+    static inline void setVector(ID3DXEffect* effect, D3DXHANDLE handle, const D3DXVECTOR4* value)
+    {
+        effect->SetVector( handle, value );
+        Engine::statistics.effectParameterSets++;
+    }
+    static inline void setMatrix(ID3DXEffect* effect, D3DXHANDLE handle, const D3DXMATRIX* value)
+    {
+        effect->SetMatrix( handle, value );
+        Engine::statistics.effectParameterSets++;
+    }
+    static inline void setFloat(ID3DXEffect* effect, D3DXHANDLE handle, float value)
+    {
+        effect->SetFloat( handle, value );
+        Engine::statistics.effectParameterSets++;
+    }
+    static inline void setTexture(ID3DXEffect* effect, D3DXHANDLE handle, LPDIRECT3DBASETEXTURE9 value)
+    {
+        effect->SetTexture( handle, value );
+        Engine::statistics.effectParameterSets++;
+    }
 protected:
     // Effect protected behaviour
     virtual int getBufferSize(void) = 0;
@@ -72,6 +139,8 @@ public:
     static const char* getEffectName(int effectId);
     static Effect* create(const char* effectName);    
     static void update(float dt);
+    // per-frame parameter block
+    static void beginFrame(void);
     // system routine
     static void init(void);
     static void term(void);
@@ -138,9 +207,20 @@ public:
 
 class FxWater : public Effect
 {
+private:
+    struct Handles : public SurfaceHandles
+    {
+        D3DXHANDLE environmentMap;
+        D3DXHANDLE reflectivity;
+        D3DXHANDLE uvOffset1;
+        D3DXHANDLE uvOffset2;
+    };
 private:
     static ID3DXEffect*    _effect;
     static StaticLostable* _effectLostable;
+    static Handles         _handles;           // parameter handles, resolved once
+    static FrameBlock      _frameBlock;        // uploaded per-frame block
+    static FxWater*        _uploadedArguments; // effect which arguments are uploaded
 private:
     struct Arguments
     {
@@ -166,6 +246,7 @@ public:
 public:
     // class implementation
     FxWater();
+    virtual ~FxWater();
     // IEffect implemetation
     virtual const char* __stdcall getName(void);
     virtual int __stdcall getNumArguments(void);
@@ -247,12 +328,19 @@ private:
         Flector uvOffset;
         Flector uvVelocity;
     };
+    struct Handles : public SurfaceHandles
+    {
+        D3DXHANDLE uvOffset;
+    };
 private:
     static ID3DXEffect*    _effect;
     static StaticLostable* _effectLostable;
     static Quartector      _lightPosition[WATERFALL_MAX_NUM_LIGHTS];
     static D3DCOLORVALUE   _lightDiffuseColor[WATERFALL_MAX_NUM_LIGHTS];
     static D3DCOLORVALUE   _lightSpecularColor[WATERFALL_MAX_NUM_LIGHTS];
+    static Handles         _handles;           // parameter handles, resolved once
+    static FrameBlock      _frameBlock;        // uploaded per-frame block
+    static FxWaterfall*    _uploadedArguments; // effect which arguments are uploaded
 private:
     Arguments _arguments;
 private:
@@ -269,6 +357,7 @@ public:
 public:
     // class implementation
     FxWaterfall();
+    virtual ~FxWaterfall();
     // IEffect implemetation
     virtual const char* __stdcall getName(void);
     virtual int __stdcall getNumArguments(void);
@@ -13,6 +13,8 @@
 #include "intersection.h"
 #include "sprite.h"
 #include "rain.h"
+#include "transient.h"
+#include "particlebudget.h"
 
 #include "fastquat.h"
 #include "../common/profiler.h"
@@ -107,6 +109,8 @@ Engine::~Engine()
     // release engine components
     CameraEffect::term();
     Mesh::term();
+    TransientBuffer::term();
+    ParticleBudget::term();
     Frame::term();
     // release general Direct3D interfaces
     if( iDirect3DDevice9 ) iDirect3DDevice9->Release();
@@ -291,6 +295,8 @@ void Engine::entityInit(Object * p)
     Frame::init();
     Effect::init();
     Mesh::init();
+    TransientBuffer::init();
+    ParticleBudget::init();
     CameraEffect::init();
 
     // load default textures
@@ -406,6 +412,8 @@ engine::ICamera* Engine::getDefaultCamera(void)
 void Engine::present(void)
 {
     _dxCR( iDirect3DDevice9->Present( NULL, NULL, NULL, NULL ) );
+    TransientBuffer::beginFrame();
+    ParticleBudget::beginFrame();
 }
 
 void Engine::setRenderState(engine::RenderState renderState, unsigned int value)
@@ -446,6 +454,19 @@ engine::IAsset* Engine::createAsset(engine::AssetType assetType, const char* res
     return NULL;
 }
 
+engine::IAsset* Engine::createAssetFromMemory(engine::AssetType assetType, const char* resourcePath, const void* data, unsigned int size)
+{
+    switch( assetType )
+    {
+    case engine::atXFile:
+        return new XAsset( resourcePath, data, size );
+    default:
+        // binary & import assets are streamed from resource, 
+        // so contents of file (that is read in advance) is in file cache at least
+        return createAsset( assetType, resourcePath );
+    }
+}
+
 engine::IRayIntersection* Engine::createRayIntersection(void)
 {
     return new RayIntersection;
@@ -465,6 +486,15 @@ engine::IFrame* Engine::findFrame(engine::IFrame* root, const char* frameName)
     return dynamic_cast<Frame*>( root )->findFrame( frameName );
 }
 
+void Engine::findFrames(engine::IFrame* root, unsigned int numFrames, const char** frameNames, engine::IFrame** frames)
+{
+    Frame* rootFrame = dynamic_cast<Frame*>( root ); assert( rootFrame );
+    for( unsigned int i=0; i<numFrames; i++ )
+    {
+        frames[i] = rootFrame->findFrame( frameNames[i] );
+    }
+}
+
 engine::IAtomic* Engine::getAtomic(engine::IClump* clump, engine::IFrame* frame)
 {
     return dynamic_cast<Clump*>( clump )->getAtomic( dynamic_cast<Frame*>( frame ) );
@@ -814,37 +844,11 @@ static const Vector billboardVertices[4] =
 
 void Engine::renderTestRect(const Matrix4f& matrix, const Vector4f& color)
 {
-
-    IDirect3DVertexBuffer9* vertexBuffer;
-    IDirect3DIndexBuffer9*  indexBuffer;
-
-    _dxCR( iDirect3DDevice->CreateIndexBuffer(
-        sizeof(WORD) * 6,
-        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC,
-        D3DFMT_INDEX16,
-        D3DPOOL_DEFAULT, 
-        &indexBuffer,
-        NULL
-    ) );
-
-    _dxCR( iDirect3DDevice->CreateVertexBuffer(
-        sizeof(ParticleVertex) * 4,
-        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC,
-        particleFVF,
-        D3DPOOL_DEFAULT,
-        &vertexBuffer,
-        NULL
-    ) );
-
-    // lock buffers
-    void* vertexData = NULL;
-    void* indexData = NULL;
-    _dxCR( vertexBuffer->Lock( 0, 4 * sizeof( ParticleVertex ), &vertexData, D3DLOCK_DISCARD ) );
-    _dxCR( indexBuffer->Lock( 0, 6 * sizeof( WORD ), &indexData, D3DLOCK_DISCARD ) );
-    assert( vertexData );
-    assert( indexData );
-    ParticleVertex* vertex = (ParticleVertex*)( vertexData );
-    WORD* index = (WORD*)( indexData );
+    // allocate transient geometry
+    unsigned int baseVertex;
+    unsigned int baseIndex;
+    ParticleVertex* vertex = (ParticleVertex*)( TransientBuffer::lockVertices( sizeof( ParticleVertex ), 4, &baseVertex ) );
+    WORD* index = TransientBuffer::lockIndices( 6, &baseIndex );
 
     Matrix m = wrap( matrix );
     m._41 = m._42 = m._43 = 0.0f, m._44 = 1.0f;
@@ -882,8 +886,8 @@ void Engine::renderTestRect(const Matrix4f& matrix, const Vector4f& color)
     index[5] = 3;
 
     // unlock buffers
-    vertexBuffer->Unlock();
-    indexBuffer->Unlock();
+    TransientBuffer::unlockVertices( 4 );
+    TransientBuffer::unlockIndices( 6 );
 
     // render
     _dxCR( dxSetRenderState( D3DRS_LIGHTING, FALSE ) );    
@@ -895,14 +899,10 @@ void Engine::renderTestRect(const Matrix4f& matrix, const Vector4f& color)
 
     _dxCR( iDirect3DDevice->SetTransform( D3DTS_WORLD, &identity ) );
     _dxCR( iDirect3DDevice->SetFVF( particleFVF ) );
-    _dxCR( iDirect3DDevice->SetStreamSource( 0, vertexBuffer, 0, sizeof( ParticleVertex ) ) );
-    _dxCR( iDirect3DDevice->SetIndices( indexBuffer ) );
-    _dxCR( iDirect3DDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, 0, 0, 4, 0, 2 ) );
+    TransientBuffer::setStreams( sizeof( ParticleVertex ) );
+    _dxCR( iDirect3DDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, baseVertex, 0, 4, baseIndex, 2 ) );
 
     _dxCR( dxSetRenderState( D3DRS_LIGHTING, TRUE ) ); 
-
-    _dxCR( indexBuffer->Release() );
-    _dxCR( vertexBuffer->Release() );
 }
 
 engine::DeviceState Engine::handleCooperativeLevel(void)
@@ -135,6 +135,7 @@ public:
     virtual engine::ITexture* __stdcall createRenderTarget(int width, int height, int depth, const char* textureName);
     virtual engine::ITexture* __stdcall createCubeRenderTarget(int size, int depth, const char* textureName);
     virtual engine::ITexture* __stdcall createTexture(const char* resourcePath);
+    virtual engine::ITexture* __stdcall createTextureFromMemory(const char* resourcePath, const void* data, unsigned int size);
     virtual engine::ITexture* __stdcall createDUDVFromNormalMap(engine::ITexture* normalMap, const char* dudvName);
     virtual engine::IShader* __stdcall createShader(int numLayers, const char* shaderName);
     virtual engine::IFrame* __stdcall createFrame(const char* frameName);
@@ -148,6 +149,7 @@ public:
     virtual engine::IBSP* __stdcall createBSP(const char* bspName, const Vector3f& boxInf, const Vector3f& boxSup);
     virtual engine::IEffect* __stdcall createEffect(const char* effectName);
     virtual engine::IAsset* __stdcall createAsset(engine::AssetType assetType, const char* resourcePath);
+    virtual engine::IAsset* __stdcall createAssetFromMemory(engine::AssetType assetType, const char* resourcePath, const void* data, unsigned int size);
     virtual engine::ILoader* __stdcall createLoader(engine::AssetType assetType, const char* resourcePath);
     virtual engine::IParticleSystem* __stdcall createParticleSystem(unsigned int numParticles, engine::IShader* shader, float alphaSortDepth);
     virtual engine::IRendering* __stdcall createGrass(const char* resourcePath, engine::IAtomic* templateAtomic, engine::ITexture* texture, engine::GrassScheme* grassScheme, float fadeStart, float fadeEnd);
@@ -163,6 +165,8 @@ public:
     );    
     virtual void __stdcall endEnvironmentMap(void);
     virtual engine::IFrame* __stdcall findFrame(engine::IFrame* root, const char* frameName);
+    virtual void __stdcall findFrames(engine::IFrame* root, unsigned int numFrames, const char** frameNames, engine::IFrame** frames);
+    virtual void __stdcall synchronizeFrames(unsigned int numFrames, engine::IFrame** frames, const Matrix4f** conversions, const Matrix4f* poses);
     virtual engine::IAtomic* __stdcall getAtomic(engine::IClump* clump, engine::IFrame* frame);
     virtual engine::Mesh* __stdcall createMesh(unsigned int numVertices, unsigned int numTriangles, unsigned int numUVs);
     virtual void __stdcall releaseMesh(engine::Mesh* mesh);
@@ -3,6 +3,7 @@
 #include "texture.h"
 #include "../common/istring.h"
 #include "camera.h"
+#include "effect.h"
 
 /**
  * environment map rendering routine
@@ -72,6 +73,9 @@ void Engine::beginEnvironmentMap(
     Camera::eyeDirection = dxAt( &m );
     Camera::fov          = 90.0f;
 
+    // per-frame parameters of effects (cube face is a separate camera frame)
+    Effect::beginFrame();
+
     // frustrum planes
     Vector r_origin( m._41, m._42, m._43 );
     Vector vpn( m._31, m._32, m._33 );
@@ -149,4 +153,7 @@ void Engine::endEnvironmentMap(void)
     _renderToSurface->Release();
     _renderToSurface = NULL;
     _envMap = NULL;
+
+    // frame block of cube face is obsolete
+    Effect::beginFrame();
 }
\ No newline at end of file
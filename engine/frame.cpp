@@ -3,6 +3,7 @@
 #include "frame.h"
 #include "atomic.h"
 #include "asset.h"
+#include <xmmintrin.h>
 
 /**
  * creation routine
@@ -13,6 +14,11 @@ engine::IFrame* Engine::createFrame(const char* frameName)
     return new Frame( frameName );
 }
 
+void Engine::synchronizeFrames(unsigned int numFrames, engine::IFrame** frames, const Matrix4f** conversions, const Matrix4f* poses)
+{
+    Frame::setMatrices( numFrames, frames, conversions, poses );
+}
+
 /**
  * class implementation
  */
@@ -32,6 +38,9 @@ Frame::Frame(const char* frameName)
     _dirty = false;
     pFrameFirstChild = pFrameSibling = NULL;
     pMeshContainer = NULL;
+    _revision = 0;
+    _indexRevision = 0;
+    _index = NULL;
 }
 
 Frame::~Frame()
@@ -39,6 +48,7 @@ Frame::~Frame()
     if( isDirty() ) synchronizeSafe();
     setParent( NULL );   
     while( pFrameFirstChild ) delete static_cast<Frame*>( pFrameFirstChild );
+    if( _index ) delete _index;
     delete[] Name;
 }
 
@@ -149,6 +159,7 @@ void Frame::setParent(engine::IFrame* frame)
     // destroy previous relationship
     if( pParentFrame )
     {
+        pParentFrame->touch();
         Frame* prevSibling = NULL;
         Frame* child = static_cast<Frame*>( pParentFrame->pFrameFirstChild );
         while( child )
@@ -174,6 +185,7 @@ void Frame::setParent(engine::IFrame* frame)
     {
         pFrameSibling = pParentFrame->pFrameFirstChild;
         pParentFrame->pFrameFirstChild = this;        
+        pParentFrame->touch();
     }
 }
 
@@ -197,6 +209,53 @@ Frame* Frame::getRoot(void)
     return pParentFrame->getRoot();
 }
 
+void Frame::setName(const char* frameName)
+{
+    if( !frameName ) frameName = "";
+    delete[] Name;
+    Name = new char[ strlen(frameName) + 1 ];
+    strcpy( Name, frameName );
+
+    // name indices of ancestors are obsolete
+    touch();
+}
+
+void Frame::touch(void)
+{
+    // subtree of each ancestor is changed too
+    Frame* f = this;
+    while( f ) f->_revision++, f = f->pParentFrame;
+}
+
+void Frame::indexFrame(FrameNameM* index, Frame* frame)
+{
+    // pre-order traversal, the first frame with given name wins (same as D3DXFrameFind)
+    if( frame->Name ) index->insert( FrameNameT( frame->Name, frame ) );
+    Frame* child = static_cast<Frame*>( frame->pFrameFirstChild );
+    while( child )
+    {
+        indexFrame( index, child );
+        child = static_cast<Frame*>( child->pFrameSibling );
+    }
+}
+
+void Frame::buildIndex(void)
+{
+    if( _index ) _index->clear(); else _index = new FrameNameM;
+    indexFrame( _index, this );
+    _indexRevision = _revision;
+}
+
+Frame* Frame::findFrame(const char* frameName)
+{
+    // D3DXFrameFind also searches the following siblings of frame, those aren't indexed
+    if( pFrameSibling || !frameName ) return static_cast<Frame*>( D3DXFrameFind( this, frameName ) );
+
+    if( !_index || _indexRevision != _revision ) buildIndex();
+    FrameNameI frameI = _index->find( frameName );
+    return ( frameI != _index->end() ) ? frameI->second : NULL;
+}
+
 void Frame::dirty(void)
 {
     if( !_dirty )
@@ -277,6 +336,54 @@ void Frame::synchronizeAll(void)
     _numDirtyFrames = 0;
 }
 
+void Frame::setMatrices(unsigned int numFrames, engine::IFrame** frames, const Matrix4f** conversions, const Matrix4f* poses)
+{
+    // if dirty list has room for all frames, dirtiness is flagged without overflow checks
+    bool hasRoom = ( _numDirtyFrames + numFrames <= engine::maxDirtyFrames );
+
+    Frame*       frame;
+    const float* c;
+    const float* p;
+    __m128       p0, p1, p2, p3;
+    for( unsigned int i=0; i<numFrames; i++ )
+    {
+        frame = dynamic_cast<Frame*>( frames[i] ); assert( frame );
+        c = conversions[i]->getPtr();
+        p = poses[i].getPtr();
+
+        // row of result is the combination of pose rows, weighted by row of conversion
+        p0 = _mm_loadu_ps( p );
+        p1 = _mm_loadu_ps( p + 4 );
+        p2 = _mm_loadu_ps( p + 8 );
+        p3 = _mm_loadu_ps( p + 12 );
+        for( unsigned int row=0; row<4; row++, c+=4 )
+        {
+            _mm_storeu_ps( 
+                frame->TransformationMatrix.m[row], 
+                _mm_add_ps(
+                    _mm_add_ps( _mm_mul_ps( _mm_set1_ps( c[0] ), p0 ), _mm_mul_ps( _mm_set1_ps( c[1] ), p1 ) ),
+                    _mm_add_ps( _mm_mul_ps( _mm_set1_ps( c[2] ), p2 ), _mm_mul_ps( _mm_set1_ps( c[3] ), p3 ) )
+                )
+            );
+        }
+        // conversions & physics poses are affine, so the 4th column is forced
+        // (unlike setMatrix(), which copies all 16 values) to drop rounding errors
+        frame->TransformationMatrix._14 = frame->TransformationMatrix._24 = frame->TransformationMatrix._34 = 0.0f;
+        frame->TransformationMatrix._44 = 1.0f;
+
+        if( !hasRoom ) 
+        {
+            frame->dirty();
+        }
+        else if( !frame->_dirty )
+        {
+            frame->_dirty = true;
+            _dirtyFrames[_numDirtyFrames] = frame;
+            _numDirtyFrames++;
+        }
+    }
+}
+
 void Frame::init(void)
 {
     _dirtyFrames = new Frame*[engine::maxDirtyFrames];
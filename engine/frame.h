@@ -37,6 +37,10 @@ protected:
 struct Frame : public D3DXFRAME,
                virtual public engine::IFrame
 {
+private:
+    typedef std::pair<std::string,Frame*> FrameNameT;
+    typedef std::unordered_map<std::string,Frame*> FrameNameM;
+    typedef FrameNameM::iterator FrameNameI;
 private:
     struct Chunk
     {
@@ -53,6 +57,14 @@ private:
     bool                _dirty;
     static unsigned int _numDirtyFrames;
     static Frame**      _dirtyFrames;
+private:
+    unsigned int        _revision;      // changed with any relationship change in subtree
+    unsigned int        _indexRevision; // revision of subtree, name index is built for
+    FrameNameM*         _index;         // name index of subtree (built by first search)
+private:
+    void touch(void);
+    void buildIndex(void);
+    static void indexFrame(FrameNameM* index, Frame* frame);
 public:
     void synchronizeSafe(void);
     void synchronizeFast(void);
@@ -92,15 +104,17 @@ public:
         return _dirty ? true : ( pParentFrame ? pParentFrame->isDirtyHierarchy() : false );
     }*/
     inline bool isDirty(void) { return _dirty; }
-    inline Frame* findFrame(const char* frameName) { return static_cast<Frame*>( D3DXFrameFind( this, frameName ) ); }
 public:
     // module locals
+    Frame* findFrame(const char* frameName);
     Frame* getRoot(void);    
+    void setName(const char* frameName);
     void dirty(void);
     void write(IResource* resource);
     static AssetObjectT read(IResource* resource, AssetObjectM& assetObjects);
 public:
     static void synchronizeAll(void);
+    static void setMatrices(unsigned int numFrames, engine::IFrame** frames, const Matrix4f** conversions, const Matrix4f* poses);
     static void init(void);
     static void term(void);
 };
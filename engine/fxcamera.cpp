@@ -3,6 +3,7 @@
 #include "camera.h"
 #include "wire.h"
 #include "sprite.h"
+#include "effect.h"
 #include "../common/istring.h"
 
 ID3DXEffect*    CameraEffect::_pEffect         = NULL;
@@ -153,6 +154,9 @@ void CameraEffect::beginScene(unsigned int clearMode, const Vector4f& clearColor
 
     // frustrum planes
     updateFrustrum();   
+
+    // per-frame parameters of effects
+    Effect::beginFrame();
 }
 
 void CameraEffect::endScene(void)
@@ -8,8 +8,11 @@
 #include "geometry.h"
 #include "vertexdeclaration.h"
 
-ID3DXEffect*    FxWater::_effect = NULL;
-StaticLostable* FxWater::_effectLostable = NULL;
+ID3DXEffect*     FxWater::_effect = NULL;
+StaticLostable*  FxWater::_effectLostable = NULL;
+FxWater::Handles FxWater::_handles;
+FxWater::FrameBlock FxWater::_frameBlock = { 0 };
+FxWater*         FxWater::_uploadedArguments = NULL;
 const char* FxWater::effectName = "Water";
 
 /**
@@ -20,6 +23,7 @@ void FxWater::onUpdate(float dt)
 {
     _arguments.uvOffset1 += _arguments.uvVelocity1 * dt;
     _arguments.uvOffset2 += _arguments.uvVelocity2 * dt;
+    if( _uploadedArguments == this ) _uploadedArguments = NULL;
 }
 
 /**
@@ -36,9 +40,21 @@ void FxWater::render(Mesh* mesh, int subsetId, Shader* shader)
 
     shader->apply();
 
-    // ambient lighting
-    _effect->SetVector( "ambientColor", (D3DXVECTOR4*)( Shader::globalAmbient() ) );
+    // per-frame parameter block
+    if( uploadFrameBlock( _effect, &_handles, &_frameBlock ) ) _uploadedArguments = NULL;
 
+    // arguments are animated once per frame, and shared by all subsets of effect
+    if( _uploadedArguments != this )
+    {
+        _uploadedArguments = this;
+        Quartector uvOffset1( _arguments.uvOffset1.x, _arguments.uvOffset1.y, 0, 0 );
+        Quartector uvOffset2( _arguments.uvOffset2.x, _arguments.uvOffset2.y, 0, 0 );
+        setFloat( _effect, _handles.reflectivity, _arguments.reflectivity );
+        setVector( _effect, _handles.uvOffset1, &uvOffset1 );
+        setVector( _effect, _handles.uvOffset2, &uvOffset2 );
+    }
+
+    // per-object data
     Matrix world;
     _dxCR( iDirect3DDevice->GetTransform( D3DTS_WORLD, &world ) );
     Matrix iWorld;
@@ -51,8 +67,8 @@ void FxWater::render(Mesh* mesh, int subsetId, Shader* shader)
     D3DXVec3TransformNormal( &cameraDir, &Camera::eyeDirection, &iWorld );
     Quartector cameraPosQ( cameraPos.x, cameraPos.y, cameraPos.z, 1.0f );
     Quartector cameraDirQ( cameraDir.x, cameraDir.y, cameraDir.z, 0.0f );
-    _effect->SetVector( "cameraPos", &cameraPosQ );
-    _effect->SetVector( "cameraDir", &cameraDirQ );
+    setVector( _effect, _handles.cameraPos, &cameraPosQ );
+    setVector( _effect, _handles.cameraDir, &cameraDirQ );
 
     // dynamic lighting (transformed in object space)
     D3DLIGHT9     lightProperties;
@@ -81,8 +97,8 @@ void FxWater::render(Mesh* mesh, int subsetId, Shader* shader)
             lightPos.w = 1.0f;
             lightColor = lightProperties.Diffuse;
             // setup effect
-            _effect->SetVector( "lightPos", (D3DXVECTOR4*)&lightPos );
-            _effect->SetVector( "lightColor", (D3DXVECTOR4*)&lightColor );
+            setVector( _effect, _handles.lightPos, (D3DXVECTOR4*)&lightPos );
+            setVector( _effect, _handles.lightColor, (D3DXVECTOR4*)&lightColor );
             break;
         }
     }
@@ -90,37 +106,23 @@ void FxWater::render(Mesh* mesh, int subsetId, Shader* shader)
     // material color properties
     D3DMATERIAL9 material;
     iDirect3DDevice->GetMaterial( &material );
-    _effect->SetVector( "materialDiffuse", (D3DXVECTOR4*)&material.Diffuse );
-    _effect->SetVector( "materialSpecular", (D3DXVECTOR4*)&material.Specular );
-    _effect->SetFloat( "materialPower", material.Power );
-
-    // world matrix
-    // _effect->SetMatrix( "world", &world );
-
-    // inversion of world matrix
-    // _effect->SetMatrix( "iWorld", &iWorld );
+    setVector( _effect, _handles.materialDiffuse, (D3DXVECTOR4*)&material.Diffuse );
+    setVector( _effect, _handles.materialSpecular, (D3DXVECTOR4*)&material.Specular );
+    setFloat( _effect, _handles.materialPower, material.Power );
 
     // WVP matrix
     Matrix worldViewProj;
-    D3DXMatrixMultiply( &worldViewProj, &world, &Camera::viewMatrix );
-    D3DXMatrixMultiply( &worldViewProj, &worldViewProj, &Camera::projectionMatrix );
-    _effect->SetMatrix( "worldViewProj", &worldViewProj );
+    D3DXMatrixMultiply( &worldViewProj, &world, &_frameParameters.viewProj );
+    setMatrix( _effect, _handles.worldViewProj, &worldViewProj );
 
     // base texture
-    _effect->SetTexture( "baseTexture", shader->layerTexture( 0 )->iDirect3DTexture() );
+    setTexture( _effect, _handles.baseTexture, shader->layerTexture( 0 )->iDirect3DTexture() );
 
     // normal maps
-    _effect->SetTexture( "normalMap", shader->normalMap()->iDirect3DTexture() );
+    setTexture( _effect, _handles.normalMap, shader->normalMap()->iDirect3DTexture() );
 
     // environment map
-    _effect->SetTexture( "environmentMap", shader->environmentMap()->iDirect3DCubeTexture() );    
-    
-    // arguments
-    Quartector uvOffset1( _arguments.uvOffset1.x, _arguments.uvOffset1.y, 0, 0 );
-    Quartector uvOffset2( _arguments.uvOffset2.x, _arguments.uvOffset2.y, 0, 0 );
-    _effect->SetFloat( "Reflectivity", _arguments.reflectivity );
-    _effect->SetVector( "UvOffset1", &uvOffset1 );
-    _effect->SetVector( "UvOffset2", &uvOffset2 );
+    setTexture( _effect, _handles.environmentMap, shader->environmentMap()->iDirect3DCubeTexture() );    
 
     // render
     unsigned int numPasses;
@@ -133,9 +135,9 @@ void FxWater::render(Mesh* mesh, int subsetId, Shader* shader)
     }
     _effect->End();
 
-    _effect->SetTexture( "baseTexture", NULL );
-    _effect->SetTexture( "normalMap", NULL );
-    _effect->SetTexture( "environmentMap", NULL );
+    _effect->SetTexture( _handles.baseTexture, NULL );
+    _effect->SetTexture( _handles.normalMap, NULL );
+    _effect->SetTexture( _handles.environmentMap, NULL );
 
     iDirect3DDevice->SetVertexShader(NULL);
     iDirect3DDevice->SetPixelShader(NULL);
@@ -168,6 +170,16 @@ FxWater::FxWater()
         }
 
         _effectLostable = new StaticLostable( onLostDevice, onResetDevice );
+
+        // resolve parameter handles
+        if( _effect )
+        {
+            resolveSurfaceHandles( _effect, &_handles );
+            _handles.environmentMap   = _effect->GetParameterByName( NULL, "environmentMap" );
+            _handles.reflectivity     = _effect->GetParameterByName( NULL, "Reflectivity" );
+            _handles.uvOffset1        = _effect->GetParameterByName( NULL, "UvOffset1" );
+            _handles.uvOffset2        = _effect->GetParameterByName( NULL, "UvOffset2" );
+        }
     }
 
     _arguments.reflectivity = 0.5f;
@@ -179,6 +191,11 @@ FxWater::FxWater()
     _animatedEffects.push_back( this );
 }
 
+FxWater::~FxWater()
+{
+    if( _uploadedArguments == this ) _uploadedArguments = NULL;
+}
+
 /**
  * IEffect implemetation
  */
@@ -224,6 +241,7 @@ Variant FxWater::getArgument(int argId)
 void FxWater::setArgument(int argId, const Variant& value)
 {
     assert( argId>=0 && argId<getNumArguments() );
+    if( _uploadedArguments == this ) _uploadedArguments = NULL;
     switch( argId )
     {
     case 0: 
@@ -266,4 +284,6 @@ void FxWater::onLostDevice(void)
 void FxWater::onResetDevice(void)
 {
     if( _effect ) _effect->OnResetDevice();
+    _frameBlock.frameId = 0;
+    _uploadedArguments = NULL;
 }
\ No newline at end of file
@@ -13,6 +13,9 @@ StaticLostable* FxWaterfall::_effectLostable = NULL;
 Quartector      FxWaterfall::_lightPosition[WATERFALL_MAX_NUM_LIGHTS];
 D3DCOLORVALUE   FxWaterfall::_lightDiffuseColor[WATERFALL_MAX_NUM_LIGHTS];
 D3DCOLORVALUE   FxWaterfall::_lightSpecularColor[WATERFALL_MAX_NUM_LIGHTS];
+FxWaterfall::Handles FxWaterfall::_handles;
+FxWaterfall::FrameBlock FxWaterfall::_frameBlock = { 0 };
+FxWaterfall*    FxWaterfall::_uploadedArguments = NULL;
 const char*     FxWaterfall::effectName = "Waterfall";
 
 /**
@@ -22,6 +25,7 @@ const char*     FxWaterfall::effectName = "Waterfall";
 void FxWaterfall::onUpdate(float dt)
 {
     _arguments.uvOffset += _arguments.uvVelocity * dt;
+    if( _uploadedArguments == this ) _uploadedArguments = NULL;
 }
 
 /**
@@ -31,14 +35,19 @@ void FxWaterfall::onUpdate(float dt)
 void FxWaterfall::render(Mesh* mesh, int subsetId, Shader* shader)
 {    
     shader->apply();
-    
-    // setup effect arguments
-    Quartector uvOffset( _arguments.uvOffset.x, _arguments.uvOffset.y, 0, 0 );
-    _effect->SetVector( "UvOffset", &uvOffset );
 
-    // ambient lighting
-    _effect->SetVector( "ambientColor", (D3DXVECTOR4*)( Shader::globalAmbient() ) );
+    // per-frame parameter block
+    if( uploadFrameBlock( _effect, &_handles, &_frameBlock ) ) _uploadedArguments = NULL;
 
+    // arguments are animated once per frame, and shared by all subsets of effect
+    if( _uploadedArguments != this )
+    {
+        _uploadedArguments = this;
+        Quartector uvOffset( _arguments.uvOffset.x, _arguments.uvOffset.y, 0, 0 );
+        setVector( _effect, _handles.uvOffset, &uvOffset );
+    }
+
+    // per-object data
     Matrix world;
     _dxCR( iDirect3DDevice->GetTransform( D3DTS_WORLD, &world ) );
     Matrix iWorld;
@@ -51,8 +60,8 @@ void FxWaterfall::render(Mesh* mesh, int subsetId, Shader* shader)
     D3DXVec3TransformNormal( &cameraDir, &Camera::eyeDirection, &iWorld );
     Quartector cameraPosQ( cameraPos.x, cameraPos.y, cameraPos.z, 1.0f );
     Quartector cameraDirQ( cameraDir.x, cameraDir.y, cameraDir.z, 0.0f );
-    _effect->SetVector( "cameraPos", &cameraPosQ );
-    _effect->SetVector( "cameraDir", &cameraDirQ );
+    setVector( _effect, _handles.cameraPos, &cameraPosQ );
+    setVector( _effect, _handles.cameraDir, &cameraDirQ );
 
     // dynamic lighting (transformed in object space)
     D3DLIGHT9     lightProperties;
@@ -88,31 +97,30 @@ void FxWaterfall::render(Mesh* mesh, int subsetId, Shader* shader)
 
     if( numLights )
     {
-        _effect->SetVector( "lightPos", lightPos );
-        _effect->SetVector( "lightColor", (D3DXVECTOR4*)lightColor );
+        setVector( _effect, _handles.lightPos, lightPos );
+        setVector( _effect, _handles.lightColor, (D3DXVECTOR4*)lightColor );
     }        
 
     // material color properties
     D3DMATERIAL9 material;
     iDirect3DDevice->GetMaterial( &material );
-    _effect->SetVector( "materialDiffuse", (D3DXVECTOR4*)&material.Diffuse );
-    _effect->SetVector( "materialSpecular", (D3DXVECTOR4*)&material.Specular );
-    _effect->SetFloat( "materialPower", material.Power );
+    setVector( _effect, _handles.materialDiffuse, (D3DXVECTOR4*)&material.Diffuse );
+    setVector( _effect, _handles.materialSpecular, (D3DXVECTOR4*)&material.Specular );
+    setFloat( _effect, _handles.materialPower, material.Power );
 
     // world matrix
     // _effect->SetMatrix( "world", &world );                   
 
     // WVP matrix
     Matrix worldViewProj;
-    D3DXMatrixMultiply( &worldViewProj, &world, &Camera::viewMatrix );
-    D3DXMatrixMultiply( &worldViewProj, &worldViewProj, &Camera::projectionMatrix );
-    _effect->SetMatrix( "worldViewProj", &worldViewProj );
+    D3DXMatrixMultiply( &worldViewProj, &world, &_frameParameters.viewProj );
+    setMatrix( _effect, _handles.worldViewProj, &worldViewProj );
 
     // base texture
-    _effect->SetTexture( "baseTexture", shader->layerTexture( 0 )->iDirect3DTexture() );    
+    setTexture( _effect, _handles.baseTexture, shader->layerTexture( 0 )->iDirect3DTexture() );    
 
     // normal map 
-    _effect->SetTexture( "normalMap", shader->normalMap()->iDirect3DTexture() );
+    setTexture( _effect, _handles.normalMap, shader->normalMap()->iDirect3DTexture() );
 
     // environment map
     // _effect->SetTexture( "environmentMap", shader->environmentMap()->iDirect3DCubeTexture() );
@@ -128,8 +136,8 @@ void FxWaterfall::render(Mesh* mesh, int subsetId, Shader* shader)
     }
     _effect->End();
 
-    _effect->SetTexture( "baseTexture", NULL );
-    _effect->SetTexture( "normalMap", NULL );
+    _effect->SetTexture( _handles.baseTexture, NULL );
+    _effect->SetTexture( _handles.normalMap, NULL );
     // _effect->SetTexture( "environmentMap", NULL );
 
     iDirect3DDevice->SetVertexShader(NULL);
@@ -163,6 +171,13 @@ FxWaterfall::FxWaterfall()
         }
 
         _effectLostable = new StaticLostable( onLostDevice, onResetDevice );
+
+        // resolve parameter handles
+        if( _effect )
+        {
+            resolveSurfaceHandles( _effect, &_handles );
+            _handles.uvOffset         = _effect->GetParameterByName( NULL, "UvOffset" );
+        }
     }
 
     _arguments.uvOffset.x = 0, _arguments.uvOffset.y = 0;
@@ -171,6 +186,11 @@ FxWaterfall::FxWaterfall()
     _animatedEffects.push_back( this );
 }
 
+FxWaterfall::~FxWaterfall()
+{
+    if( _uploadedArguments == this ) _uploadedArguments = NULL;
+}
+
 /**
  * IEffect implemetation
  */
@@ -212,6 +232,7 @@ Variant FxWaterfall::getArgument(int argId)
 void FxWaterfall::setArgument(int argId, const Variant& value)
 {
     assert( argId>=0 && argId<getNumArguments() );
+    if( _uploadedArguments == this ) _uploadedArguments = NULL;
     switch( argId )
     {
     case 0: 
@@ -248,4 +269,6 @@ void FxWaterfall::onLostDevice(void)
 void FxWaterfall::onResetDevice(void)
 {
     if( _effect ) _effect->OnResetDevice();
+    _frameBlock.frameId = 0;
+    _uploadedArguments = NULL;
 }
\ No newline at end of file
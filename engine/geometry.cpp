@@ -55,6 +55,10 @@ Geometry::Geometry(
     for( i=0; i<engine::maxPrelightLayers; i++ ) if( i<_numPrelights ) _prelights[i] = new Color[_numVertices]; else _prelights[i] = NULL;
     for( i=0; i<engine::maxTextureLayers; i++ ) if( i<_numUVSets ) _uvs[i] = new Flector[_numVertices]; else _uvs[i] = NULL; 
     _triangles = new Triangle[_numTriangles];
+    _tangents  = NULL;
+    _binormals = NULL;
+    _tangentUVSet = -1;
+    _optimized = false;
     _skinnedVertices = NULL; // no skinned vertices for non-skinned mesh
     if( !_sharedShaders ) 
     {
@@ -86,6 +90,10 @@ Geometry::Geometry(
     _vertices      = NULL;
     _normals       = NULL;
     _triangles     = NULL;
+    _tangents      = NULL;
+    _binormals     = NULL;
+    _tangentUVSet  = -1;
+    _optimized     = false;
 	int i;
     for( i=0; i<engine::maxPrelightLayers; i++ ) _prelights[i] = NULL;    
     for( i=0; i<engine::maxTextureLayers; i++ ) _uvs[i] = NULL;
@@ -119,6 +127,7 @@ Geometry::~Geometry()
         delete[] _skinnedVertices;
     }
     delete[] _triangles;
+    discardPreparedData();
 	int i;
     for( i=0; i<engine::maxTextureLayers; i++ ) if( _uvs[i] ) delete[] _uvs[i];
     for( i=0; i<engine::maxPrelightLayers; i++ ) if( _prelights[i] ) delete[] _prelights[i];
@@ -258,6 +267,9 @@ void Geometry::setMesh(engine::Mesh* mesh)
         _normals[mesh->triangles[i].vertexId[2]] = n;
     }
 
+    // prepared data doesn't match the new mesh
+    discardPreparedData();
+
     instance();
 }
 #pragma warning(default:4018)
@@ -451,26 +463,33 @@ void Geometry::setShader(int id, Shader* shader)
     if( _shaders[id] ) _shaders[id]->_numReferences++;
 }
 
-void Geometry::instance(void)
+void Geometry::discardPreparedData(void)
 {
-    // release previous mesh instance
-    if( _mesh ) delete _mesh;
+    if( _tangents ) delete[] _tangents;
+    if( _binormals ) delete[] _binormals;
+    _tangents     = NULL;
+    _binormals    = NULL;
+    _tangentUVSet = -1;
+    _optimized    = false;
+}
 
-    // recalculate bounding box
-    _boundingBox.calculate( _numVertices, _vertices );
-    _boundingSphere.calculate( _numVertices, _vertices );
+void Geometry::instancePrepared(D3DVERTEXELEMENT9* vertexDeclaration, bool useTangents)
+{
+    assert( _optimized );
+    assert( !useTangents || ( _tangents && _binormals ) );
 
+    // mesh data is final, so it goes directly to managed buffers,
+    // without cloning, tangent calculation and optimization
     _mesh = new Mesh( 
         _numVertices, 
         _numTriangles, 
         _numShaders,
-        D3DXMESH_VB_DYNAMIC | D3DXMESH_IB_DYNAMIC,
-        _vertexDeclaration
+        D3DXMESH_VB_MANAGED | D3DXMESH_IB_MANAGED,
+        vertexDeclaration
     );
 
-    // vertex buffer
-    unsigned char* vertexData = (unsigned char*)( _mesh->lockVertexBuffer( D3DLOCK_DISCARD ) );
-    // fill vertex buffer
+    // fill vertex buffer, tangents are placed after UV-sets (see vertexdeclaration.h)
+    unsigned char* vertexData = (unsigned char*)( _mesh->lockVertexBuffer( 0 ) );
     int i, j, offset = 0;
     for( i=0; i<_numVertices; i++ )
     {
@@ -484,11 +503,16 @@ void Geometry::instance(void)
         {
             memcpy( vertexData+offset, _prelights[j]+i, sizeof(Color) ); offset += sizeof(Color);
         }
+        if( useTangents )
+        {
+            memcpy( vertexData+offset, _tangents+i, sizeof(Vector) ); offset += sizeof(Vector);
+            memcpy( vertexData+offset, _binormals+i, sizeof(Vector) ); offset += sizeof(Vector);
+        }
     }
     _mesh->unlockVertexBuffer();
 
     // fill index buffer
-    unsigned char* indexData = (unsigned char*)( _mesh->lockIndexBuffer( D3DLOCK_DISCARD ) );
+    unsigned char* indexData = (unsigned char*)( _mesh->lockIndexBuffer( 0 ) );
     offset = 0;
     for( i=0; i<_numTriangles; i++ )
     {
@@ -497,13 +521,55 @@ void Geometry::instance(void)
     }
     _mesh->unlockIndexBuffer();
 
-    DWORD* attrBuffer = (DWORD*)( _mesh->lockAttributeBuffer( D3DLOCK_DISCARD ) );
+    DWORD* attrBuffer = (DWORD*)( _mesh->lockAttributeBuffer( 0 ) );
     for( i=0; i<_numTriangles; i++ ) 
     {
         attrBuffer[i] = _triangles[i].shaderId;
     }
     _mesh->unlockAttributeBuffer();
 
+    // triangles are sorted by shaders, so attribute table is built by single pass
+    std::vector<D3DXATTRIBUTERANGE> attributeTable;
+    DWORD vertexEnd = 0;
+    for( i=0; i<_numTriangles; i++ )
+    {
+        if( attributeTable.empty() || attributeTable.back().AttribId != _triangles[i].shaderId )
+        {
+            if( attributeTable.size() ) attributeTable.back().VertexCount = vertexEnd - attributeTable.back().VertexStart;
+            D3DXATTRIBUTERANGE range;
+            range.AttribId    = _triangles[i].shaderId;
+            range.FaceStart   = i;
+            range.FaceCount   = 0;
+            range.VertexStart = _numVertices;
+            range.VertexCount = 0;
+            attributeTable.push_back( range );
+            vertexEnd = 0;
+        }
+        D3DXATTRIBUTERANGE* range = &attributeTable.back();
+        assert( attributeTable.size() == 1 || range->AttribId > attributeTable[attributeTable.size()-2].AttribId );
+        range->FaceCount++;
+        for( j=0; j<3; j++ )
+        {
+            range->VertexStart = min( range->VertexStart, DWORD( _triangles[i].vertexId[j] ) );
+            vertexEnd = max( vertexEnd, DWORD( _triangles[i].vertexId[j] ) + 1 );
+        }
+    }
+    if( attributeTable.size() )
+    {
+        attributeTable.back().VertexCount = vertexEnd - attributeTable.back().VertexStart;
+        _mesh->setAttributeTable( &attributeTable[0], attributeTable.size() );
+    }
+}
+
+void Geometry::instance(void)
+{
+    // release previous mesh instance
+    if( _mesh ) delete _mesh;
+
+    // recalculate bounding box
+    _boundingBox.calculate( _numVertices, _vertices );
+    _boundingSphere.calculate( _numVertices, _vertices );
+
     // check normal maps across shaders
     bool hasNormalMap = false;
     unsigned int normalMapUV = 0;
@@ -516,36 +582,98 @@ void Geometry::instance(void)
             break;
         }
     }
+    bool useTangents = ( _numPrelights == 0 && hasNormalMap );
 
-    // update vertex declaration & rebuild mesh
-    if( _numPrelights == 0 && hasNormalMap )
+    // vertex declaration with tangents
+    D3DVERTEXELEMENT9* tangentDeclaration = NULL;
+    if( useTangents )
     {
         if( _vertexDeclaration == vertexNormalUV1 )
         {
-            _vertexDeclaration = vertexNormalUV1TangentBinormal;
+            tangentDeclaration = vertexNormalUV1TangentBinormal;
         }
         else if( _vertexDeclaration == vertexNormalUV2 )
         {
-            _vertexDeclaration = vertexNormalUV2TangentBinormal;
+            tangentDeclaration = vertexNormalUV2TangentBinormal;
         }
         else if( _vertexDeclaration == vertexNormalUV3 )
         {
-            _vertexDeclaration = vertexNormalUV3TangentBinormal;
+            tangentDeclaration = vertexNormalUV3TangentBinormal;
         }
         else if( _vertexDeclaration == vertexNormalUV4 )
         {
-            _vertexDeclaration = vertexNormalUV4TangentBinormal;
+            tangentDeclaration = vertexNormalUV4TangentBinormal;
         }
         else
         {
             assert( !"shouldn't be here!" );
         }
-        _mesh->updateDeclaration( D3DXMESH_VB_MANAGED | D3DXMESH_IB_MANAGED, _vertexDeclaration );        
-        _mesh->calculateTangents( normalMapUV );
     }
 
-    // optimize mesh
-    _mesh->optimize( D3DXMESH_VB_MANAGED | D3DXMESH_IB_MANAGED | D3DXMESHOPT_COMPACT | D3DXMESHOPT_ATTRSORT | D3DXMESHOPT_VERTEXCACHE );
+    // mesh data prepared by asset converter is instanced as is, unless 
+    // normal map needs tangents, which weren't prepared
+    if( _optimized && ( !useTangents || ( _tangents && _tangentUVSet == int( normalMapUV ) ) ) )
+    {
+        if( useTangents ) _vertexDeclaration = tangentDeclaration;
+        instancePrepared( _vertexDeclaration, useTangents );
+    }
+    else
+    {
+        _mesh = new Mesh( 
+            _numVertices, 
+            _numTriangles, 
+            _numShaders,
+            D3DXMESH_VB_DYNAMIC | D3DXMESH_IB_DYNAMIC,
+            _vertexDeclaration
+        );
+
+        // vertex buffer
+        unsigned char* vertexData = (unsigned char*)( _mesh->lockVertexBuffer( D3DLOCK_DISCARD ) );
+        // fill vertex buffer
+        int i, j, offset = 0;
+        for( i=0; i<_numVertices; i++ )
+        {
+            memcpy( vertexData+offset, _vertices+i, sizeof(Vector) ); offset += sizeof(Vector);
+            memcpy( vertexData+offset, _normals+i, sizeof(Vector) ); offset += sizeof(Vector);
+            for( j=0; j<_numUVSets; j++ )
+            {
+                memcpy( vertexData+offset, _uvs[j]+i, sizeof(Flector) ); offset += sizeof(Flector);
+            }
+            for( j=0; j<_numPrelights; j++ )
+            {
+                memcpy( vertexData+offset, _prelights[j]+i, sizeof(Color) ); offset += sizeof(Color);
+            }
+        }
+        _mesh->unlockVertexBuffer();
+
+        // fill index buffer
+        unsigned char* indexData = (unsigned char*)( _mesh->lockIndexBuffer( D3DLOCK_DISCARD ) );
+        offset = 0;
+        for( i=0; i<_numTriangles; i++ )
+        {
+            memcpy( indexData+offset, _triangles[i].vertexId, sizeof(WORD) * 3 );
+            offset += sizeof(WORD) * 3;
+        }
+        _mesh->unlockIndexBuffer();
+
+        DWORD* attrBuffer = (DWORD*)( _mesh->lockAttributeBuffer( D3DLOCK_DISCARD ) );
+        for( i=0; i<_numTriangles; i++ ) 
+        {
+            attrBuffer[i] = _triangles[i].shaderId;
+        }
+        _mesh->unlockAttributeBuffer();
+
+        // update vertex declaration & rebuild mesh
+        if( useTangents )
+        {
+            _vertexDeclaration = tangentDeclaration;
+            _mesh->updateDeclaration( D3DXMESH_VB_MANAGED | D3DXMESH_IB_MANAGED, _vertexDeclaration );        
+            _mesh->calculateTangents( normalMapUV );
+        }
+
+        // optimize mesh
+        _mesh->optimize( D3DXMESH_VB_MANAGED | D3DXMESH_IB_MANAGED | D3DXMESHOPT_COMPACT | D3DXMESHOPT_ATTRSORT | D3DXMESHOPT_VERTEXCACHE );
+    }
 
     if( _boundingBox.inf.x == _boundingBox.sup.x )
     {
@@ -804,6 +932,9 @@ void Geometry::write(IResource* resource)
     {
         reinterpret_cast<Effect*>( _effect )->write( resource );
     }
+
+    // prepared data (BA_PREPARED) is produced by asset converter only,
+    // engine-written geometries are instanced with D3DX
 }
 
 AssetObjectT Geometry::read(IResource* resource, AssetObjectM& assetObjects)
@@ -912,9 +1043,50 @@ AssetObjectT Geometry::read(IResource* resource, AssetObjectM& assetObjects)
         geometry->setEffect( reinterpret_cast<Effect*>( assetObjectT.second ) );
     }
 
+    // read results of offline mesh preparation
+    readPreparedData( resource, geometry );
+
     return AssetObjectT( chunk.id, geometry );
 }
 
+void Geometry::readPreparedData(IResource* resource, Geometry* geometry)
+{
+    // prepared chunk is optional, so next chunk header is peeked,
+    // and stream is rewound if it belongs to the other chunk
+    ChunkHeader preparedHeader( 0, 0 );
+    if( fread( &preparedHeader, sizeof(ChunkHeader), 1, resource->getFile() ) != 1 ) return;
+    if( preparedHeader.type != BA_PREPARED )
+    {
+        fseek( resource->getFile(), -int( sizeof(ChunkHeader) ), SEEK_CUR );
+        return;
+    }
+    if( preparedHeader.size != sizeof(PreparedChunk) ) throw Exception( "Incompatible binary asset version" );
+
+    PreparedChunk chunk;
+    fread( &chunk, sizeof(PreparedChunk), 1, resource->getFile() );
+    if( chunk.numVertices != geometry->_numVertices || chunk.numTriangles != geometry->_numTriangles )
+    {
+        throw Exception( "Inconsistent prepared data of geometry \"%s\"", geometry->getName() );
+    }
+
+    if( chunk.tangentUVSet >= 0 )
+    {
+        ChunkHeader tangentsHeader( resource );
+        if( tangentsHeader.type != BA_BINARY ) throw Exception( "Unexpected chunk type" );
+        if( tangentsHeader.size != sizeof(Vector)*chunk.numVertices ) throw Exception( "Incompatible binary asset version" );
+        geometry->_tangents = new Vector[chunk.numVertices];
+        fread( geometry->_tangents, tangentsHeader.size, 1, resource->getFile() );
+
+        ChunkHeader binormalsHeader( resource );
+        if( binormalsHeader.type != BA_BINARY ) throw Exception( "Unexpected chunk type" );
+        if( binormalsHeader.size != sizeof(Vector)*chunk.numVertices ) throw Exception( "Incompatible binary asset version" );
+        geometry->_binormals = new Vector[chunk.numVertices];
+        fread( geometry->_binormals, binormalsHeader.size, 1, resource->getFile() );
+    }
+    geometry->_tangentUVSet = chunk.tangentUVSet;
+    geometry->_optimized    = chunk.optimized;
+}
+
 /**
  * software skinning
  */
@@ -939,6 +1111,7 @@ void Geometry::captureMeshData(bool captureShaders)
     if( _vertices ) delete[] _vertices;
     if( _normals ) delete[] _normals;
     if( _triangles ) delete[] _triangles;
+    discardPreparedData();
 	int i;
     for( i=0; i<engine::maxPrelightLayers; i++ ) 
     {
@@ -146,6 +146,15 @@ private:
         bool hasEffect;
         bool hasSkin;
     };
+    // optional chunk following geometry, it is written by asset converter
+    // for meshes prepared offline (see assetconv/meshprep.h)
+    struct PreparedChunk
+    {
+        int  numVertices;
+        int  numTriangles;
+        int  tangentUVSet; // UV-set tangents are calculated for, -1 if there are no tangents
+        bool optimized;    // triangles are sorted by shaders & ordered for vertex cache
+    };
 private:
     friend class Atomic;
     friend class Batch;
@@ -167,6 +176,10 @@ private:
     Flector*           _uvs[engine::maxTextureLayers];
     Color*             _prelights[engine::maxPrelightLayers];
     Triangle*          _triangles;
+    Vector*            _tangents;     // prepared tangents, or NULL
+    Vector*            _binormals;    // prepared binormals, or NULL
+    int                _tangentUVSet; // UV-set of prepared tangents
+    bool               _optimized;    // mesh data is prepared for rendering as is
     Shader**           _shaders;
     D3DVERTEXELEMENT9* _vertexDeclaration;
     OcTreeSector*      _ocTreeRoot;
@@ -177,6 +190,9 @@ private:
     static OcTreeSector* onOcTreeSectorRayIntersection(Line* ray, OcTreeSector* sector);
 private:
     void captureMeshData(bool captureShaders);
+    void discardPreparedData(void);
+    void instancePrepared(D3DVERTEXELEMENT9* vertexDeclaration, bool useTangents);
+    static void readPreparedData(IResource* resource, Geometry* geometry);
     void addEdge(Table<EdgeHash,int>& edgeTable, std::vector<Edge>& edgeVector, int v0, int v1, int face);
 public:
     // class implementation    
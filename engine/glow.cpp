@@ -2,6 +2,7 @@
 #include "headers.h"
 #include "engine.h"
 #include "collision.h"
+#include "camera.h"
 #include "glow.h"
 
 /**
@@ -62,24 +63,12 @@ Glow::Glow(BSP* bsp, const char* glowTextureResource)
             glowTexture = glowTextureI->second;
         }
         assert( glowTexture );
-
-        // create shader
-        _shader = new Shader( 1, "GlowShader" );
-        _shader->setLayerTexture( 0, glowTexture );
-        _shader->setLayerUV( 0, 0 );
-        _shader->setFlags( _shader->getFlags() | engine::sfAlphaBlending );
-        _shader->setSrcBlend( engine::bmOne );
-        _shader->setDestBlend( engine::bmOne );
-        _shader->setBlendOp( engine::bpAdd );
-        _shader->addReference();
-
-        // create particle system
-        _particleSystem = new ParticleSystem( _glowParticles.size(), _shader, 0.0f );
+        _texture = glowTexture;
+        _texture->addReference();
     }
     else
     {
-        _shader = NULL;
-        _particleSystem = NULL;
+        _texture = NULL;
     }
 
     // reset properties
@@ -93,8 +82,7 @@ Glow::Glow(BSP* bsp, const char* glowTextureResource)
 
 Glow::~Glow()
 {
-    if( _particleSystem ) _particleSystem->release();
-    if( _shader ) _shader->release();    
+    if( _texture ) _texture->release();
 }
 
 /**
@@ -156,13 +144,14 @@ void Glow::setProperty(const char* propertyName, const Matrix4f& value)
 
 void Glow::render(void)
 {
-    if( !_particleSystem ) return;
+    if( !_texture ) return;
 
     // update particles
     float distance;
     float factor;
     Vector lightPos;
-    engine::Particle* particles = _particleSystem->getParticles();
+    Vector distanceV;
+    Vector2f size;
     for( unsigned int i=0; i<_glowParticles.size(); i++ )
     {
         // obtain position of light
@@ -188,24 +177,26 @@ void Glow::render(void)
                 }
             }
         }
-        // update particle
-        particles[i].visible  = _glowParticles[i].state;
-        particles[i].position = wrap( lightPos );
-        particles[i].rotation = 0.0f;
-        distance = ( wrap( Camera::eyePos ) - particles[i].position ).length();
+        // batch visible particle
+        if( !_glowParticles[i].state ) continue;
+        distanceV = Camera::eyePos - lightPos;
+        distance = D3DXVec3Length( &distanceV );
         factor = ( distance - _minSizeDistance ) / ( _maxSizeDistance - _minSizeDistance );
         factor = factor < 0 ? 0 : ( factor > 1 ? 1 : factor );
-        particles[i].size = _minSize * ( 1 - factor ) + _maxSize * factor;
-        particles[i].color = _glowParticles[i].color;
-        particles[i].uv[0].set( 1,1 );
-        particles[i].uv[1].set( 1,0 );
-        particles[i].uv[2].set( 0,0 );
-        particles[i].uv[3].set( 0,1 );
+        size = _minSize * ( 1 - factor ) + _maxSize * factor;
+        SpriteBatch::addBillboard( 
+            _texture, D3DBLEND_ONE, D3DBLEND_ONE,
+            lightPos, 
+            Flector( size[0], size[1] ),
+            D3DCOLOR_RGBA( 
+                unsigned int( _glowParticles[i].color[0] * 255 ),
+                unsigned int( _glowParticles[i].color[1] * 255 ),
+                unsigned int( _glowParticles[i].color[2] * 255 ),
+                unsigned int( _glowParticles[i].color[3] * 255 )
+            )
+        );
     }
 
-    // render particles
-    _particleSystem->render();
-
     // reset timestep
     _dt = 0.0f;
 }
\ No newline at end of file
@@ -6,7 +6,7 @@
 #include "../shared/engine.h"
 #include "fundamentals.h"
 #include "rendering.h"
-#include "psys.h"
+#include "sprite.h"
 #include "bsp.h"
 #include "light.h"
 
@@ -34,8 +34,7 @@ private:
 private:    
     BSP*            _bsp;             // driven BSP scene    
     GlowParticles   _glowParticles;   // lights from BSP scene
-    Shader*         _shader;          // shading technique
-    ParticleSystem* _particleSystem;  // driven particles    
+    Texture*        _texture;         // glow texture (glows are rendered by SpriteBatch)
 private:
     // setProperty(...) - rendering properties 
     float    _dt;              // ("dt") - update time step 
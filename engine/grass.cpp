@@ -6,6 +6,7 @@
 #include "ixml.h"
 #include "../common/istring.h"
 #include "wire.h"
+#include "transient.h"
 #include "gui.h"
 #include "../common/unicode.h"
 
@@ -114,27 +115,6 @@ Grass::Grass(const char* resourcePath, engine::IAtomic* templateAtomic, engine::
     _fadeEnd = fadeEnd;
     if( _fadeEnd <= _fadeStart ) _fadeEnd = _fadeStart + 100.0f;
 
-    // create rendering resources
-    // WORD is size of index (16 bits), 6 is number of indices per one particle
-    _dxCR( iDirect3DDevice->CreateIndexBuffer(
-        sizeof(WORD) * 6 * maxParticlesPerPass,
-        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC, 
-        D3DFMT_INDEX16,
-        D3DPOOL_DEFAULT, 
-        &_indexBuffer,
-        NULL
-    ) );
-
-    // 4 is number of vertices per one particle
-    _dxCR( iDirect3DDevice->CreateVertexBuffer(
-        sizeof(GrassParticleVertex) * 4 * maxParticlesPerPass,
-        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC,
-        particleFVF,
-        D3DPOOL_DEFAULT,
-        &_vertexBuffer,
-        NULL
-    ) );
-
     // obtain ambient
     _ambientR = (unsigned char)( grassScheme->ambient[0] * 255 );
     _ambientG = (unsigned char)( grassScheme->ambient[1] * 255 );
@@ -230,8 +210,6 @@ Grass::Grass(const char* resourcePath, engine::IAtomic* templateAtomic, engine::
 Grass::~Grass()
 {
     _shader->release();
-    _indexBuffer->Release();
-    _vertexBuffer->Release();
     for( GrassClusterI grassClusterI = _clusters.begin();
                        grassClusterI != _clusters.end();
                        grassClusterI++ )
@@ -559,15 +537,12 @@ void Grass::render(void)
         (*nestSize)++;
     }
 
-    // lock buffers
-    void* vertexData = NULL;
-    void* indexData = NULL;
-    _dxCR( _vertexBuffer->Lock( 0, maxParticlesPerPass * 4 * sizeof( GrassParticleVertex ), &vertexData, D3DLOCK_DISCARD ) );
-    _dxCR( _indexBuffer->Lock( 0, maxParticlesPerPass * 6 * sizeof( WORD ), &indexData, D3DLOCK_DISCARD ) );
-    assert( vertexData );
-    assert( indexData );
-    GrassParticleVertex* vertex = (GrassParticleVertex*)( vertexData );
-    WORD* index = (WORD*)( indexData );
+    // allocate transient geometry (no more than number of particles left)
+    unsigned int baseVertex;
+    unsigned int baseIndex;
+    unsigned int passSize = std::min<unsigned int>( _numItems, maxParticlesPerPass );
+    GrassParticleVertex* vertex = (GrassParticleVertex*)( TransientBuffer::lockVertices( sizeof( GrassParticleVertex ), passSize * 4, &baseVertex ) );
+    WORD* index = TransientBuffer::lockIndices( passSize * 6, &baseIndex );
 
     // render particles
     unsigned int passParticles = 0;
@@ -624,37 +599,33 @@ void Grass::render(void)
             // next particle
             vertex += 4, index += 6, passParticles++;
             // buffers is full? - render
-            if( passParticles == maxParticlesPerPass )
+            if( passParticles == passSize )
             {
                 // unlock buffers
-                _vertexBuffer->Unlock();
-                _indexBuffer->Unlock();
+                TransientBuffer::unlockVertices( passParticles * 4 );
+                TransientBuffer::unlockIndices( passParticles * 6 );
                 // render buffers
-                renderBuffers( passParticles );
-                // relock buffers
-                _dxCR( _vertexBuffer->Lock( 0, maxParticlesPerPass * 4 * sizeof( GrassParticleVertex ), &vertexData, D3DLOCK_DISCARD ) );
-                _dxCR( _indexBuffer->Lock( 0, maxParticlesPerPass * 6 * sizeof( WORD ), &indexData, D3DLOCK_DISCARD ) );
-                assert( vertexData );
-                assert( indexData );
-                vertex = (GrassParticleVertex*)( vertexData );
-                index = (WORD*)( indexData );
+                renderBuffers( passParticles, baseVertex, baseIndex );
+                // allocate next pass
+                vertex = (GrassParticleVertex*)( TransientBuffer::lockVertices( sizeof( GrassParticleVertex ), passSize * 4, &baseVertex ) );
+                index = TransientBuffer::lockIndices( passSize * 6, &baseIndex );
                 passParticles = 0;
             }
         }
     }
 
     // unlock buffers
-    _vertexBuffer->Unlock();
-    _indexBuffer->Unlock();
+    TransientBuffer::unlockVertices( passParticles * 4 );
+    TransientBuffer::unlockIndices( passParticles * 6 );
 
     if( passParticles != 0 )
     {        
         // render buffers
-        renderBuffers( passParticles );
+        renderBuffers( passParticles, baseVertex, baseIndex );
     }
 }
 
-void Grass::renderBuffers(unsigned int numPassParticles)
+void Grass::renderBuffers(unsigned int numPassParticles, unsigned int baseVertex, unsigned int baseIndex)
 {
     // render
     _dxCR( dxSetRenderState( D3DRS_LIGHTING, FALSE ) );    
@@ -669,40 +640,9 @@ void Grass::renderBuffers(unsigned int numPassParticles)
 
     _dxCR( iDirect3DDevice->SetTransform( D3DTS_WORLD, &identity ) );
     _dxCR( iDirect3DDevice->SetFVF( particleFVF ) );
-    _dxCR( iDirect3DDevice->SetStreamSource( 0, _vertexBuffer, 0, sizeof( GrassParticleVertex ) ) );
-    _dxCR( iDirect3DDevice->SetIndices( _indexBuffer ) );
-    _dxCR( iDirect3DDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, 0, 0, numPassParticles * 4, 0, numPassParticles * 2 ) );
+    TransientBuffer::setStreams( sizeof( GrassParticleVertex ) );
+    _dxCR( iDirect3DDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, baseVertex, 0, numPassParticles * 4, baseIndex, numPassParticles * 2 ) );
 
     _dxCR( dxSetRenderState( D3DRS_ZWRITEENABLE, TRUE ) );
     _dxCR( dxSetRenderState( D3DRS_LIGHTING, TRUE ) ); 
-}
-
-void Grass::onLostDevice(void)
-{
-    _indexBuffer->Release();
-    _vertexBuffer->Release();
-}
-
-void Grass::onResetDevice(void)
-{
-    // create rendering resources
-    // WORD is size of index (16 bits), 6 is number of indices per one particle
-    _dxCR( iDirect3DDevice->CreateIndexBuffer(
-        sizeof(WORD) * 6 * maxParticlesPerPass,
-        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC, 
-        D3DFMT_INDEX16,
-        D3DPOOL_DEFAULT, 
-        &_indexBuffer,
-        NULL
-    ) );
-
-    // 4 is number of vertices per one particle
-    _dxCR( iDirect3DDevice->CreateVertexBuffer(
-        sizeof(GrassParticleVertex) * 4 * maxParticlesPerPass,
-        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC,
-        particleFVF,
-        D3DPOOL_DEFAULT,
-        &_vertexBuffer,
-        NULL
-    ) );
 }
\ No newline at end of file
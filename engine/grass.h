@@ -68,8 +68,7 @@ typedef GrassClusters::iterator  GrassClusterI;
  * grass rendering
  */
 
-class Grass : public Rendering,
-              virtual public Lostable
+class Grass : public Rendering
 {
 private:
     GrassClusters _clusters;  // managed clusters
@@ -80,8 +79,6 @@ private:
     unsigned char _ambientB;  // ambient color
 private:
     Shader*                 _shader;       // shading technique
-    IDirect3DVertexBuffer9* _vertexBuffer; // vertex buffer
-    IDirect3DIndexBuffer9*  _indexBuffer;  // index buffer
 private:
     unsigned char   _nestSize[256];  // record contains corresponding nest size
     GrassParticle*  _nest[256][256]; // 256 nests for particle vertices
@@ -90,7 +87,7 @@ private:
 private:
     void generateSpecie(engine::GrassSpecie* specie, engine::IAtomic* templateAtomic, GrassParticles& solidStorage);
     void regroupCluster(GrassParticles& solidStorage, float clusterSize);
-    void renderBuffers(unsigned int numPassParticles);
+    void renderBuffers(unsigned int numPassParticles, unsigned int baseVertex, unsigned int baseIndex);
 public:
     // class implementation
     Grass(const char* resourcePath, engine::IAtomic* templateAtomic, engine::ITexture* texture, engine::GrassScheme* grassScheme, float fadeStart, float fadeEnd);
@@ -102,9 +99,6 @@ public:
     virtual void __stdcall setProperty(const char* propertyName, const Vector2f& value);
     virtual void __stdcall setProperty(const char* propertyName, const Vector4f& value);
     virtual void __stdcall setProperty(const char* propertyName, const Matrix4f& value);
-    // Lostable
-    virtual void onLostDevice(void);
-    virtual void onResetDevice(void);
     // Rendering
     void render(void);
 };
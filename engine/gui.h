@@ -27,6 +27,9 @@ class GuiPanel : public gui::IGuiPanel
 protected:
     typedef std::list<GuiPanel*> GuiPanelL;
     typedef GuiPanelL::iterator GuiPanelI;
+    typedef std::pair<std::string,GuiPanel*> GuiPanelT;
+    typedef std::map<std::string,GuiPanel*> GuiPanelM;
+    typedef GuiPanelM::iterator GuiPanelMI;
 protected:
     std::string                 _name;
     bool                        _visible;
@@ -42,6 +45,12 @@ protected:
     std::wstring                _hint;
     gui::GuiPanelRenderCallback _renderCallback;
     void*                       _renderCallbackData;
+    unsigned int                _revision;      // revision of hierarchy
+    unsigned int                _indexRevision; // revision of hierarchy, indexed by name
+    GuiPanelM                   _index;         // name index of hierarchy (first in depth)
+private:
+    void touch(void);
+    void indexPanel(GuiPanel* panel);
 protected:
     virtual void onRender(void) {}
     virtual void onMessage(gui::Message* message) {}
@@ -60,6 +69,7 @@ public:
     virtual void __stdcall insertPanel(gui::IGuiPanel* panel);
     virtual void __stdcall removePanel(gui::IGuiPanel* panel);
     virtual gui::IGuiPanel* __stdcall find(const char* name);
+    virtual unsigned int __stdcall getRevision(void);
     virtual bool __stdcall getVisible(void);
     virtual void __stdcall setVisible(bool visible);
     virtual gui::Rect __stdcall getRect(void);
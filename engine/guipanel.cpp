@@ -14,7 +14,8 @@ GuiPanel::GuiPanel()
     _renderCallback = NULL;
     _renderCallbackData = NULL;
 	_animating = false;
-
+    _revision = 1;
+    _indexRevision = 0;
 }
 
 GuiPanel::GuiPanel(const char* panelName)
@@ -29,6 +30,8 @@ GuiPanel::GuiPanel(const char* panelName)
     _renderCallback = NULL;
     _renderCallbackData = NULL;
 	_animating = false;
+    _revision = 1;
+    _indexRevision = 0;
 }
 
 GuiPanel::~GuiPanel()
@@ -168,6 +171,7 @@ const char* GuiPanel::getName(void)
 void GuiPanel::setName(const char* name)
 {
     _name = name;
+    touch();
 }
 
 const wchar_t* GuiPanel::getHint(void)
@@ -191,6 +195,7 @@ void GuiPanel::insertPanel(gui::IGuiPanel* panel)
     if( p->_parent ) p->_parent->removePanel( p );   
     _children.push_back( p );
     p->_parent = this;
+    touch();
 
 	// autosize (fuck yeah!)
 	return;
@@ -227,26 +232,55 @@ void GuiPanel::removePanel(gui::IGuiPanel* panel)
         {
             _children.erase( guiPanelI );
             p->_parent = NULL;
+            touch();
             break;
         }
     }
 }
 
-gui::IGuiPanel* GuiPanel::find(const char* name)
+void GuiPanel::touch(void)
 {
-	//getCore()->logMessage("finding: %s", _name.c_str());
-    if( strcmp( name, _name.c_str() ) == 0 ) return this;
+    for( GuiPanel* panel = this; panel != NULL; panel = panel->_parent )
+    {
+        panel->_revision++;
+    }
+}
 
-    gui::IGuiPanel* result = NULL;
-    for( GuiPanelI guiPanelI = _children.begin();
-                   guiPanelI != _children.end();
+void GuiPanel::indexPanel(GuiPanel* panel)
+{
+    // insertion keeps existing entry, so the first panel in depth wins (as it was in recursive search)
+    _index.insert( GuiPanelT( panel->_name, panel ) );
+    for( GuiPanelI guiPanelI = panel->_children.begin();
+                   guiPanelI != panel->_children.end();
                    guiPanelI++ )
     {
-        result = (*guiPanelI)->find( name );
-        if( result ) return result;
+        indexPanel( *guiPanelI );
     }
+}
 
-    return NULL;
+gui::IGuiPanel* GuiPanel::find(const char* name)
+{
+    if( _children.size() == 0 )
+    {
+        return ( strcmp( name, _name.c_str() ) == 0 ) ? this : NULL;
+    }
+
+    // index is rebuilt lazily, when hierarchy is changed
+    if( _indexRevision != _revision )
+    {
+        _index.clear();
+        indexPanel( this );
+        _indexRevision = _revision;
+    }
+
+    GuiPanelMI guiPanelMI = _index.find( name );
+    if( guiPanelMI == _index.end() ) return NULL;
+    return guiPanelMI->second;
+}
+
+unsigned int GuiPanel::getRevision(void)
+{
+    return _revision;
 }
 
 bool GuiPanel::getVisible(void)
@@ -20,6 +20,7 @@
 #include <set>
 #include <stack>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <list>
 #include <queue>
@@ -33,6 +33,9 @@ void BSP::renderLensFlares(void)
     {
         (*clumpI)->forAllLights( renderLensFlaresCB, NULL );
     }
+
+    // flares of all lights are rendered by a few draw calls (one per flare texture)
+    SpriteBatch::flush();
 }
 
 engine::ILight* BSP::renderLensFlaresCB(engine::ILight* light, void* data)
@@ -123,36 +126,6 @@ void BSP::renderLensFlares(Light* light)
             int( 255 * ( 1.0f - inclK ) )
         );
 
-        // setup render states & texture stages
-        _dxCR( dxSetRenderState( D3DRS_COLORVERTEX, TRUE ) );
-        _dxCR( dxSetRenderState( D3DRS_AMBIENTMATERIALSOURCE, D3DMCS_MATERIAL ) );
-        _dxCR( dxSetRenderState( D3DRS_DIFFUSEMATERIALSOURCE, D3DMCS_MATERIAL ) );
-        _dxCR( dxSetRenderState( D3DRS_SPECULARMATERIALSOURCE, D3DMCS_MATERIAL ) );
-        _dxCR( dxSetRenderState( D3DRS_EMISSIVEMATERIALSOURCE, D3DMCS_COLOR1 ) );
-
-        _dxCR( dxSetTextureStageState( 0, D3DTSS_TEXCOORDINDEX, 0 ) );
-        _dxCR( dxSetTextureStageState( 0, D3DTSS_COLOROP, D3DTOP_SELECTARG1 ) );
-        _dxCR( dxSetTextureStageState( 0, D3DTSS_COLORARG1, D3DTA_TEXTURE ) );
-        _dxCR( dxSetTextureStageState( 0, D3DTSS_ALPHAOP, D3DTOP_SELECTARG1 ) );
-        _dxCR( dxSetTextureStageState( 0, D3DTSS_ALPHAARG1, D3DTA_TEXTURE ) );
-
-        _dxCR( dxSetTextureStageState( 1, D3DTSS_COLOROP, D3DTOP_MODULATE ) );
-        _dxCR( dxSetTextureStageState( 1, D3DTSS_COLORARG1, D3DTA_CURRENT ) );
-        _dxCR( dxSetTextureStageState( 1, D3DTSS_COLORARG2, D3DTA_DIFFUSE ) );
-        _dxCR( dxSetTextureStageState( 1, D3DTSS_ALPHAOP, D3DTOP_MODULATE ) );
-        _dxCR( dxSetTextureStageState( 1, D3DTSS_ALPHAARG1, D3DTA_CURRENT ) );
-        _dxCR( dxSetTextureStageState( 1, D3DTSS_ALPHAARG2, D3DTA_DIFFUSE ) );
-
-        _dxCR( dxSetTextureStageState( 2, D3DTSS_ALPHAOP, D3DTOP_DISABLE ) );
-        _dxCR( dxSetTextureStageState( 2, D3DTSS_COLOROP, D3DTOP_DISABLE ) );
-
-        _dxCR( dxSetRenderState( D3DRS_ALPHABLENDENABLE, TRUE ) );
-        _dxCR( dxSetRenderState( D3DRS_SRCBLEND, D3DBLEND_ONE ) );
-        _dxCR( dxSetRenderState( D3DRS_DESTBLEND, D3DBLEND_ONE ) );
-        _dxCR( dxSetRenderState( D3DRS_BLENDOP, D3DBLENDOP_ADD ) );
-
-        _dxCR( dxSetRenderState( D3DRS_ZENABLE, FALSE ) );
-
         // draw flares along the line, formed by the points "screenCenter" & "flareOffset"        
         for( unsigned int i=0; i<7; i++ )
         {
@@ -169,22 +142,8 @@ void BSP::renderLensFlares(Light* light)
             // calculate flare size
             Flector rectS( 0.5f*defaultSize*size[i], 0.5f*defaultSize*size[i] );
 
-            // apply texture
-            textureI->second->apply(0);
-
-            // render rectangle
-            dxRenderRect( 
-                unsigned int( rectC.y - rectS.y ), 
-                unsigned int( rectC.x - rectS.x ), 
-                unsigned int( 2 * rectS.y ), 
-                unsigned int( 2 * rectS.x ), 
-                color
-            );
+            // batch rectangle
+            SpriteBatch::addRect( textureI->second, D3DBLEND_ONE, D3DBLEND_ONE, rectC, rectS, color );
         }
-
-        // restore critical render states
-        _dxCR( dxSetRenderState( D3DRS_SRCBLEND, D3DBLEND_SRCALPHA ) );
-        _dxCR( dxSetRenderState( D3DRS_DESTBLEND, D3DBLEND_INVSRCALPHA ) );
-        _dxCR( dxSetRenderState( D3DRS_ZENABLE, TRUE ) );
     }
 }
\ No newline at end of file
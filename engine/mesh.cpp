@@ -699,6 +699,14 @@ void Mesh::calculateTangents(unsigned int texStageId)
     }
 }
 
+void Mesh::setAttributeTable(const D3DXATTRIBUTERANGE* attributeTable, DWORD attributeTableSize)
+{
+    // replaces optimize() for mesh which is already sorted by attributes,
+    // subset identifiers are still the attribute identifiers
+    assert( pSkinInfo == NULL );
+    _dxCR( OriginalMeshData.pMesh->SetAttributeTable( attributeTable, attributeTableSize ) );
+}
+
 /**
  * rendering method
  */
@@ -80,6 +80,7 @@ public:
     void getDeclaration(D3DVERTEXELEMENT9* vertexDeclaration);
     void updateDeclaration(DWORD options, const D3DVERTEXELEMENT9 *vertexDeclaration);
     void calculateTangents(unsigned int texStageId);
+    void setAttributeTable(const D3DXATTRIBUTERANGE* attributeTable, DWORD attributeTableSize);
 public:
     // mesh rendering
     DWORD getAttributeId(int subsetId);
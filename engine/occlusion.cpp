@@ -0,0 +1,212 @@
+
+#include "headers.h"
+#include <cfloat>
+#include <cmath>
+#include <malloc.h>
+#include <xmmintrin.h>
+#include "occlusion.h"
+
+/**
+ * class implementation
+ */
+
+OcclusionBuffer::OcclusionBuffer(unsigned int width, unsigned int height)
+{
+    // rows are processed by 4 pixels
+    _width  = ( width + 3 ) & ~3;
+    _height = height;
+    _depth  = reinterpret_cast<float*>( _aligned_malloc( _width * _height * sizeof(float), 16 ) );
+    D3DXMatrixIdentity( &_viewProj );
+    for( unsigned int i=0; i<_width*_height; i++ ) _depth[i] = 1.0f;
+}
+
+OcclusionBuffer::~OcclusionBuffer()
+{
+    _aligned_free( _depth );
+}
+
+/**
+ * module locals
+ */
+
+void OcclusionBuffer::clear(const Matrix* viewProj)
+{
+    _viewProj = *viewProj;
+    for( unsigned int i=0; i<_width*_height; i++ ) _depth[i] = 1.0f;
+}
+
+static inline float edgeFunction(const Flector& a, const Flector& b, float x, float y)
+{
+    return ( b.x - a.x ) * ( y - a.y ) - ( b.y - a.y ) * ( x - a.x );
+}
+
+/**
+ * edge function in form e(x,y) = a*x + b*y + c
+ */
+
+struct EdgeEquation
+{
+public:
+    float a, b, c;
+public:
+    inline void setup(const Flector& v0, const Flector& v1)
+    {
+        a = -( v1.y - v0.y );
+        b = v1.x - v0.x;
+        c = ( v1.y - v0.y ) * v0.x - ( v1.x - v0.x ) * v0.y;
+    }
+};
+
+void OcclusionBuffer::rasterize(const Vector* vertices, unsigned int numTriangles)
+{
+    float halfWidth  = 0.5f * _width;
+    float halfHeight = 0.5f * _height;
+
+    // pixel center offsets for 4-pixel block
+    const __m128 blockOffset = _mm_set_ps( 3.5f, 2.5f, 1.5f, 0.5f );
+    const __m128 zero        = _mm_setzero_ps();
+
+    D3DXVECTOR4  clip;
+    Flector      screen[3];
+    EdgeEquation edge[3];
+    for( unsigned int t=0; t<numTriangles; t++, vertices+=3 )
+    {
+        // project triangle, skip triangles crossing the near plane
+        // (missing occluder is always safe), depth of triangle is the
+        // depth of its farthest vertex, that keeps the test conservative
+        float depth = 0.0f;
+        bool  clipped = false;
+        for( unsigned int i=0; i<3; i++ )
+        {
+            D3DXVec3Transform( &clip, vertices + i, &_viewProj );
+            if( clip.z < 0 || clip.w <= 0 )
+            {
+                clipped = true;
+                break;
+            }
+            float invW = 1.0f / clip.w;
+            screen[i].x = ( clip.x * invW + 1.0f ) * halfWidth;
+            screen[i].y = ( 1.0f - clip.y * invW ) * halfHeight;
+            depth = std::max( depth, clip.z * invW );
+        }
+        if( clipped || depth > 1.0f ) continue;
+
+        // occluders are double-sided, make winding consistent
+        float area = edgeFunction( screen[0], screen[1], screen[2].x, screen[2].y );
+        if( area == 0 ) continue;
+        if( area < 0 ) std::swap( screen[1], screen[2] );
+
+        // bounding rectangle, horizontally aligned by 4-pixel blocks
+        int minX = int( floor( std::min( screen[0].x, std::min( screen[1].x, screen[2].x ) ) ) );
+        int maxX = int( ceil( std::max( screen[0].x, std::max( screen[1].x, screen[2].x ) ) ) );
+        int minY = int( floor( std::min( screen[0].y, std::min( screen[1].y, screen[2].y ) ) ) );
+        int maxY = int( ceil( std::max( screen[0].y, std::max( screen[1].y, screen[2].y ) ) ) );
+        minX = std::max( minX, 0 ) & ~3, maxX = std::min( maxX, int( _width ) - 1 );
+        minY = std::max( minY, 0 ), maxY = std::min( maxY, int( _height ) - 1 );
+        if( minX > maxX || minY > maxY ) continue;
+
+        edge[0].setup( screen[1], screen[2] );
+        edge[1].setup( screen[2], screen[0] );
+        edge[2].setup( screen[0], screen[1] );
+
+        // edge functions at the first block of the row and their steps
+        __m128 blockX = _mm_add_ps( _mm_set1_ps( float( minX ) ), blockOffset );
+        __m128 rowE[3], stepX[3];
+        for( unsigned int i=0; i<3; i++ )
+        {
+            rowE[i]  = _mm_add_ps( 
+                _mm_mul_ps( _mm_set1_ps( edge[i].a ), blockX ), 
+                _mm_set1_ps( edge[i].b * ( minY + 0.5f ) + edge[i].c )
+            );
+            stepX[i] = _mm_set1_ps( 4.0f * edge[i].a );
+        }
+        __m128 triDepth = _mm_set1_ps( depth );
+
+        // fill pixels which centers are inside of triangle
+        for( int y=minY; y<=maxY; y++ )
+        {
+            float* row = _depth + y * _width;
+            __m128 e0  = rowE[0];
+            __m128 e1  = rowE[1];
+            __m128 e2  = rowE[2];
+            for( int x=minX; x<=maxX; x+=4 )
+            {
+                __m128 inside = _mm_and_ps( 
+                    _mm_and_ps( _mm_cmpge_ps( e0, zero ), _mm_cmpge_ps( e1, zero ) ),
+                    _mm_cmpge_ps( e2, zero )
+                );
+                if( _mm_movemask_ps( inside ) )
+                {
+                    __m128 current = _mm_load_ps( row + x );
+                    __m128 closest = _mm_min_ps( current, triDepth );
+                    _mm_store_ps( row + x, _mm_or_ps( _mm_and_ps( inside, closest ), _mm_andnot_ps( inside, current ) ) );
+                }
+                e0 = _mm_add_ps( e0, stepX[0] );
+                e1 = _mm_add_ps( e1, stepX[1] );
+                e2 = _mm_add_ps( e2, stepX[2] );
+            }
+            for( unsigned int i=0; i<3; i++ )
+            {
+                rowE[i] = _mm_add_ps( rowE[i], _mm_set1_ps( edge[i].b ) );
+            }
+        }
+    }
+}
+
+bool OcclusionBuffer::isVisible(const AABB* box)
+{
+    float halfWidth  = 0.5f * _width;
+    float halfHeight = 0.5f * _height;
+
+    // project box corners
+    D3DXVECTOR4 clip;
+    Vector      corner;
+    float minX = FLT_MAX, maxX = -FLT_MAX;
+    float minY = FLT_MAX, maxY = -FLT_MAX;
+    float minDepth = FLT_MAX;
+    for( unsigned int i=0; i<8; i++ )
+    {
+        corner.x = ( i & 1 ) ? box->sup.x : box->inf.x;
+        corner.y = ( i & 2 ) ? box->sup.y : box->inf.y;
+        corner.z = ( i & 4 ) ? box->sup.z : box->inf.z;
+        D3DXVec3Transform( &clip, &corner, &_viewProj );
+        // box crosses the near plane
+        if( clip.z < 0 || clip.w <= 0 ) return true;
+        float invW = 1.0f / clip.w;
+        float sx = ( clip.x * invW + 1.0f ) * halfWidth;
+        float sy = ( 1.0f - clip.y * invW ) * halfHeight;
+        minX = std::min( minX, sx ), maxX = std::max( maxX, sx );
+        minY = std::min( minY, sy ), maxY = std::max( maxY, sy );
+        minDepth = std::min( minDepth, clip.z * invW );
+    }
+
+    // covered pixels
+    int x0 = std::max( int( floor( minX ) ), 0 );
+    int x1 = std::min( int( ceil( maxX ) ), int( _width ) - 1 );
+    int y0 = std::max( int( floor( minY ) ), 0 );
+    int y1 = std::min( int( ceil( maxY ) ), int( _height ) - 1 );
+    if( x0 > x1 || y0 > y1 ) return true;
+
+    // box is visible if any of covered pixels is farther than its nearest point
+    // (blocks are aligned by 4 pixels, extra pixels only make the test more conservative)
+    __m128 boxDepth = _mm_set1_ps( minDepth );
+    x0 = x0 & ~3;
+    for( int y=y0; y<=y1; y++ )
+    {
+        const float* row = _depth + y * _width;
+        for( int x=x0; x<=x1; x+=4 )
+        {
+            if( _mm_movemask_ps( _mm_cmpge_ps( _mm_load_ps( row + x ), boxDepth ) ) ) return true;
+        }
+    }
+    return false;
+}
+
+bool OcclusionBuffer::isVisible(const Sphere* sphere)
+{
+    AABB box;
+    Vector radius( sphere->radius, sphere->radius, sphere->radius );
+    box.inf = sphere->center - radius;
+    box.sup = sphere->center + radius;
+    return isVisible( &box );
+}
@@ -0,0 +1,44 @@
+/**
+ * This source code is a part of D3 game project.
+ * (c) Digital Dimension Development, 2004-2005
+ *
+ * @description software occlusion buffer
+ */
+
+#ifndef OCCLUSION_IMPLEMENTATION_INCLUDED
+#define OCCLUSION_IMPLEMENTATION_INCLUDED
+
+#include "headers.h"
+#include "fundamentals.h"
+
+/**
+ * low resolution depth buffer, filled on CPU by occluder triangles
+ * and used to reject bounding boxes that are completely hidden behind occluders;
+ * buffer uses no rendering device, so it can be exercised without a window
+ */
+
+class OcclusionBuffer
+{
+private:
+    unsigned int _width;    // multiple of 4
+    unsigned int _height;
+    float*       _depth;    // normalized depth (0 - near plane, 1 - far plane)
+    Matrix       _viewProj; // current view-projection transformation
+public:
+    // class implementation
+    OcclusionBuffer(unsigned int width, unsigned int height);
+    ~OcclusionBuffer();
+public:
+    // module locals : inlines
+    inline unsigned int getWidth(void) { return _width; }
+    inline unsigned int getHeight(void) { return _height; }
+    inline const float* getDepth(void) { return _depth; }
+public:
+    // module locals
+    void clear(const Matrix* viewProj);
+    void rasterize(const Vector* vertices, unsigned int numTriangles);
+    bool isVisible(const AABB* box);
+    bool isVisible(const Sphere* sphere);
+};
+
+#endif
@@ -0,0 +1,207 @@
+
+#include "headers.h"
+#include "particlebudget.h"
+#include "camera.h"
+#include "collision.h"
+
+// limit of fine steps, simulated at once to catch up postponed time
+static const unsigned int maxCatchUpSteps = 8;
+
+bool          ParticleBudget::_enabled          = true;
+bool          ParticleBudget::_logCost          = false;
+float         ParticleBudget::_fullScreenSize   = 0.25f;
+float         ParticleBudget::_minEmissionScale = 0.25f;
+float         ParticleBudget::_coarseInterval   = 0.5f;
+float         ParticleBudget::_maxStep          = 0.033f;
+unsigned int  ParticleBudget::_maxParticles     = 4096;
+unsigned int  ParticleBudget::_frameId          = 0;
+unsigned int  ParticleBudget::_frameParticles   = 0;
+float         ParticleBudget::_globalScale      = 1.0f;
+LARGE_INTEGER ParticleBudget::_frequency;
+
+/**
+ * initialization & etc
+ */
+
+void ParticleBudget::init(void)
+{
+    QueryPerformanceFrequency( &_frequency );
+
+    // optional setup
+    TiXmlElement* particleBudget = Engine::instance->getConfigElement( "particleBudget" );
+    if( particleBudget )
+    {
+        int    intValue;
+        double doubleValue;
+        if( particleBudget->Attribute( "enabled", &intValue ) ) _enabled = ( intValue != 0 );
+        if( particleBudget->Attribute( "logCost", &intValue ) ) _logCost = ( intValue != 0 );
+        if( particleBudget->Attribute( "maxParticles", &intValue ) && intValue > 0 ) _maxParticles = intValue;
+        if( particleBudget->Attribute( "fullScreenSize", &doubleValue ) && doubleValue > 0 ) _fullScreenSize = float( doubleValue );
+        if( particleBudget->Attribute( "minEmissionScale", &doubleValue ) && doubleValue > 0 ) _minEmissionScale = float( doubleValue );
+        if( particleBudget->Attribute( "coarseInterval", &doubleValue ) && doubleValue >= 0 ) _coarseInterval = float( doubleValue );
+        if( particleBudget->Attribute( "maxStep", &doubleValue ) && doubleValue > 0 ) _maxStep = float( doubleValue );
+    }
+    if( _minEmissionScale > 1.0f ) _minEmissionScale = 1.0f;
+}
+
+void ParticleBudget::term(void)
+{
+}
+
+void ParticleBudget::beginFrame(void)
+{
+    // global scale follows the total number of simulated particles smoothly,
+    // because particles emitted with previous scale live for several seconds
+    float targetScale = 1.0f;
+    if( _frameParticles > _maxParticles )
+    {
+        targetScale = _globalScale * float( _maxParticles ) / float( _frameParticles );
+    }
+    else if( _frameParticles > 0 )
+    {
+        targetScale = _globalScale * float( _maxParticles ) / float( _frameParticles );
+        if( targetScale > 1.0f ) targetScale = 1.0f;
+    }
+    _globalScale += ( targetScale - _globalScale ) * 0.1f;
+    if( _globalScale < _minEmissionScale ) _globalScale = _minEmissionScale;
+
+    _frameParticles = 0;
+    _frameId++;
+}
+
+/**
+ * client
+ */
+
+ParticleBudget::Client::Client(const char* name)
+{
+    _name              = name ? name : "UnnamedParticleSystem";
+    _importance        = 1.0f;
+    _visible           = true;
+    _evaluationFrameId = ParticleBudget::_frameId;
+    _pendingTime       = 0.0f;
+    _updateStart.QuadPart = 0;
+    _numUpdates        = 0;
+    _numSkipped        = 0;
+    _numParticles      = 0;
+    _updateTime        = 0.0;
+}
+
+ParticleBudget::Client::~Client()
+{
+    if( ParticleBudget::_logCost && _numUpdates )
+    {
+        getCore()->logMessage(
+            "engine: particle system \"%s\" : %d updates (%d postponed), %d particles simulated, %3.2f ms (%3.3f ms per update)",
+            _name.c_str(),
+            _numUpdates,
+            _numSkipped,
+            _numParticles,
+            float( _updateTime * 1000.0 ),
+            float( _updateTime * 1000.0 / _numUpdates )
+        );
+    }
+}
+
+bool ParticleBudget::Client::evaluate(AABB* boundingBox)
+{
+    _evaluationFrameId = ParticleBudget::_frameId;
+
+    if( !ParticleBudget::_enabled )
+    {
+        _visible    = true;
+        _importance = 1.0f;
+        return true;
+    }
+
+    _visible = intersectAABBFrustum( boundingBox, Camera::frustrum );
+    if( !_visible )
+    {
+        Engine::statistics.particleSystemsCulled++;
+        return false;
+    }
+
+    // importance is a part of screen height covered by bounding sphere
+    Vector center = ( boundingBox->inf + boundingBox->sup ) * 0.5f;
+    Vector extent = boundingBox->sup - center;
+    Vector distanceV = center - Camera::eyePos;
+    float  radius = D3DXVec3Length( &extent );
+    float  distance = D3DXVec3Length( &distanceV );
+    if( distance <= radius )
+    {
+        _importance = 1.0f;
+    }
+    else
+    {
+        float screenSize = radius / ( distance * tan( D3DXToRadian( Camera::fov * 0.5f ) ) );
+        _importance = screenSize / ParticleBudget::_fullScreenSize;
+        if( _importance > 1.0f ) _importance = 1.0f;
+    }
+    return true;
+}
+
+unsigned int ParticleBudget::Client::schedule(float dt, float* step)
+{
+    _pendingTime += dt;
+
+    if( !ParticleBudget::_enabled )
+    {
+        *step = _pendingTime;
+        _pendingTime = 0.0f;
+        return 1;
+    }
+
+    // invisible systems are simulated coarsely,
+    // visible systems are simulated less frequently as their screen size decreases
+    float interval = ParticleBudget::_coarseInterval;
+    if( isVisible() )
+    {
+        float factor = 1.0f - _importance;
+        interval = ParticleBudget::_coarseInterval * 0.25f * factor * factor;
+    }
+    if( _pendingTime < interval )
+    {
+        _numSkipped++;
+        Engine::statistics.particleUpdatesSkipped++;
+        *step = 0.0f;
+        return 0;
+    }
+
+    // visible system catches up postponed time by fine steps
+    unsigned int numSteps = 1;
+    if( isVisible() && _pendingTime > ParticleBudget::_maxStep )
+    {
+        numSteps = unsigned int( ceil( _pendingTime / ParticleBudget::_maxStep ) );
+        if( numSteps > maxCatchUpSteps ) numSteps = maxCatchUpSteps;
+    }
+    *step = _pendingTime / numSteps;
+    _pendingTime = 0.0f;
+    return numSteps;
+}
+
+float ParticleBudget::Client::getEmissionScale(void)
+{
+    if( !ParticleBudget::_enabled ) return 1.0f;
+
+    float minScale = ParticleBudget::_minEmissionScale;
+    float scale = ( minScale + ( 1.0f - minScale ) * getImportance() ) * ParticleBudget::_globalScale;
+    return ( scale < minScale ) ? minScale : scale;
+}
+
+void ParticleBudget::Client::beginUpdate(void)
+{
+    QueryPerformanceCounter( &_updateStart );
+}
+
+void ParticleBudget::Client::endUpdate(unsigned int numParticles)
+{
+    LARGE_INTEGER updateEnd;
+    QueryPerformanceCounter( &updateEnd );
+    _updateTime += double( updateEnd.QuadPart - _updateStart.QuadPart ) / double( ParticleBudget::_frequency.QuadPart );
+    _numUpdates++;
+    _numParticles += numParticles;
+
+    ParticleBudget::_frameParticles += numParticles;
+    Engine::statistics.particleUpdates++;
+    Engine::statistics.particlesSimulated += numParticles;
+}
@@ -0,0 +1,89 @@
+/**
+ * This source code is a part of D3 game project.
+ * (c) Digital Dimension Development, 2004-2005
+ *
+ * @description particle budget: scales emission & simulation of particle systems
+ *              by their screen importance
+ * @author bad3p
+ */
+
+#ifndef PARTICLE_BUDGET_IMPLEMENTATION_INCLUDED
+#define PARTICLE_BUDGET_IMPLEMENTATION_INCLUDED
+
+#include "headers.h"
+#include "engine.h"
+#include "fundamentals.h"
+
+/**
+ * each particle system owns a client of the budget; the client is evaluated
+ * when the system is rendered (screen size by current camera, frustrum visibility
+ * and distance), and the result is used by the next simulation of system:
+ *
+ *  - emission scale shrinks with importance, and with the global scale, which
+ *    keeps the total number of simulated particles under configured limit;
+ *  - systems which weren't visible at last frame are simulated coarsely,
+ *    with time accumulated between coarse steps; simulation time remained
+ *    is simulated by fine steps as soon as system becomes visible again;
+ *  - each client accumulates its own simulation cost, which is logged when
+ *    system is destroyed (if "logCost" is enabled in configuration)
+ */
+
+class ParticleBudget
+{
+public:
+    class Client
+    {
+    private:
+        friend class ParticleBudget;
+    private:
+        std::string    _name;             // for cost reports
+        float          _importance;       // [0..1], by last evaluation
+        bool           _visible;          // frustrum visibility by last evaluation
+        unsigned int   _evaluationFrameId; // frame of last evaluation
+        float          _pendingTime;      // time accumulated for simulation
+        LARGE_INTEGER  _updateStart;      // cost measurement
+        unsigned int   _numUpdates;       // simulation steps
+        unsigned int   _numSkipped;       // postponed simulations
+        unsigned int   _numParticles;     // particles processed by simulation steps
+        double         _updateTime;       // simulation time, in seconds
+    public:
+        Client(const char* name);
+        ~Client();
+    public:
+        // rendering : evaluates importance of system bounded by given box,
+        // returns false if system is out of current camera frustrum
+        bool evaluate(AABB* boundingBox);
+        // simulation : accumulates dt and returns number of simulation steps
+        // to be done right now (possibly zero), with the length of each step
+        unsigned int schedule(float dt, float* step);
+        // simulation : scale of emission rate / number of rendered particles
+        float getEmissionScale(void);
+        // simulation : cost measurement of single step
+        void beginUpdate(void);
+        void endUpdate(unsigned int numParticles);
+    public:
+        // module locals : inlines
+        inline bool isVisible(void) { return _visible && ( _evaluationFrameId + 1 >= ParticleBudget::_frameId ); }
+        inline float getImportance(void) { return isVisible() ? _importance : 0.0f; }
+    };
+private:
+    static bool          _enabled;          // (setup) budget is active
+    static bool          _logCost;          // (setup) report cost of destroyed systems
+    static float         _fullScreenSize;   // (setup) screen fraction of system rendered at full quality
+    static float         _minEmissionScale; // (setup) limit of emission scaling
+    static float         _coarseInterval;   // (setup) simulation interval of invisible systems
+    static float         _maxStep;          // (setup) limit of simulation step of visible systems
+    static unsigned int  _maxParticles;     // (setup) limit of particles simulated per frame
+    static unsigned int  _frameId;          // current frame
+    static unsigned int  _frameParticles;   // particles simulated during current frame
+    static float         _globalScale;      // emission scale by total number of simulated particles
+    static LARGE_INTEGER _frequency;        // performance counter frequency
+public:
+    // initialization & etc.
+    static void init(void);
+    static void term(void);
+    // frame marker
+    static void beginFrame(void);
+};
+
+#endif
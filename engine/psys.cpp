@@ -1,6 +1,7 @@
 
 #include "headers.h"
 #include "psys.h"
+#include "transient.h"
 
 const DWORD particleFVF = D3DFVF_XYZ | D3DFVF_DIFFUSE | D3DFVF_TEX1;
 
@@ -32,7 +33,8 @@ ParticleSystem::AlphaSorter::~AlphaSorter()
  * class implementation
  */
 
-ParticleSystem::ParticleSystem(unsigned int numParticles, Shader* shader, float alphaSortDepth)
+ParticleSystem::ParticleSystem(unsigned int numParticles, Shader* shader, float alphaSortDepth) :
+    _budget( shader ? shader->getName() : NULL )
 {
     assert( numParticles );
     assert( shader );
@@ -57,32 +59,13 @@ ParticleSystem::ParticleSystem(unsigned int numParticles, Shader* shader, float
     _alphaSortDepth = alphaSortDepth;
     if( _alphaSortDepth > 0 ) _alphaSorter = new AlphaSorter( _numParticles );
 
-    // DirectX interfaces
-    // WORD is size of index (16 bits), 6 is number of indices per one particle
-    _dxCR( iDirect3DDevice->CreateIndexBuffer(
-        sizeof(WORD) * 6 * _numParticles,
-        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC, 
-        D3DFMT_INDEX16,
-        D3DPOOL_DEFAULT, 
-        &_indexBuffer,
-        NULL
-    ) );
-
-    // 4 is number of vertices per one particle
-    _dxCR( iDirect3DDevice->CreateVertexBuffer(
-        sizeof(ParticleVertex) * 4 * _numParticles,
-        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC,
-        particleFVF,
-        D3DPOOL_DEFAULT,
-        &_vertexBuffer,
-        NULL
-    ) );
+    // vertices & indices are allocated in transient buffer
+    assert( 4 * _numParticles <= TransientBuffer::getMaxVertices( sizeof(ParticleVertex) ) );
+    assert( 6 * _numParticles <= TransientBuffer::getMaxIndices() );
 }
 
 ParticleSystem::~ParticleSystem()
 {
-    _dxCR( _indexBuffer->Release() );
-    _dxCR( _vertexBuffer->Release() );
     if( _alphaSorter ) delete _alphaSorter;
     delete[] _particles;
 }
@@ -120,40 +103,60 @@ void ParticleSystem::setAmbient(Vector4f color)
 
 void ParticleSystem::render(void)
 {
-    // update number of active particles
+    // update number of active particles & bound them
     _numActiveParticles = 0;
 	unsigned int i;
-    for( i=0; i<_numParticles; i++ ) if( _particles[i].visible ) _numActiveParticles++;
+    float maxSize = 0.0f;
+    for( i=0; i<_numParticles; i++ ) if( _particles[i].visible ) 
+    {
+        if( _numActiveParticles == 0 ) 
+        {
+            _boundingBox = AABB( wrap( _particles[i].position ) );
+        }
+        else
+        {
+            _boundingBox.addPoint( wrap( _particles[i].position ) );
+        }
+        if( _particles[i].size[0] > maxSize ) maxSize = _particles[i].size[0];
+        if( _particles[i].size[1] > maxSize ) maxSize = _particles[i].size[1];
+        _numActiveParticles++;
+    }
     
     // break rendering if nothing to render
     if( !_numActiveParticles ) return;
 
+    // break rendering if system is out of frustrum
+    _boundingBox.inf -= Vector( maxSize, maxSize, maxSize );
+    _boundingBox.sup += Vector( maxSize, maxSize, maxSize );
+    if( !_budget.evaluate( &_boundingBox ) ) return;
+
+    // particles of static system aren't emitted by engine, so emission scale 
+    // of unimportant system is applied to density: each n-th particle is rendered,
+    // particles are chosen by index, so the same ones are rendered in each frame
+    unsigned int stride = unsigned int( 1.0f / _budget.getEmissionScale() );
+    if( stride < 1 ) stride = 1;
+
     // alpha-sorting
     if( _alphaSorter != NULL ) alphaSortParticles();
 
-    // lock buffers
-    void* vertexData = NULL;
-    void* indexData = NULL;
-    _dxCR( _vertexBuffer->Lock( 0, _numActiveParticles * 4 * sizeof( ParticleVertex ), &vertexData, D3DLOCK_DISCARD ) );
-    _dxCR( _indexBuffer->Lock( 0, _numActiveParticles * 6 * sizeof( WORD ), &indexData, D3DLOCK_DISCARD ) );
-    assert( vertexData );
-    assert( indexData );
-
-    // make more useful pointers
-    ParticleVertex* vertex = (ParticleVertex*)( vertexData );
-    WORD* index = (WORD*)( indexData );
+    // allocate transient geometry
+    unsigned int baseVertex;
+    unsigned int baseIndex;
+    ParticleVertex* vertex = (ParticleVertex*)( TransientBuffer::lockVertices( sizeof( ParticleVertex ), _numActiveParticles * 4, &baseVertex ) );
+    WORD* index = TransientBuffer::lockIndices( _numActiveParticles * 6, &baseIndex );
 
     // build primitives
     unsigned int j;
+    unsigned int particleId = 0;
     if( _alphaSorter )
     {
-        unsigned int particleId = 0;
         unsigned char* nestSize;
         for( i=0; i<256; i++ )
         {
             nestSize = _alphaSorter->nestSize + i;
             for( j=0; j<*nestSize; j++ )
             {
+                if( _alphaSorter->nest[i][j] % stride ) continue;
                 buildPrimitive( _particles + _alphaSorter->nest[i][j], vertex, index, particleId );
                 particleId++;
                 vertex += 4;
@@ -163,10 +166,9 @@ void ParticleSystem::render(void)
     }
     else
     {
-        unsigned int particleId = 0;
         for( i=0; i<_numParticles; i++ )
         {
-            if( _particles[i].visible )
+            if( _particles[i].visible && ( i % stride ) == 0 )
             {
                 buildPrimitive( _particles + i, vertex, index, particleId );
                 particleId++;
@@ -176,9 +178,10 @@ void ParticleSystem::render(void)
         }
     }
 
-    // unlock buffers
-    _vertexBuffer->Unlock();
-    _indexBuffer->Unlock();
+    // unlock buffers (particles left unsorted are not rendered)
+    TransientBuffer::unlockVertices( particleId * 4 );
+    TransientBuffer::unlockIndices( particleId * 6 );
+    if( !particleId ) return;
 
     // render
     _dxCR( dxSetRenderState( D3DRS_LIGHTING, FALSE ) );
@@ -193,9 +196,8 @@ void ParticleSystem::render(void)
 
     _dxCR( iDirect3DDevice->SetTransform( D3DTS_WORLD, &identity ) );
     _dxCR( iDirect3DDevice->SetFVF( particleFVF ) );
-    _dxCR( iDirect3DDevice->SetStreamSource( 0, _vertexBuffer, 0, sizeof( ParticleVertex ) ) );
-    _dxCR( iDirect3DDevice->SetIndices( _indexBuffer ) );
-    _dxCR( iDirect3DDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, 0, 0, _numActiveParticles * 4, 0, _numActiveParticles * 2 ) );
+    TransientBuffer::setStreams( sizeof( ParticleVertex ) );
+    _dxCR( iDirect3DDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, baseVertex, 0, particleId * 4, baseIndex, particleId * 2 ) );
 
     _dxCR( dxSetRenderState( D3DRS_ZWRITEENABLE, TRUE ) );
     _dxCR( dxSetRenderState( D3DRS_LIGHTING, TRUE ) );
@@ -242,34 +244,4 @@ void ParticleSystem::alphaSortParticles(void)
         _alphaSorter->nest[key][*nestSize] = _alphaSorter->unsortedIndices[i];
         (*nestSize)++;
     }
-}
-
-void ParticleSystem::onLostDevice(void)
-{
-    _indexBuffer->Release();
-    _vertexBuffer->Release();
-}
-
-void ParticleSystem::onResetDevice(void)
-{
-    // DirectX interfaces
-    // WORD is size of index (16 bits), 6 is number of indices per one particle
-    _dxCR( iDirect3DDevice->CreateIndexBuffer(
-        sizeof(WORD) * 6 * _numParticles,
-        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC, 
-        D3DFMT_INDEX16,
-        D3DPOOL_DEFAULT, 
-        &_indexBuffer,
-        NULL
-    ) );
-
-    // 4 is number of vertices per one particle
-    _dxCR( iDirect3DDevice->CreateVertexBuffer(
-        sizeof(ParticleVertex) * 4 * _numParticles,
-        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC,
-        particleFVF,
-        D3DPOOL_DEFAULT,
-        &_vertexBuffer,
-        NULL
-    ) );
 }
\ No newline at end of file
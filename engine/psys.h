@@ -7,6 +7,7 @@
 #include "texture.h"
 #include "camera.h"
 #include "shader.h"
+#include "particlebudget.h"
 
 const Vector billboardVertices[4] = 
 {
@@ -16,8 +17,7 @@ const Vector billboardVertices[4] =
     Vector( 1.0f, -1.0f, 0.0f )
 };
 
-class ParticleSystem : public engine::IParticleSystem,
-                       virtual public Lostable
+class ParticleSystem : public engine::IParticleSystem
 {
 private:
     struct AlphaSorter
@@ -45,10 +45,10 @@ private:
     float                   _ambientR;
     float                   _ambientG;
     float                   _ambientB;    
-    IDirect3DVertexBuffer9* _vertexBuffer;
-    IDirect3DIndexBuffer9*  _indexBuffer;
     float                   _alphaSortDepth;
     AlphaSorter*            _alphaSorter;
+    ParticleBudget::Client  _budget;
+    AABB                    _boundingBox;
 private:
     // for primitive builder
     Matrix  _matrix;
@@ -138,9 +138,6 @@ public:
     virtual engine::Particle* __stdcall getParticles(void);
     virtual Vector4f __stdcall getAmbient(void);
     virtual void __stdcall setAmbient(Vector4f color);    
-    // Lostable
-    virtual void onLostDevice(void);
-    virtual void onResetDevice(void);
 public:
     // local methods
     void render(void);
@@ -6,6 +6,7 @@
 #include "ixml.h"
 #include "../common/istring.h"
 #include "wire.h"
+#include "transient.h"
 
 Rain::RainL Rain::_rainL;
 
@@ -49,27 +50,6 @@ Rain::Rain(unsigned int maxParticles, float emissionSphere, engine::ITexture* te
     _ambient = wrap( ambient );
     memset( _particles, 0, sizeof(RainParticle) * _numParticles );
 
-    // create rendering resources
-    // WORD is size of index (16 bits), 6 is number of indices per one particle
-    _dxCR( iDirect3DDevice->CreateIndexBuffer(
-        sizeof(WORD) * 6 * maxParticlesPerPass,
-        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC, 
-        D3DFMT_INDEX16,
-        D3DPOOL_DEFAULT, 
-        &_indexBuffer,
-        NULL
-    ) );
-
-    // 4 is number of vertices per one particle
-    _dxCR( iDirect3DDevice->CreateVertexBuffer(
-        sizeof(RainParticleVertex) * 4 * maxParticlesPerPass,
-        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC,
-        particleFVF,
-        D3DPOOL_DEFAULT,
-        &_vertexBuffer,
-        NULL
-    ) );
-
     // create shader
     _shader = dynamic_cast<Shader*>( Engine::instance->createShader( 1, "RainShader" ) );
     _shader->_numReferences++;
@@ -107,8 +87,6 @@ Rain::Rain(unsigned int maxParticles, float emissionSphere, engine::ITexture* te
 Rain::~Rain()
 {
     _shader->release();
-    _indexBuffer->Release();
-    _vertexBuffer->Release();
     delete[] _particles;
 
     for( RainI rainI=_rainL.begin(); rainI!=_rainL.end(); rainI++ )
@@ -206,15 +184,11 @@ void Rain::render(void)
     // culling value
     float cullDot = cos( Camera::fov * D3DX_PI / 180.0f );
 
-    // lock buffers
-    void* vertexData = NULL;
-    void* indexData = NULL;
-    _dxCR( _vertexBuffer->Lock( 0, _numParticles * 4 * sizeof( RainParticleVertex ), &vertexData, D3DLOCK_DISCARD ) );
-    _dxCR( _indexBuffer->Lock( 0, _numParticles * 6 * sizeof( WORD ), &indexData, D3DLOCK_DISCARD ) );
-    assert( vertexData );
-    assert( indexData );
-    RainParticleVertex* vertex = (RainParticleVertex*)( vertexData );
-    WORD* index = (WORD*)( indexData );
+    // allocate transient geometry
+    unsigned int baseVertex;
+    unsigned int baseIndex;
+    RainParticleVertex* vertex = (RainParticleVertex*)( TransientBuffer::lockVertices( sizeof( RainParticleVertex ), _numParticles * 4, &baseVertex ) );
+    WORD* index = TransientBuffer::lockIndices( _numParticles * 6, &baseIndex );
 
     // render particles
     RainParticle* particle;
@@ -282,8 +256,9 @@ void Rain::render(void)
     }
 
     // unlock buffers
-    _vertexBuffer->Unlock();
-    _indexBuffer->Unlock();
+    TransientBuffer::unlockVertices( numVisibleParticles * 4 );
+    TransientBuffer::unlockIndices( numVisibleParticles * 6 );
+    if( numVisibleParticles == 0 ) return;
 
     // render buffers
     // render
@@ -299,9 +274,8 @@ void Rain::render(void)
 
     _dxCR( iDirect3DDevice->SetTransform( D3DTS_WORLD, &identity ) );
     _dxCR( iDirect3DDevice->SetFVF( particleFVF ) );
-    _dxCR( iDirect3DDevice->SetStreamSource( 0, _vertexBuffer, 0, sizeof( RainParticleVertex ) ) );
-    _dxCR( iDirect3DDevice->SetIndices( _indexBuffer ) );
-    _dxCR( iDirect3DDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, 0, 0, numVisibleParticles * 4, 0, numVisibleParticles * 2 ) );
+    TransientBuffer::setStreams( sizeof( RainParticleVertex ) );
+    _dxCR( iDirect3DDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, baseVertex, 0, numVisibleParticles * 4, baseIndex, numVisibleParticles * 2 ) );
 
     _dxCR( dxSetRenderState( D3DRS_ZWRITEENABLE, TRUE ) );
     _dxCR( dxSetRenderState( D3DRS_LIGHTING, TRUE ) ); 
@@ -430,34 +404,4 @@ void Rain::update(float dt)
     {
         (*rainI)->onUpdate( dt );
     }
-}
-
-void Rain::onLostDevice(void)
-{
-    _indexBuffer->Release();
-    _vertexBuffer->Release();
-}
-
-void Rain::onResetDevice(void)
-{
-    // create rendering resources
-    // WORD is size of index (16 bits), 6 is number of indices per one particle
-    _dxCR( iDirect3DDevice->CreateIndexBuffer(
-        sizeof(WORD) * 6 * maxParticlesPerPass,
-        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC, 
-        D3DFMT_INDEX16,
-        D3DPOOL_DEFAULT, 
-        &_indexBuffer,
-        NULL
-    ) );
-
-    // 4 is number of vertices per one particle
-    _dxCR( iDirect3DDevice->CreateVertexBuffer(
-        sizeof(RainParticleVertex) * 4 * maxParticlesPerPass,
-        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC,
-        particleFVF,
-        D3DPOOL_DEFAULT,
-        &_vertexBuffer,
-        NULL
-    ) );
 }
\ No newline at end of file
@@ -26,8 +26,7 @@ public:
  * rain rendering
  */
 
-class Rain : public Rendering,
-             virtual public Lostable
+class Rain : public Rendering
 {
 private:
     typedef std::list<Rain*> RainL;
@@ -37,8 +36,6 @@ private:
 private:
     Color                   _ambient;      // particle's ambient color
     Shader*                 _shader;       // shading technique
-    IDirect3DVertexBuffer9* _vertexBuffer; // vertex buffer
-    IDirect3DIndexBuffer9*  _indexBuffer;  // index buffer
 private:
     float         _emissionSphere; // actual sphere of rain emission
     unsigned int  _numParticles;   // number of particles
@@ -64,9 +61,6 @@ public:
     virtual void __stdcall setProperty(const char* propertyName, const Matrix4f& value);
     virtual void __stdcall setProperty(const char* propertyName, const Vector2f& value);
     virtual void __stdcall setProperty(const char* propertyName, const Vector4f& value);    
-    // Lostable
-    virtual void onLostDevice(void);
-    virtual void onResetDevice(void);
     // Rendering
     void render(void);
 public:
@@ -123,6 +123,7 @@ private:
     friend class Emitter;
     friend class Geometry;
     friend class BSP;
+    friend class SpriteBatch;
 private:
     int                   _numReferences;
     std::string           _name;
@@ -6,6 +6,7 @@
 #include "ixml.h"
 #include "../common/istring.h"
 #include "wire.h"
+#include "transient.h"
 
 const DWORD particleFVF = D3DFVF_XYZ | D3DFVF_DIFFUSE | D3DFVF_TEX1;
 
@@ -22,7 +23,8 @@ engine::IRendering* Engine::createSmokeTrail(engine::IShader* shader, engine::Sm
  * class implementation
  */
 
-SmokeTrail::SmokeTrail(engine::IShader* shader, engine::SmokeTrailScheme* scheme)
+SmokeTrail::SmokeTrail(engine::IShader* shader, engine::SmokeTrailScheme* scheme) :
+    _budget( shader ? shader->getName() : NULL )
 {
     assert( shader );
     assert( scheme->numParticles ); 
@@ -39,29 +41,9 @@ SmokeTrail::SmokeTrail(engine::IShader* shader, engine::SmokeTrailScheme* scheme
     _uvs[2] = wrap( _scheme.uv[2] );
     _uvs[3] = wrap( _scheme.uv[3] );
 
-    // create rendering resources
-    // WORD is size of index (16 bits), 6 is number of indices per one particle
-    _dxCR( iDirect3DDevice->CreateIndexBuffer(
-        sizeof(WORD) * 6 * _scheme.numParticles,
-        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC, 
-        D3DFMT_INDEX16,
-        D3DPOOL_DEFAULT, 
-        &_indexBuffer,
-        NULL
-    ) );
-
-    // 4 is number of vertices per one particle
-    _dxCR( iDirect3DDevice->CreateVertexBuffer(
-        sizeof(ParticleVertex) * 4 * _scheme.numParticles,
-        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC,
-        particleFVF,
-        D3DPOOL_DEFAULT,
-        &_vertexBuffer,
-        NULL
-    ) );
-
     _enabled = false;
     _emissionPoint.x = 0, _emissionPoint.y = 0, _emissionPoint.z = 0;
+    _updatePoint = _emissionPoint;
     _emissionDirection.x = 0, _emissionDirection.y = 0, _emissionDirection.z = 0;
     _windVelocity.x = 0, _windVelocity.y = 0, _windVelocity.z = 0;
     _emitterVelocity.x = 0, _emitterVelocity.y = 0, _emitterVelocity.z = 0;
@@ -69,8 +51,6 @@ SmokeTrail::SmokeTrail(engine::IShader* shader, engine::SmokeTrailScheme* scheme
 
 SmokeTrail::~SmokeTrail()
 {
-    _indexBuffer->Release();
-    _vertexBuffer->Release();
 }
 
 /**
@@ -100,15 +80,15 @@ static const Flector billboardUVs[4] =
 
 void SmokeTrail::render(void)
 {
-    // lock buffers
-    void* vertexData = NULL;
-    void* indexData = NULL;
-    _dxCR( _vertexBuffer->Lock( 0, _scheme.numParticles * 4 * sizeof( ParticleVertex ), &vertexData, D3DLOCK_DISCARD ) );
-    _dxCR( _indexBuffer->Lock( 0, _scheme.numParticles * 6 * sizeof( WORD ), &indexData, D3DLOCK_DISCARD ) );
-    assert( vertexData );
-    assert( indexData );
-    ParticleVertex* vertex = (ParticleVertex*)( vertexData );
-    WORD* index = (WORD*)( indexData );
+    // evaluate importance for next update, skip invisible trail
+    if( _particles.empty() ) _boundingBox = AABB( _emissionPoint );
+    if( !_budget.evaluate( &_boundingBox ) ) return;
+
+    // allocate transient geometry
+    unsigned int baseVertex;
+    unsigned int baseIndex;
+    ParticleVertex* vertex = (ParticleVertex*)( TransientBuffer::lockVertices( sizeof( ParticleVertex ), _scheme.numParticles * 4, &baseVertex ) );
+    WORD* index = TransientBuffer::lockIndices( _scheme.numParticles * 6, &baseIndex );
 
     // fill buffers
     Vector fromPos, toPos;
@@ -218,8 +198,8 @@ void SmokeTrail::render(void)
     }
 
     // unlock buffers
-    _vertexBuffer->Unlock();
-    _indexBuffer->Unlock();
+    TransientBuffer::unlockVertices( numVisibleParticles * 4 );
+    TransientBuffer::unlockIndices( numVisibleParticles * 6 );
 
     if( numVisibleParticles == 0 ) return;
 
@@ -253,9 +233,8 @@ void SmokeTrail::render(void)
 
     _dxCR( iDirect3DDevice->SetTransform( D3DTS_WORLD, &identity ) );
     _dxCR( iDirect3DDevice->SetFVF( particleFVF ) );
-    _dxCR( iDirect3DDevice->SetStreamSource( 0, _vertexBuffer, 0, sizeof( ParticleVertex ) ) );
-    _dxCR( iDirect3DDevice->SetIndices( _indexBuffer ) );
-    _dxCR( iDirect3DDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, 0, 0, numVisibleParticles * 4, 0, numVisibleParticles * 2 ) );
+    TransientBuffer::setStreams( sizeof( ParticleVertex ) );
+    _dxCR( iDirect3DDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, baseVertex, 0, numVisibleParticles * 4, baseIndex, numVisibleParticles * 2 ) );
 
     _dxCR( dxSetRenderState( D3DRS_ZWRITEENABLE, TRUE ) );
     _dxCR( dxSetRenderState( D3DRS_LIGHTING, TRUE ) ); 
@@ -272,6 +251,13 @@ void SmokeTrail::setProperty(const char* propertyName, float value)
         // update emission
         update( value );
     }
+    else if( strcmp( propertyName, "reset" ) == 0 )
+    {
+        // discard emitted particles & stop emission, so trail can be reused
+        _particles.clear();
+        _enabled = false;
+        _boundingBox = AABB( _emissionPoint );
+    }
     else
     {
         assert( !"Unexpected property for SmokeTrail object!" );
@@ -328,6 +314,29 @@ void SmokeTrail::update(float dt)
 {
     if( !_enabled ) return;
 
+    // particle budget postpones updates of unimportant trails,
+    // and splits postponed time by fine steps
+    float step;
+    unsigned int numSteps = _budget.schedule( dt, &step );
+    if( !numSteps ) return;
+
+    // emitter has moved since last update, each step emits along its part of the way
+    Vector startPoint = _particles.size() ? _updatePoint : _emissionPoint;
+    Vector stepPoint;
+    _budget.beginUpdate();
+    for( unsigned int i=0; i<numSteps; i++ )
+    {
+        simulate( step );
+        D3DXVec3Lerp( &stepPoint, &startPoint, &_emissionPoint, float( i + 1 ) / numSteps );
+        emit( stepPoint, step );
+    }
+    _updatePoint = _emissionPoint;
+    updateBoundingBox();
+    _budget.endUpdate( numSteps * _particles.size() );
+}
+
+void SmokeTrail::simulate(float dt)
+{
     Vector windDirection;
     D3DXVec3Normalize( &windDirection, &_windVelocity );
     windDirection *= -1;
@@ -339,8 +348,6 @@ void SmokeTrail::update(float dt)
     Vector heatAcceleration;
     float windDirectionVelocity;
     float windAccelerationFactor;
-	TrailParticleI lastParticleI = _particles.begin();
-	float lastParticleI_lifeTime = -1;
     for( TrailParticleI particleI = _particles.begin(); 
                         particleI != _particles.end(); 
                         particleI++ )
@@ -369,81 +376,81 @@ void SmokeTrail::update(float dt)
         // simulate damping force
         dampingAcceleration = -particleI->velocity * _scheme.damping;
         particleI->velocity += dampingAcceleration * dt;
-
-		// save last particle iterator
-		lastParticleI = particleI;
-		lastParticleI_lifeTime = particleI->lifeTime;
     }
 
-    // remove scattered particles
-    if( lastParticleI_lifeTime > _scheme.lifeTime )
+    // remove scattered particles (the oldest are at the back,
+    // several of them may expire during the long step)
+    while( _particles.size() && _particles.back().lifeTime > _scheme.lifeTime )
     {
-        _particles.erase( lastParticleI );
+        _particles.pop_back();
     }
+}
 
-    // determine fission conditions
-    bool fissionByAlgorithm = ( _particles.size() == 0 );
-    bool fissionByDistance = false;
-    if( !fissionByAlgorithm ) 
+void SmokeTrail::emit(const Vector& emissionPoint, float dt)
+{
+    // first particle
+    if( _particles.size() == 0 )
     {
-        float fissionDistance = _scheme.fissionLERP.getSaturatedValue( D3DXVec3Length( &_emitterVelocity ) );
-        Vector lastParticleDistance = ( _particles.begin()->position - _emissionPoint );
-        fissionByDistance = ( D3DXVec3Length( &lastParticleDistance ) >= fissionDistance );
+        addParticle( emissionPoint, 0.0f );
+        return;
     }
 
-    // emit particle
-    if( fissionByAlgorithm || fissionByDistance )
+    // unimportant trails are emitted sparsely
+    float fissionDistance = _scheme.fissionLERP.getSaturatedValue( D3DXVec3Length( &_emitterVelocity ) );
+    fissionDistance /= _budget.getEmissionScale();
+    Vector lastParticlePosition = _particles.begin()->position;
+    Vector way = emissionPoint - lastParticlePosition;
+    float distance = D3DXVec3Length( &way );
+    if( distance < fissionDistance ) return;
+
+    // emitter may pass several fission distances during the step, 
+    // so particles are placed along the way (earlier ones are older)
+    unsigned int numParticles = ( fissionDistance > 0 ) ? unsigned int( distance / fissionDistance ) : 1;
+    if( numParticles > _scheme.numParticles ) numParticles = _scheme.numParticles;
+    for( unsigned int i=1; i<=numParticles; i++ )
     {
-        // handle overload
-        if( _particles.size() == _scheme.numParticles )
-        {
-            TrailParticleI lastParticleI = _particles.end();
-            lastParticleI--;
-            _particles.erase( lastParticleI );
-        }
-        // add new particle
-        _particles.push_front( 
-            TrailParticle( 
-                _emissionPoint,
-                _emissionDirection + _emitterVelocity,
-                0.0f,
-                _scheme.sizeTimeLERP.getSaturatedValue( D3DXVec3Length( &_emitterVelocity ) ),
-                _scheme.startSizeLERP.getSaturatedValue( D3DXVec3Length( &_emitterVelocity ) ),
-                _scheme.endSizeLERP.getSaturatedValue( D3DXVec3Length( &_emitterVelocity ) ),
-                _ambientR,
-                _ambientG,
-                _ambientB
-            )
-        );
+        float factor = float( i ) / numParticles;
+        addParticle( lastParticlePosition + way * factor, dt * ( 1.0f - factor ) );
     }
 }
 
-void SmokeTrail::onLostDevice(void)
+void SmokeTrail::addParticle(const Vector& position, float lifeTime)
 {
-    _indexBuffer->Release();
-    _vertexBuffer->Release();
+    // handle overload
+    if( _particles.size() == _scheme.numParticles )
+    {
+        TrailParticleI lastParticleI = _particles.end();
+        lastParticleI--;
+        _particles.erase( lastParticleI );
+    }
+    // add new particle
+    _particles.push_front( 
+        TrailParticle( 
+            position,
+            _emissionDirection + _emitterVelocity,
+            lifeTime,
+            _scheme.sizeTimeLERP.getSaturatedValue( D3DXVec3Length( &_emitterVelocity ) ),
+            _scheme.startSizeLERP.getSaturatedValue( D3DXVec3Length( &_emitterVelocity ) ),
+            _scheme.endSizeLERP.getSaturatedValue( D3DXVec3Length( &_emitterVelocity ) ),
+            _ambientR,
+            _ambientG,
+            _ambientB
+        )
+    );
 }
 
-void SmokeTrail::onResetDevice(void)
+void SmokeTrail::updateBoundingBox(void)
 {
-    // create rendering resources
-    // WORD is size of index (16 bits), 6 is number of indices per one particle
-    _dxCR( iDirect3DDevice->CreateIndexBuffer(
-        sizeof(WORD) * 6 * _scheme.numParticles,
-        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC, 
-        D3DFMT_INDEX16,
-        D3DPOOL_DEFAULT, 
-        &_indexBuffer,
-        NULL
-    ) );
-
-    // 4 is number of vertices per one particle
-    _dxCR( iDirect3DDevice->CreateVertexBuffer(
-        sizeof(ParticleVertex) * 4 * _scheme.numParticles,
-        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC,
-        particleFVF,
-        D3DPOOL_DEFAULT,
-        &_vertexBuffer,
-        NULL
-    ) );
+    _boundingBox = AABB( _emissionPoint );
+    float maxSize = 0.0f;
+    for( TrailParticleI particleI = _particles.begin(); 
+                        particleI != _particles.end(); 
+                        particleI++ )
+    {
+        _boundingBox.addPoint( particleI->position );
+        if( particleI->startSize > maxSize ) maxSize = particleI->startSize;
+        if( particleI->endSize > maxSize ) maxSize = particleI->endSize;
+    }
+    _boundingBox.inf -= Vector( maxSize, maxSize, maxSize );
+    _boundingBox.sup += Vector( maxSize, maxSize, maxSize );
 }
\ No newline at end of file
@@ -10,13 +10,13 @@
 #include "shader.h"
 #include "../common/istring.h"
 #include "rendering.h"
+#include "particlebudget.h"
 
 /**
  * smoketrail rendering
  */
 
-class SmokeTrail : public Rendering,
-                   virtual public Lostable
+class SmokeTrail : public Rendering
 {
 private:
     struct TrailParticle
@@ -66,14 +66,19 @@ private:
     TrailParticles           _particles;         // list of particles
     bool                     _enabled;           // if true, emission will take place
     Vector                   _emissionPoint;     // current emission point
+    Vector                   _updatePoint;       // emission point of last update
     Vector                   _emissionDirection; // current emission velocity vector
     Vector                   _windVelocity;      // current wind velocity    
     Vector                   _emitterVelocity;   // emitter velocity
+    ParticleBudget::Client   _budget;            // importance & simulation schedule
+    AABB                     _boundingBox;       // bound of particles, by last update
 private:
-    IDirect3DVertexBuffer9* _vertexBuffer; // vertex buffer
-    IDirect3DIndexBuffer9*  _indexBuffer;  // index buffer
 private:
     void update(float dt);
+    void simulate(float dt);
+    void emit(const Vector& emissionPoint, float dt);
+    void addParticle(const Vector& position, float lifeTime);
+    void updateBoundingBox(void);
 public:
     // class implementation
     SmokeTrail(engine::IShader* shader, engine::SmokeTrailScheme* scheme);
@@ -87,9 +92,6 @@ public:
     virtual void __stdcall setProperty(const char* propertyName, const Matrix4f& value);
     // Rendering
     virtual void render(void);
-    // Lostable
-    virtual void onLostDevice(void);
-    virtual void onResetDevice(void);
 };
 
 #endif
\ No newline at end of file
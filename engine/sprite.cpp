@@ -2,6 +2,9 @@
 #include "headers.h"
 #include "sprite.h"
 #include "engine.h"
+#include "transient.h"
+#include "camera.h"
+#include "shader.h"
 
 /**
  * rectangle rendering
@@ -31,6 +34,168 @@ void dxRenderRect(
         (float)left,         (float)top + height, 0.0f, 1.0f, color, 0.0f, 1.0f,
     };
 
+    unsigned int baseVertex;
+    void* vertexData = TransientBuffer::lockVertices( sizeof(ScreenVertex), 4, &baseVertex );
+    memcpy( vertexData, vertices, sizeof(vertices) );
+    TransientBuffer::unlockVertices( 4 );
+
     iDirect3DDevice->SetFVF( screenFVF );
-    iDirect3DDevice->DrawPrimitiveUP( D3DPT_TRIANGLEFAN, 2, vertices, sizeof(ScreenVertex) );
+    iDirect3DDevice->SetStreamSource( 0, TransientBuffer::getVertexBuffer(), 0, sizeof(ScreenVertex) );
+    iDirect3DDevice->DrawPrimitive( D3DPT_TRIANGLEFAN, baseVertex, 2 );
+}
+/**
+ * sprite batch
+ */
+
+struct BillboardVertex
+{
+public:
+    Vector  pos;
+    Color   color;
+    Flector uv;
+};
+
+const DWORD billboardFVF = D3DFVF_XYZ | D3DFVF_DIFFUSE | D3DFVF_TEX1;
+
+SpriteBatcher SpriteBatch::_batcher;
+
+void SpriteBatch::addBillboard(Texture* texture, D3DBLEND srcBlend, D3DBLEND destBlend, const Vector& position, const Flector& size, Color color)
+{
+    // true billboard (the same as ParticleSystem builds)
+    Vector x, y, z;
+    D3DXVec3Subtract( &z, &position, &Camera::eyePos );
+    D3DXVec3Normalize( &z, &z );
+    D3DXVec3Cross( &x, &oY, &z );
+    D3DXVec3Normalize( &x, &x );
+    D3DXVec3Cross( &y, &z, &x );
+    D3DXVec3Normalize( &y, &y );
+    x *= size.x;
+    y *= size.y;
+
+    SpriteVertex* vertex = _batcher.addQuad( SpriteKey( texture, srcBlend, destBlend, false, true ) );
+    Vector corner[4] = { position - x - y, position - x + y, position + x + y, position + x - y };
+    for( unsigned int i=0; i<4; i++ )
+    {
+        vertex[i].x = corner[i].x, vertex[i].y = corner[i].y, vertex[i].z = corner[i].z;
+        vertex[i].color = color;
+    }
+    vertex[0].u = 1, vertex[0].v = 1;
+    vertex[1].u = 1, vertex[1].v = 0;
+    vertex[2].u = 0, vertex[2].v = 0;
+    vertex[3].u = 0, vertex[3].v = 1;
+}
+
+void SpriteBatch::addRect(Texture* texture, D3DBLEND srcBlend, D3DBLEND destBlend, const Flector& center, const Flector& halfSize, Color color)
+{
+    SpriteVertex* vertex = _batcher.addQuad( SpriteKey( texture, srcBlend, destBlend, true, false ) );
+    vertex[0].x = center.x - halfSize.x, vertex[0].y = center.y - halfSize.y, vertex[0].u = 0, vertex[0].v = 0;
+    vertex[1].x = center.x + halfSize.x, vertex[1].y = center.y - halfSize.y, vertex[1].u = 1, vertex[1].v = 0;
+    vertex[2].x = center.x + halfSize.x, vertex[2].y = center.y + halfSize.y, vertex[2].u = 1, vertex[2].v = 1;
+    vertex[3].x = center.x - halfSize.x, vertex[3].y = center.y + halfSize.y, vertex[3].u = 0, vertex[3].v = 1;
+    for( unsigned int i=0; i<4; i++ )
+    {
+        vertex[i].z = 0.0f;
+        vertex[i].color = color;
+    }
+}
+
+void SpriteBatch::flush(void)
+{
+    if( !_batcher.getNumQuads() ) return;
+
+    _batcher.sort();
+
+    // common render states & texture stages
+    _dxCR( dxSetRenderState( D3DRS_LIGHTING, FALSE ) );
+    _dxCR( dxSetRenderState( D3DRS_ZWRITEENABLE, FALSE ) );
+    _dxCR( dxSetRenderState( D3DRS_ALPHABLENDENABLE, TRUE ) );
+    _dxCR( dxSetRenderState( D3DRS_BLENDOP, D3DBLENDOP_ADD ) );
+    _dxCR( dxSetTextureStageState( 0, D3DTSS_TEXCOORDINDEX, 0 ) );
+    _dxCR( dxSetTextureStageState( 0, D3DTSS_COLOROP, D3DTOP_MODULATE ) );
+    _dxCR( dxSetTextureStageState( 0, D3DTSS_COLORARG1, D3DTA_TEXTURE ) );
+    _dxCR( dxSetTextureStageState( 0, D3DTSS_COLORARG2, D3DTA_DIFFUSE ) );
+    _dxCR( dxSetTextureStageState( 0, D3DTSS_ALPHAOP, D3DTOP_MODULATE ) );
+    _dxCR( dxSetTextureStageState( 0, D3DTSS_ALPHAARG1, D3DTA_TEXTURE ) );
+    _dxCR( dxSetTextureStageState( 0, D3DTSS_ALPHAARG2, D3DTA_DIFFUSE ) );
+    _dxCR( dxSetTextureStageState( 1, D3DTSS_COLOROP, D3DTOP_DISABLE ) );
+    _dxCR( dxSetTextureStageState( 1, D3DTSS_ALPHAOP, D3DTOP_DISABLE ) );
+    _dxCR( iDirect3DDevice->SetTransform( D3DTS_WORLD, &identity ) );
+
+    for( unsigned int rangeId=0; rangeId<_batcher.getNumRanges(); rangeId++ )
+    {
+        const SpriteBatcher::Range& range = _batcher.getRange( rangeId );
+        Texture* texture = const_cast<Texture*>( reinterpret_cast<const Texture*>( range.key.texture ) );
+
+        _dxCR( dxSetRenderState( D3DRS_SRCBLEND, range.key.srcBlend ) );
+        _dxCR( dxSetRenderState( D3DRS_DESTBLEND, range.key.destBlend ) );
+        _dxCR( dxSetRenderState( D3DRS_ZENABLE, range.key.depthTest ? TRUE : FALSE ) );
+        texture->apply( 0 );
+
+        unsigned int stride = range.key.screenSpace ? sizeof( ScreenVertex ) : sizeof( BillboardVertex );
+        _dxCR( iDirect3DDevice->SetFVF( range.key.screenSpace ? screenFVF : billboardFVF ) );
+
+        // range may exceed transient buffer or 16-bit indices
+        unsigned int maxQuads = TransientBuffer::getMaxVertices( stride ) / 4;
+        maxQuads = min( maxQuads, TransientBuffer::getMaxIndices() / 6 );
+        maxQuads = min( maxQuads, unsigned int( 0x10000 / 4 ) );
+
+        for( unsigned int firstQuad=0; firstQuad<range.numQuads; firstQuad+=maxQuads )
+        {
+            unsigned int numQuads = min( maxQuads, range.numQuads - firstQuad );
+            unsigned int baseVertex;
+            unsigned int baseIndex;
+            void* vertexData = TransientBuffer::lockVertices( stride, numQuads * 4, &baseVertex );
+            WORD* index = TransientBuffer::lockIndices( numQuads * 6, &baseIndex );
+            for( unsigned int i=0; i<numQuads; i++ )
+            {
+                const SpriteVertex* quad = _batcher.getSortedQuad( range.firstQuad + firstQuad + i );
+                if( range.key.screenSpace )
+                {
+                    ScreenVertex* vertex = reinterpret_cast<ScreenVertex*>( vertexData ) + i * 4;
+                    for( unsigned int j=0; j<4; j++ )
+                    {
+                        vertex[j].x = quad[j].x, vertex[j].y = quad[j].y, vertex[j].z = quad[j].z, vertex[j].rhw = 1.0f;
+                        vertex[j].color = quad[j].color;
+                        vertex[j].tu = quad[j].u, vertex[j].tv = quad[j].v;
+                    }
+                }
+                else
+                {
+                    BillboardVertex* vertex = reinterpret_cast<BillboardVertex*>( vertexData ) + i * 4;
+                    for( unsigned int j=0; j<4; j++ )
+                    {
+                        vertex[j].pos.x = quad[j].x, vertex[j].pos.y = quad[j].y, vertex[j].pos.z = quad[j].z;
+                        vertex[j].color = quad[j].color;
+                        vertex[j].uv.x = quad[j].u, vertex[j].uv.y = quad[j].v;
+                    }
+                }
+                index[0] = i * 4 + 0;
+                index[1] = i * 4 + 1;
+                index[2] = i * 4 + 2;
+                index[3] = i * 4 + 0;
+                index[4] = i * 4 + 2;
+                index[5] = i * 4 + 3;
+                index += 6;
+            }
+            TransientBuffer::unlockVertices( numQuads * 4 );
+            TransientBuffer::unlockIndices( numQuads * 6 );
+
+            TransientBuffer::setStreams( stride );
+            _dxCR( iDirect3DDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, baseVertex, 0, numQuads * 4, baseIndex, numQuads * 2 ) );
+            Engine::statistics.spriteBatches++;
+        }
+        Engine::statistics.spriteQuads += range.numQuads;
+    }
+
+    // restore critical render states
+    _dxCR( dxSetRenderState( D3DRS_SRCBLEND, D3DBLEND_SRCALPHA ) );
+    _dxCR( dxSetRenderState( D3DRS_DESTBLEND, D3DBLEND_INVSRCALPHA ) );
+    _dxCR( dxSetRenderState( D3DRS_ZENABLE, TRUE ) );
+    _dxCR( dxSetRenderState( D3DRS_ZWRITEENABLE, TRUE ) );
+    _dxCR( dxSetRenderState( D3DRS_LIGHTING, TRUE ) );
+
+    // texture stages are changed behind the shader cache
+    Shader::_lastShader = NULL;
+
+    _batcher.clear();
 }
\ No newline at end of file
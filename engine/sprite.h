@@ -12,6 +12,8 @@
 
 #include "headers.h"
 #include "engine.h"
+#include "texture.h"
+#include "spritebatcher.h"
 
 void dxRenderRect(
     unsigned int top, unsigned int left, 
@@ -19,4 +21,23 @@ void dxRenderRect(
     Color color
 );
 
+/**
+ * sprite batch: glows & lens flares of the frame are collected by the batcher,
+ * and rendered by single draw call per texture & blending; the batch is flushed 
+ * by BSP after the renderings of scene, and after the lens flares of scene
+ */
+
+class SpriteBatch
+{
+private:
+    static SpriteBatcher _batcher;
+public:
+    // camera-oriented quad in world space, depth-tested
+    static void addBillboard(Texture* texture, D3DBLEND srcBlend, D3DBLEND destBlend, const Vector& position, const Flector& size, Color color);
+    // screen space rectangle, not depth-tested
+    static void addRect(Texture* texture, D3DBLEND srcBlend, D3DBLEND destBlend, const Flector& center, const Flector& halfSize, Color color);
+    // renders & discards collected sprites
+    static void flush(void);
+};
+
 #endif
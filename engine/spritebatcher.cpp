@@ -0,0 +1,87 @@
+
+#include "spritebatcher.h"
+#include <algorithm>
+
+/**
+ * module locals
+ */
+
+struct SpriteKeyLess
+{
+public:
+    const std::vector<SpriteKey>* keys;
+public:
+    SpriteKeyLess(const std::vector<SpriteKey>* k) : keys(k) {}
+    inline bool operator () (unsigned int keyId0, unsigned int keyId1) const
+    {
+        return (*keys)[keyId0] < (*keys)[keyId1];
+    }
+};
+
+/**
+ * class implementation
+ */
+
+SpriteVertex* SpriteBatcher::addQuad(const SpriteKey& key)
+{
+    // the number of distinct keys per frame is a few, so linear search is enough
+    unsigned int keyId;
+    for( keyId=0; keyId<_keys.size(); keyId++ )
+    {
+        if( _keys[keyId] == key ) break;
+    }
+    if( keyId == _keys.size() ) _keys.push_back( key );
+
+    _quadKeys.push_back( keyId );
+    _vertices.resize( _vertices.size() + 4 );
+    return &_vertices[_vertices.size() - 4];
+}
+
+void SpriteBatcher::sort(void)
+{
+    _ranges.clear();
+    _order.resize( _quadKeys.size() );
+    if( _quadKeys.empty() ) return;
+
+    // order keys
+    unsigned int numKeys = _keys.size();
+    std::vector<unsigned int> sortedKeys( numKeys );
+    unsigned int i;
+    for( i=0; i<numKeys; i++ ) sortedKeys[i] = i;
+    std::sort( sortedKeys.begin(), sortedKeys.end(), SpriteKeyLess( &_keys ) );
+
+    // count quads of each key
+    std::vector<unsigned int> keyRank( numKeys );
+    std::vector<unsigned int> rankOffset( numKeys, 0 );
+    for( i=0; i<numKeys; i++ ) keyRank[sortedKeys[i]] = i;
+    for( i=0; i<_quadKeys.size(); i++ ) rankOffset[keyRank[_quadKeys[i]]]++;
+
+    // build ranges, the counter of each rank becomes its offset
+    unsigned int offset = 0;
+    for( i=0; i<numKeys; i++ )
+    {
+        if( !rankOffset[i] ) continue;
+        Range range;
+        range.key = _keys[sortedKeys[i]];
+        range.firstQuad = offset;
+        range.numQuads = rankOffset[i];
+        _ranges.push_back( range );
+        rankOffset[i] = offset;
+        offset += range.numQuads;
+    }
+
+    // stable counting sort of quads
+    for( i=0; i<_quadKeys.size(); i++ )
+    {
+        _order[rankOffset[keyRank[_quadKeys[i]]]++] = i;
+    }
+}
+
+void SpriteBatcher::clear(void)
+{
+    _keys.clear();
+    _vertices.clear();
+    _quadKeys.clear();
+    _order.clear();
+    _ranges.clear();
+}
@@ -0,0 +1,99 @@
+/**
+ * This source code is a part of D3 game project.
+ * (c) Digital Dimension Development, 2004-2005
+ *
+ * @description sprite batcher: collects textured quads of the frame
+ *              and sorts them into ranges of equal render state
+ * @author bad3p
+ */
+
+#ifndef SPRITE_BATCHER_IMPLEMENTATION_INCLUDED
+#define SPRITE_BATCHER_IMPLEMENTATION_INCLUDED
+
+#include <vector>
+
+/**
+ * this module is device independent (it depends on STL only), so it can be
+ * tested & profiled apart from the engine; quads are sorted by key, quads of
+ * equal keys are kept in the order of submission, so each range is a single
+ * draw call; note that the ranges aren't ordered by submission, thus batching
+ * is suitable for order-independent blending (additive glows & flares)
+ */
+
+struct SpriteKey
+{
+public:
+    const void*  texture;     // texture (opaque for batcher)
+    unsigned int srcBlend;    // source blending mode
+    unsigned int destBlend;   // destination blending mode
+    bool         screenSpace; // quad is given in screen space
+    bool         depthTest;   // quad is tested with depth buffer
+public:
+    SpriteKey() : texture(0), srcBlend(0), destBlend(0), screenSpace(false), depthTest(true) {}
+    SpriteKey(const void* t, unsigned int sb, unsigned int db, bool ss, bool dt) :
+        texture(t), srcBlend(sb), destBlend(db), screenSpace(ss), depthTest(dt) {}
+public:
+    inline bool operator == (const SpriteKey& key) const
+    {
+        return texture == key.texture &&
+               srcBlend == key.srcBlend &&
+               destBlend == key.destBlend &&
+               screenSpace == key.screenSpace &&
+               depthTest == key.depthTest;
+    }
+    // world space quads go first (they are depth-tested), then screen space
+    // quads; state changes are ordered by cost (blending, then texture)
+    inline bool operator < (const SpriteKey& key) const
+    {
+        if( screenSpace != key.screenSpace ) return !screenSpace;
+        if( depthTest != key.depthTest ) return depthTest;
+        if( srcBlend != key.srcBlend ) return srcBlend < key.srcBlend;
+        if( destBlend != key.destBlend ) return destBlend < key.destBlend;
+        return texture < key.texture;
+    }
+};
+
+struct SpriteVertex
+{
+public:
+    float        x, y, z; // world space position, or screen space position & depth
+    unsigned int color;   // ARGB color
+    float        u, v;    // texture coordinates
+};
+
+class SpriteBatcher
+{
+public:
+    struct Range
+    {
+    public:
+        SpriteKey    key;       // render state of range
+        unsigned int firstQuad; // first quad in sorted order
+        unsigned int numQuads;  // number of quads in range
+    };
+private:
+    std::vector<SpriteKey>    _keys;      // unique keys of submitted quads
+    std::vector<SpriteVertex> _vertices;  // 4 vertices per quad, in submission order
+    std::vector<unsigned int> _quadKeys;  // key index of each quad
+    std::vector<unsigned int> _order;     // quad indices in sorted order
+    std::vector<Range>        _ranges;    // ranges of sorted quads
+public:
+    // submission : returns 4 vertices of quad to be filled by caller,
+    // (triangles are 0-1-2 & 0-2-3), pointer is valid till next addQuad()
+    SpriteVertex* addQuad(const SpriteKey& key);
+    // sorts submitted quads & builds ranges
+    void sort(void);
+    // discards submitted quads
+    void clear(void);
+public:
+    inline unsigned int getNumQuads(void) const { return _quadKeys.size(); }
+    inline unsigned int getNumRanges(void) const { return _ranges.size(); }
+    inline const Range& getRange(unsigned int rangeId) const { return _ranges[rangeId]; }
+    // valid after sort(), returns 4 vertices of quad in sorted order
+    inline const SpriteVertex* getSortedQuad(unsigned int sortedId) const
+    {
+        return &_vertices[_order[sortedId] * 4];
+    }
+};
+
+#endif
@@ -76,6 +76,11 @@ engine::ITexture* Engine::createTexture(const char* resourcePath)
     return Texture::createTexture( resourcePath );
 }
 
+engine::ITexture* Engine::createTextureFromMemory(const char* resourcePath, const void* data, unsigned int size)
+{
+    return Texture::createTexture( resourcePath, data, size );
+}
+
 engine::ITexture* Engine::createDUDVFromNormalMap(engine::ITexture* normalMap, const char* dudvName)
 {
     Texture* nmap = dynamic_cast<Texture*>( normalMap ); assert( nmap );
@@ -333,6 +338,67 @@ Texture* Texture::createTexture(const char* fileName)
     return result;
 }
 
+Texture* Texture::createTexture(const char* fileName, const void* data, unsigned int size)
+{
+    // reject truncated & non-DDS data
+    if( data == NULL || size < sizeof(DWORD) + sizeof(DDSURFACEDESC2) ) return NULL;
+    if( *reinterpret_cast<const DWORD*>( data ) != MAKEFOURCC( 'D','D','S',' ' ) ) return NULL;
+
+    // read surface format
+    const DDSURFACEDESC2* surfaceDesc = reinterpret_cast<const DDSURFACEDESC2*>( 
+        reinterpret_cast<const char*>( data ) + sizeof(DWORD) 
+    );
+    if( surfaceDesc->dwSize != sizeof(DDSURFACEDESC2) ) return NULL;
+
+    // create interfaces first, so texture isn't registered if data is corrupted
+    IDirect3DTexture9*     iDirect3DTexture9     = NULL;
+    IDirect3DCubeTexture9* iDirect3DCubeTexture9 = NULL;
+    HRESULT hr;
+
+    // is it a cube map?
+    if( surfaceDesc->ddsCaps.dwCaps2 & DDSCAPS2_CUBEMAP )
+    {
+        hr = D3DXCreateCubeTextureFromFileInMemory( 
+            iDirect3DDevice,
+            data,
+            size,
+            &iDirect3DCubeTexture9
+        );
+    }
+    else
+    {
+        hr = D3DXCreateTextureFromFileInMemoryEx(
+            iDirect3DDevice,
+            data,
+            size,
+            D3DX_DEFAULT,
+            D3DX_DEFAULT,
+            D3DX_FROM_FILE,
+            0,
+            D3DFMT_FROM_FILE,
+            D3DPOOL_MANAGED,
+            D3DX_DEFAULT,
+            D3DX_DEFAULT,
+            0,
+            NULL,
+            NULL,
+            &iDirect3DTexture9
+        );
+    }
+    if( FAILED( hr ) ) return NULL;
+
+    // create texture
+    _chain( Texture* result = new Texture );
+    
+    result->_textureType = ttManaged;
+    result->_iDirect3DTexture9 = iDirect3DTexture9;
+    result->_iDirect3DCubeTexture9 = iDirect3DCubeTexture9;
+    result->_name = getTextureNameFromFilePath( fileName );
+    textures.insert( TextureT( result->_name.c_str(), result ) );
+    
+    return result;
+}
+
 /**
  * ITexture
  */
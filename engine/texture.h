@@ -79,6 +79,7 @@ public:
     static Texture* createRenderTarget(int width, int height, int depth, const char* name);
     static Texture* createCubeRenderTarget(int size, int depth, const char* name);
     static Texture* createTexture(const char* fileName);
+    static Texture* createTexture(const char* fileName, const void* data, unsigned int size);
     virtual ~Texture();
     // Lostable
     virtual void onLostDevice(void);
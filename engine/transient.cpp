@@ -0,0 +1,177 @@
+
+#include "headers.h"
+#include "transient.h"
+
+// default ring sizes (enough for the full pass of grass and several particle systems)
+static const unsigned int defaultVertexBufferSize = 4 * 1024 * 1024;
+static const unsigned int defaultIndexBufferSize  = 512 * 1024;
+
+IDirect3DVertexBuffer9* TransientBuffer::_vertexBuffer = NULL;
+IDirect3DIndexBuffer9*  TransientBuffer::_indexBuffer = NULL;
+unsigned int            TransientBuffer::_vertexBufferSize = 0;
+unsigned int            TransientBuffer::_indexBufferSize = 0;
+unsigned int            TransientBuffer::_vertexOffset = 0;
+unsigned int            TransientBuffer::_indexOffset = 0;
+unsigned int            TransientBuffer::_vertexStride = 0;
+unsigned int            TransientBuffer::_lockedVertices = 0;
+unsigned int            TransientBuffer::_lockedIndices = 0;
+unsigned int            TransientBuffer::_frameBytes = 0;
+StaticLostable*         TransientBuffer::_lostable = NULL;
+
+/**
+ * initialization & etc
+ */
+
+void TransientBuffer::init(void)
+{
+    _vertexBufferSize = defaultVertexBufferSize;
+    _indexBufferSize  = defaultIndexBufferSize;
+
+    // optional setup
+    TiXmlElement* transientBuffer = Engine::instance->getConfigElement( "transientBuffer" );
+    if( transientBuffer )
+    {
+        int value;
+        if( transientBuffer->Attribute( "vertexBufferSize", &value ) && value > 0 ) _vertexBufferSize = value;
+        if( transientBuffer->Attribute( "indexBufferSize", &value ) && value > 0 ) _indexBufferSize = value;
+    }
+
+    onResetDevice();
+    _lostable = new StaticLostable( onLostDevice, onResetDevice );
+}
+
+void TransientBuffer::term(void)
+{
+    onLostDevice();
+    if( _lostable ) delete _lostable;
+    _lostable = NULL;
+}
+
+void TransientBuffer::onLostDevice(void)
+{
+    if( _vertexBuffer ) _vertexBuffer->Release();
+    if( _indexBuffer ) _indexBuffer->Release();
+    _vertexBuffer = NULL;
+    _indexBuffer  = NULL;
+}
+
+void TransientBuffer::onResetDevice(void)
+{
+    _dxCR( iDirect3DDevice->CreateVertexBuffer(
+        _vertexBufferSize,
+        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC,
+        0,
+        D3DPOOL_DEFAULT,
+        &_vertexBuffer,
+        NULL
+    ) );
+
+    _dxCR( iDirect3DDevice->CreateIndexBuffer(
+        sizeof(WORD) * _indexBufferSize,
+        D3DUSAGE_WRITEONLY | D3DUSAGE_DYNAMIC,
+        D3DFMT_INDEX16,
+        D3DPOOL_DEFAULT,
+        &_indexBuffer,
+        NULL
+    ) );
+
+    // fresh buffers are discarded anyway
+    _vertexOffset = _vertexBufferSize;
+    _indexOffset  = _indexBufferSize;
+}
+
+void TransientBuffer::beginFrame(void)
+{
+    if( _frameBytes > Engine::statistics.transientFramePeak )
+    {
+        Engine::statistics.transientFramePeak = _frameBytes;
+    }
+    _frameBytes = 0;
+}
+
+/**
+ * suballocation
+ */
+
+unsigned int TransientBuffer::getMaxVertices(unsigned int stride)
+{
+    return _vertexBufferSize / stride;
+}
+
+unsigned int TransientBuffer::getMaxIndices(void)
+{
+    return _indexBufferSize;
+}
+
+void* TransientBuffer::lockVertices(unsigned int stride, unsigned int maxVertices, unsigned int* baseVertex)
+{
+    assert( _lockedVertices == 0 );
+    assert( maxVertices > 0 && maxVertices <= getMaxVertices( stride ) );
+
+    // allocations are aligned by vertex stride, so they could be addressed by the base vertex
+    unsigned int first = ( _vertexOffset + stride - 1 ) / stride;
+    DWORD        flags = D3DLOCK_NOOVERWRITE;
+    if( ( first + maxVertices ) * stride > _vertexBufferSize )
+    {
+        first = 0;
+        flags = D3DLOCK_DISCARD;
+        Engine::statistics.transientDiscards++;
+    }
+
+    void* data = NULL;
+    _dxCR( _vertexBuffer->Lock( first * stride, maxVertices * stride, &data, flags ) );
+    assert( data );
+    Engine::statistics.transientLocks++;
+
+    _vertexOffset   = first * stride;
+    _vertexStride   = stride;
+    _lockedVertices = maxVertices;
+    *baseVertex = first;
+    return data;
+}
+
+void TransientBuffer::unlockVertices(unsigned int numVertices)
+{
+    assert( _lockedVertices > 0 && numVertices <= _lockedVertices );
+    _dxCR( _vertexBuffer->Unlock() );
+
+    unsigned int numBytes = numVertices * _vertexStride;
+    _vertexOffset += numBytes;
+    _frameBytes   += numBytes;
+    _lockedVertices = 0;
+    Engine::statistics.transientVertexBytes += numBytes;
+}
+
+WORD* TransientBuffer::lockIndices(unsigned int maxIndices, unsigned int* baseIndex)
+{
+    assert( _lockedIndices == 0 );
+    assert( maxIndices > 0 && maxIndices <= _indexBufferSize );
+
+    DWORD flags = D3DLOCK_NOOVERWRITE;
+    if( _indexOffset + maxIndices > _indexBufferSize )
+    {
+        _indexOffset = 0;
+        flags = D3DLOCK_DISCARD;
+        Engine::statistics.transientDiscards++;
+    }
+
+    void* data = NULL;
+    _dxCR( _indexBuffer->Lock( _indexOffset * sizeof(WORD), maxIndices * sizeof(WORD), &data, flags ) );
+    assert( data );
+    Engine::statistics.transientLocks++;
+
+    _lockedIndices = maxIndices;
+    *baseIndex = _indexOffset;
+    return reinterpret_cast<WORD*>( data );
+}
+
+void TransientBuffer::unlockIndices(unsigned int numIndices)
+{
+    assert( _lockedIndices > 0 && numIndices <= _lockedIndices );
+    _dxCR( _indexBuffer->Unlock() );
+
+    _indexOffset  += numIndices;
+    _frameBytes   += numIndices * sizeof(WORD);
+    _lockedIndices = 0;
+    Engine::statistics.transientIndexBytes += numIndices * sizeof(WORD);
+}
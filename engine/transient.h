@@ -0,0 +1,71 @@
+/**
+ * This source code is a part of D3 game project.
+ * (c) Digital Dimension Development, 2004-2005
+ *
+ * @description transient geometry: shared ring of dynamic vertex & index buffers
+ *              for the geometry generated by CPU every frame
+ * @author bad3p
+ */
+
+#ifndef TRANSIENT_IMPLEMENTATION_INCLUDED
+#define TRANSIENT_IMPLEMENTATION_INCLUDED
+
+#include "headers.h"
+#include "engine.h"
+
+/**
+ * all CPU-generated geometry (particles, rain, grass, trails, sprites) is
+ * appended to the end of the one and the same dynamic buffer with D3DLOCK_NOOVERWRITE;
+ * when the end of buffer is reached, the buffer is discarded and filling starts 
+ * from the beginning - driver renames the memory still used by GPU, so this is
+ * the only synchronization point; unused tail of locked range is returned back
+ * to the ring by unlock
+ */
+
+class TransientBuffer
+{
+private:
+    static IDirect3DVertexBuffer9* _vertexBuffer;
+    static IDirect3DIndexBuffer9*  _indexBuffer;
+    static unsigned int            _vertexBufferSize; // size of vertex ring, in bytes
+    static unsigned int            _indexBufferSize;  // size of index ring, in indices
+    static unsigned int            _vertexOffset;     // first free byte of vertex ring
+    static unsigned int            _indexOffset;      // first free index of index ring
+    static unsigned int            _vertexStride;     // stride of locked vertices
+    static unsigned int            _lockedVertices;   // vertices reserved by current lock
+    static unsigned int            _lockedIndices;    // indices reserved by current lock
+    static unsigned int            _frameBytes;       // bytes allocated since beginning of frame
+    static StaticLostable*         _lostable;
+private:
+    static void onLostDevice(void);
+    static void onResetDevice(void);
+public:
+    // initialization & etc.
+    static void init(void);
+    static void term(void);
+    // frame marker
+    static void beginFrame(void);
+public:
+    // suballocation : returned pointers are valid until unlock, first vertex (index) 
+    // of allocation is reported by baseVertex (baseIndex) - use it as BaseVertexIndex
+    // (StartIndex) of DrawIndexedPrimitive; unlock commits the actually used part
+    static void* lockVertices(unsigned int stride, unsigned int maxVertices, unsigned int* baseVertex);
+    static void  unlockVertices(unsigned int numVertices);
+    static WORD* lockIndices(unsigned int maxIndices, unsigned int* baseIndex);
+    static void  unlockIndices(unsigned int numIndices);
+    // maximal number of vertices (indices) per allocation
+    static unsigned int getMaxVertices(unsigned int stride);
+    static unsigned int getMaxIndices(void);
+public:
+    // module locals : inlines
+    static inline IDirect3DVertexBuffer9* getVertexBuffer(void) { return _vertexBuffer; }
+    static inline IDirect3DIndexBuffer9* getIndexBuffer(void) { return _indexBuffer; }
+    // setup device for rendering of allocated geometry
+    static inline void setStreams(unsigned int stride)
+    {
+        _dxCR( iDirect3DDevice->SetStreamSource( 0, _vertexBuffer, 0, stride ) );
+        _dxCR( iDirect3DDevice->SetIndices( _indexBuffer ) );
+    }
+};
+
+#endif
@@ -108,6 +108,19 @@ XAsset::XAsset(const char* resourcePath)
     fread( buffer, 1, fileSize, file );
     resource->release();
 
+    // create asset
+    load( resourcePath, buffer, fileSize );
+
+    delete[] buffer;
+}
+
+XAsset::XAsset(const char* resourcePath, const void* data, unsigned int size)
+{
+    load( resourcePath, data, size );
+}
+
+void XAsset::load(const char* resourcePath, const void* buffer, unsigned int size)
+{
     // report progress
     if( Engine::instance->progressCallback )
     {
@@ -126,7 +139,7 @@ XAsset::XAsset(const char* resourcePath)
     ID3DXAnimationController* animController;
     _dxCR( D3DXLoadMeshHierarchyFromXInMemory(
         buffer,
-        fileSize,
+        size,
         D3DXMESH_MANAGED, 
         iDirect3DDevice, 
         &xAlloc, 
@@ -135,8 +148,6 @@ XAsset::XAsset(const char* resourcePath)
         &animController
     ) );
 
-    delete[] buffer;
-
     // report progress
     if( Engine::instance->progressCallback )
     {
@@ -305,19 +316,14 @@ static void resolveNamelessFrame(Frame* frame)
     // frame is nameless?
     if( strcmp( frame->getName(), "" ) == 0 )
     {
-        delete[] frame->Name;
         // frame has a parent?
         if( frame->getParent() )
         {
-            std::string frameName = strformat( "%s_child%d", frame->getParent()->getName(), getChildId( frame ) );
-            frame->Name = new char[ frameName.length() + 1];
-            strcpy( frame->Name, frameName.c_str() );
+            frame->setName( strformat( "%s_child%d", frame->getParent()->getName(), getChildId( frame ) ).c_str() );
         }
         else
         {
-            std::string frameName = "Root";
-            frame->Name = new char[ frameName.length() + 1];
-            strcpy( frame->Name, frameName.c_str() );
+            frame->setName( "Root" );
         }
     }
 
@@ -0,0 +1,47 @@
+/**
+ * This source code is a part of D3 game project.
+ * (c) Digital Dimension Development, 2004-2005
+ *
+ * @description engine tests : entry point
+ *
+ * @author bad3p
+ */
+
+#include <cstdio>
+#include <cstdarg>
+#include "tests.h"
+
+/**
+ * checks
+ */
+
+static unsigned int numChecks   = 0;
+static unsigned int numFailures = 0;
+
+bool check(bool condition, const char* format, ...)
+{
+    numChecks++;
+    if( condition ) return true;
+
+    numFailures++;
+    va_list args;
+    va_start( args, format );
+    printf( "FAILED : " );
+    vprintf( format, args );
+    printf( "\n" );
+    va_end( args );
+    return false;
+}
+
+/**
+ * entry point
+ */
+
+int main(int argc, char* argv[])
+{
+    testOcclusion();
+    testSpriteBatcher();
+
+    printf( "%u checks, %u failed\n", numChecks, numFailures );
+    return int( numFailures );
+}
\ No newline at end of file
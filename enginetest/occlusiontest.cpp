@@ -0,0 +1,268 @@
+/**
+ * This source code is a part of D3 game project.
+ * (c) Digital Dimension Development, 2004-2005
+ *
+ * @description engine tests : occlusion culling on golden camera positions
+ *
+ * @author bad3p
+ */
+
+#include "../engine/headers.h"
+#include "../engine/occlusion.h"
+#include "tests.h"
+
+/**
+ * synthetic canyon : floor & two cliff walls along z axis, tessellated like
+ * low-poly terrain proxies (occluder triangle is rasterized with the depth
+ * of its farthest vertex, so huge triangles would occlude nothing)
+ */
+
+static const float canyonLength    = 20000.0f;
+static const float canyonHalfWidth = 500.0f;
+static const float cliffHeight     = 3000.0f;
+static const float cellSize        = 1000.0f;
+
+static void addQuad(std::vector<Vector>& vertices, const Vector& v0, const Vector& v1, const Vector& v2, const Vector& v3)
+{
+    vertices.push_back( v0 ), vertices.push_back( v1 ), vertices.push_back( v2 );
+    vertices.push_back( v0 ), vertices.push_back( v2 ), vertices.push_back( v3 );
+}
+
+static void buildCanyon(std::vector<Vector>& vertices)
+{
+    float x = canyonHalfWidth;
+    for( float z=0; z<canyonLength; z+=cellSize )
+    {
+        addQuad( vertices, Vector( -x,0,z ), Vector( x,0,z ), Vector( x,0,z+cellSize ), Vector( -x,0,z+cellSize ) );
+        for( float y=0; y<cliffHeight; y+=cellSize )
+        {
+            addQuad( vertices, Vector( -x,y,z ), Vector( -x,y+cellSize,z ), Vector( -x,y+cellSize,z+cellSize ), Vector( -x,y,z+cellSize ) );
+            addQuad( vertices, Vector( x,y,z ), Vector( x,y+cellSize,z ), Vector( x,y+cellSize,z+cellSize ), Vector( x,y,z+cellSize ) );
+        }
+    }
+}
+
+/**
+ * bounds of sectors & atomics : along the canyon, and behind both walls
+ */
+
+struct TestBox
+{
+public:
+    const char* name;
+    float       x, z;
+};
+
+static const TestBox testBoxes[] =
+{
+    { "left near",     -1500.0f,  2000.0f },
+    { "left middle",   -1500.0f,  6000.0f },
+    { "left far",      -1500.0f, 12000.0f },
+    { "valley near",       0.0f,  2000.0f },
+    { "valley middle",     0.0f,  6000.0f },
+    { "valley far",        0.0f, 12000.0f },
+    { "right near",     1500.0f,  2000.0f },
+    { "right middle",   1500.0f,  6000.0f },
+    { "right far",      1500.0f, 12000.0f }
+};
+
+static const unsigned int numTestBoxes = sizeof(testBoxes) / sizeof(TestBox);
+
+static AABB getTestBox(unsigned int boxId)
+{
+    return AABB(
+        Vector( testBoxes[boxId].x - 100.0f, 200.0f, testBoxes[boxId].z - 100.0f ),
+        Vector( testBoxes[boxId].x + 100.0f, 400.0f, testBoxes[boxId].z + 100.0f )
+    );
+}
+
+/**
+ * golden camera path, expected state of each box :
+ * 'v' - visible, 'o' - occluded, 'f' - outside of frustum
+ */
+
+struct TestCamera
+{
+public:
+    const char* name;
+    Vector      eye;
+    Vector      at;
+    const char* expected;
+};
+
+static const TestCamera testCameras[] =
+{
+    { "canyon entrance",    Vector(     0.0f,   300.0f,  -500.0f ), Vector( 0.0f,  300.0f, 20000.0f ), "ooovvvooo" },
+    { "canyon middle",      Vector(     0.0f,   600.0f, 10000.0f ), Vector( 0.0f,  600.0f,     0.0f ), "oofvvfoof" },
+    { "rim overview",       Vector(     0.0f, 15000.0f, -3000.0f ), Vector( 0.0f,    0.0f,  8000.0f ), "vvvvvvvvv" },
+    { "behind left cliff",  Vector( -8000.0f,  1000.0f,  6000.0f ), Vector( 0.0f, 1000.0f,  6000.0f ), "vvfoooooo" }
+};
+
+static const unsigned int numTestCameras = sizeof(testCameras) / sizeof(TestCamera);
+
+/**
+ * reference visibility : box is in frustum, if it isn't outside of any clip plane;
+ * box is really visible, if any of its sample points (corners, face centers & center)
+ * is inside of frustum & isn't hidden by occluder triangle
+ */
+
+static bool isInFrustum(const AABB* box, const Matrix* viewProj)
+{
+    unsigned int outside[6] = { 0,0,0,0,0,0 };
+    D3DXVECTOR4 clip;
+    Vector corner;
+    for( unsigned int i=0; i<8; i++ )
+    {
+        corner.x = ( i & 1 ) ? box->sup.x : box->inf.x;
+        corner.y = ( i & 2 ) ? box->sup.y : box->inf.y;
+        corner.z = ( i & 4 ) ? box->sup.z : box->inf.z;
+        D3DXVec3Transform( &clip, &corner, viewProj );
+        if( clip.x < -clip.w ) outside[0]++;
+        if( clip.x > clip.w ) outside[1]++;
+        if( clip.y < -clip.w ) outside[2]++;
+        if( clip.y > clip.w ) outside[3]++;
+        if( clip.z < 0 ) outside[4]++;
+        if( clip.z > clip.w ) outside[5]++;
+    }
+    for( unsigned int i=0; i<6; i++ ) if( outside[i] == 8 ) return false;
+    return true;
+}
+
+static bool isSegmentBlocked(const Vector& start, const Vector& end, const std::vector<Vector>& vertices)
+{
+    // Moller-Trumbore intersection, hits at the ends of segment are ignored
+    const float epsilon = 1e-4f;
+    Vector dir = end - start;
+    Vector e1, e2, p, s, q;
+    for( unsigned int i=0; i<vertices.size(); i+=3 )
+    {
+        e1 = vertices[i+1] - vertices[i];
+        e2 = vertices[i+2] - vertices[i];
+        D3DXVec3Cross( &p, &dir, &e2 );
+        float det = D3DXVec3Dot( &e1, &p );
+        if( fabs( det ) < epsilon ) continue;
+        float invDet = 1.0f / det;
+        s = start - vertices[i];
+        float u = D3DXVec3Dot( &s, &p ) * invDet;
+        if( u < 0 || u > 1 ) continue;
+        D3DXVec3Cross( &q, &s, &e1 );
+        float v = D3DXVec3Dot( &dir, &q ) * invDet;
+        if( v < 0 || u + v > 1 ) continue;
+        float t = D3DXVec3Dot( &e2, &q ) * invDet;
+        if( t > epsilon && t < 1 - epsilon ) return true;
+    }
+    return false;
+}
+
+static bool isReallyVisible(const AABB* box, const Vector& eye, const Matrix* viewProj, const std::vector<Vector>& vertices)
+{
+    Vector center = ( box->inf + box->sup ) * 0.5f;
+    std::vector<Vector> samples;
+    for( unsigned int i=0; i<8; i++ )
+    {
+        samples.push_back( Vector(
+            ( i & 1 ) ? box->sup.x : box->inf.x,
+            ( i & 2 ) ? box->sup.y : box->inf.y,
+            ( i & 4 ) ? box->sup.z : box->inf.z
+        ) );
+    }
+    samples.push_back( center );
+    samples.push_back( Vector( box->inf.x, center.y, center.z ) );
+    samples.push_back( Vector( box->sup.x, center.y, center.z ) );
+    samples.push_back( Vector( center.x, box->inf.y, center.z ) );
+    samples.push_back( Vector( center.x, box->sup.y, center.z ) );
+    samples.push_back( Vector( center.x, center.y, box->inf.z ) );
+    samples.push_back( Vector( center.x, center.y, box->sup.z ) );
+
+    D3DXVECTOR4 clip;
+    for( unsigned int i=0; i<samples.size(); i++ )
+    {
+        D3DXVec3Transform( &clip, &samples[i], viewProj );
+        if( clip.w <= 0 || clip.z < 0 || clip.z > clip.w ) continue;
+        if( fabs( clip.x ) > clip.w || fabs( clip.y ) > clip.w ) continue;
+        if( !isSegmentBlocked( eye, samples[i], vertices ) ) return true;
+    }
+    return false;
+}
+
+/**
+ * test
+ */
+
+void testOcclusion(void)
+{
+    std::vector<Vector> vertices;
+    buildCanyon( vertices );
+
+    // same resolution as BSP rendering uses
+    OcclusionBuffer buffer( 256, 128 );
+    Matrix projection;
+    D3DXMatrixPerspectiveFovLH( &projection, D3DX_PI / 4, float( buffer.getWidth() ) / buffer.getHeight(), 10.0f, 50000.0f );
+
+    for( unsigned int cameraId=0; cameraId<numTestCameras; cameraId++ )
+    {
+        const TestCamera* camera = testCameras + cameraId;
+        Vector up( 0,1,0 );
+        Matrix view;
+        D3DXMatrixLookAtLH( &view, &camera->eye, &camera->at, &up );
+        Matrix viewProj = view * projection;
+
+        buffer.clear( &viewProj );
+        buffer.rasterize( &vertices[0], vertices.size() / 3 );
+
+        // compare visible sets with & without occlusion culling
+        unsigned int numUnculled = 0;
+        unsigned int numCulled = 0;
+        for( unsigned int boxId=0; boxId<numTestBoxes; boxId++ )
+        {
+            AABB box = getTestBox( boxId );
+            char state = 'f';
+            if( isInFrustum( &box, &viewProj ) )
+            {
+                numUnculled++;
+                state = 'o';
+                if( buffer.isVisible( &box ) ) numCulled++, state = 'v';
+            }
+            bool reallyVisible = isReallyVisible( &box, camera->eye, &viewProj, vertices );
+
+            // culling must be conservative
+            check(
+                state != 'o' || !reallyVisible,
+                "%s : visible box \"%s\" is occluded", camera->name, testBoxes[boxId].name
+            );
+            // golden state
+            check(
+                state == camera->expected[boxId],
+                "%s : box \"%s\" is '%c', expected '%c'", camera->name, testBoxes[boxId].name, state, camera->expected[boxId]
+            );
+        }
+        printf( "occlusion, %s : %u of %u boxes in frustum are visible\n", camera->name, numCulled, numUnculled );
+    }
+
+    // sphere test is a box test of bounding box
+    Vector up( 0,1,0 );
+    Matrix view;
+    D3DXMatrixLookAtLH( &view, &testCameras[0].eye, &testCameras[0].at, &up );
+    Matrix viewProj = view * projection;
+    buffer.clear( &viewProj );
+    buffer.rasterize( &vertices[0], vertices.size() / 3 );
+    for( unsigned int boxId=0; boxId<numTestBoxes; boxId++ )
+    {
+        AABB box = getTestBox( boxId );
+        Sphere sphere;
+        sphere.center = ( box.inf + box.sup ) * 0.5f;
+        sphere.radius = 100.0f;
+        check(
+            buffer.isVisible( &sphere ) == buffer.isVisible( &box ),
+            "%s : sphere of box \"%s\" differs from box", testCameras[0].name, testBoxes[boxId].name
+        );
+    }
+
+    // empty buffer hides nothing
+    buffer.clear( &viewProj );
+    for( unsigned int boxId=0; boxId<numTestBoxes; boxId++ )
+    {
+        AABB box = getTestBox( boxId );
+        check( buffer.isVisible( &box ), "empty buffer : box \"%s\" is occluded", testBoxes[boxId].name );
+    }
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+/**
+ * This source code is a part of D3 game project.
+ * (c) Digital Dimension Development, 2004-2005
+ *
+ * @description engine tests : batching of sprite quads
+ *
+ * @author bad3p
+ */
+
+#include <cstdio>
+#include "../engine/spritebatcher.h"
+#include "tests.h"
+
+/**
+ * quads are stamped with submission number, so the order of batch can be checked
+ */
+
+static void addTestQuad(SpriteBatcher* batcher, const SpriteKey& key, unsigned int quadId)
+{
+    SpriteVertex* vertices = batcher->addQuad( key );
+    for( unsigned int i=0; i<4; i++ )
+    {
+        vertices[i].x = float( quadId );
+        vertices[i].y = float( i );
+        vertices[i].z = 0.0f;
+        vertices[i].color = 0xFFFFFFFF;
+        vertices[i].u = vertices[i].v = 0.0f;
+    }
+}
+
+static void checkRanges(SpriteBatcher* batcher, const char* testName, const std::vector<SpriteKey>& submittedKeys)
+{
+    unsigned int numQuads = 0;
+    for( unsigned int rangeId=0; rangeId<batcher->getNumRanges(); rangeId++ )
+    {
+        const SpriteBatcher::Range& range = batcher->getRange( rangeId );
+        check( range.firstQuad == numQuads, "%s : range %u doesn't follow previous range", testName, rangeId );
+        check( range.numQuads > 0, "%s : range %u is empty", testName, rangeId );
+
+        // ranges are ordered by key
+        if( rangeId > 0 )
+        {
+            check( batcher->getRange( rangeId - 1 ).key < range.key, "%s : range %u is out of key order", testName, rangeId );
+        }
+
+        // quads of range have its key, and keep submission order
+        for( unsigned int i=0; i<range.numQuads; i++ )
+        {
+            const SpriteVertex* vertices = batcher->getSortedQuad( range.firstQuad + i );
+            unsigned int quadId = (unsigned int)( vertices[0].x );
+            check( submittedKeys[quadId] == range.key, "%s : quad %u is in range of other key", testName, quadId );
+            check( vertices[3].y == 3.0f, "%s : vertices of quad %u are mixed up", testName, quadId );
+            if( i > 0 )
+            {
+                const SpriteVertex* previous = batcher->getSortedQuad( range.firstQuad + i - 1 );
+                check( previous[0].x < vertices[0].x, "%s : quad %u is out of submission order", testName, quadId );
+            }
+        }
+        numQuads += range.numQuads;
+    }
+    check( numQuads == batcher->getNumQuads(), "%s : ranges cover %u of %u quads", testName, numQuads, batcher->getNumQuads() );
+}
+
+/**
+ * test
+ */
+
+void testSpriteBatcher(void)
+{
+    // textures are opaque for batcher
+    static int texture1, texture2;
+    // blending modes are values of D3DBLEND
+    const unsigned int one = 2, srcAlpha = 5, invSrcAlpha = 6;
+    SpriteKey glow( &texture1, srcAlpha, one, false, true );
+    SpriteKey glow2( &texture2, srcAlpha, one, false, true );
+    SpriteKey flare( &texture1, one, one, true, false );
+    SpriteKey shade( &texture2, srcAlpha, invSrcAlpha, false, true );
+
+    SpriteBatcher batcher;
+    std::vector<SpriteKey> submittedKeys;
+
+    // empty batch
+    batcher.sort();
+    check( batcher.getNumQuads() == 0 && batcher.getNumRanges() == 0, "empty batch : has quads or ranges" );
+
+    // interleaved keys are gathered into a range per key
+    SpriteKey keys[] = { glow, flare, glow2, glow, shade, flare, glow2, glow };
+    unsigned int numKeys = sizeof(keys) / sizeof(SpriteKey);
+    for( unsigned int i=0; i<numKeys; i++ )
+    {
+        addTestQuad( &batcher, keys[i], i );
+        submittedKeys.push_back( keys[i] );
+    }
+    batcher.sort();
+    check( batcher.getNumQuads() == numKeys, "interleaved keys : %u quads", batcher.getNumQuads() );
+    check( batcher.getNumRanges() == 4, "interleaved keys : %u ranges, expected 4", batcher.getNumRanges() );
+    checkRanges( &batcher, "interleaved keys", submittedKeys );
+
+    // screen space quads are rendered last
+    const SpriteBatcher::Range& lastRange = batcher.getRange( batcher.getNumRanges() - 1 );
+    check( lastRange.key == flare && lastRange.numQuads == 2, "interleaved keys : screen space quads aren't the last range" );
+
+    // flush discards batch, batcher is reused by the next frame
+    batcher.clear();
+    submittedKeys.clear();
+    batcher.sort();
+    check( batcher.getNumQuads() == 0 && batcher.getNumRanges() == 0, "cleared batch : has quads or ranges" );
+
+    // large frame with single key is a single range
+    unsigned int i;
+    for( i=0; i<1000; i++ )
+    {
+        addTestQuad( &batcher, glow, i );
+        submittedKeys.push_back( glow );
+    }
+    batcher.sort();
+    check( batcher.getNumRanges() == 1, "single key : %u ranges, expected 1", batcher.getNumRanges() );
+    checkRanges( &batcher, "single key", submittedKeys );
+
+    // large frame with pseudo-random keys
+    batcher.clear();
+    submittedKeys.clear();
+    unsigned int seed = 12345;
+    for( i=0; i<1000; i++ )
+    {
+        seed = seed * 1103515245 + 12345;
+        addTestQuad( &batcher, keys[( seed >> 16 ) % numKeys], i );
+        submittedKeys.push_back( keys[( seed >> 16 ) % numKeys] );
+    }
+    batcher.sort();
+    check( batcher.getNumRanges() == 4, "random keys : %u ranges, expected 4", batcher.getNumRanges() );
+    checkRanges( &batcher, "random keys", submittedKeys );
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+/**
+ * This source code is a part of D3 game project.
+ * (c) Digital Dimension Development, 2004-2005
+ *
+ * @description engine tests : headless tests of device independent engine modules
+ *
+ * @author bad3p
+ */
+
+#ifndef ENGINETEST_TESTS_INCLUDED
+#define ENGINETEST_TESTS_INCLUDED
+
+/**
+ * tests are built as console application (enginetest.vcxproj), they compile
+ * engine modules they test directly and need no rendering device, so they
+ * can be run on build machines; exit code is the number of failed checks
+ */
+
+// counts check, reports it if failed, returns condition
+bool check(bool condition, const char* format, ...);
+
+// occlusion buffer : camera path through synthetic canyon
+void testOcclusion(void);
+
+// sprite batcher : ranges of glow & flare quads
+void testSpriteBatcher(void);
+
+#endif
\ No newline at end of file
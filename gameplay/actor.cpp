@@ -11,6 +11,7 @@ Actor::Actor(Scene* scene)
     _name  = "Actor";
     _scene = scene;
     _parent = NULL;
+    _hasPhysics = true;
 	_airfoils = NULL;
 	_airfoilsC = 0;
 	network_id = -1;
@@ -22,6 +23,7 @@ Actor::Actor(Actor* parent)
     _parent = parent;
     _parent->_children.push_back( this );
     _scene  = parent->getScene();
+    _hasPhysics = true;
 	_airfoils = NULL;
 	_airfoilsC = 0;
 	network_id = -1;
@@ -74,6 +76,7 @@ void Actor::updateActivity(float dt)
 
 void Actor::updatePhysics(void)
 {
+    if( !_hasPhysics ) return;
     onUpdatePhysics();
     for( ActorI actorI = _children.begin(); actorI != _children.end(); actorI++ ) 
     {
@@ -81,6 +84,11 @@ void Actor::updatePhysics(void)
     }
 }
 
+void Actor::disablePhysics(void)
+{
+    _hasPhysics = false;
+}
+
 void Actor::clearAirfoils() {
 	if (_airfoils != NULL) {
 		for (int i = 0; i < _airfoilsC; ++i) {
@@ -11,6 +11,7 @@
 Airplane::Airplane(Actor* parent, AirplaneDesc* desc) : Actor( parent )
 {
     _desc  = *desc;
+
     _roughMode = false;
     _landingMode = false;
     _restAltitude = _desc.initAltitude - _desc.lastAltitude;
@@ -0,0 +1,108 @@
+
+#include "headers.h"
+#include "assetcache.h"
+#include "gameplay.h"
+
+/**
+ * class implementation
+ */
+
+AssetCache::AssetCache(unsigned int budget)
+{
+    _budget = budget;
+    _size = 0;
+}
+
+AssetCache::~AssetCache()
+{
+    clear();
+    assert( _entries.size() == 0 );
+}
+
+/**
+ * private behaviour
+ */
+
+void AssetCache::evict(void)
+{
+    EntryI entryI = _entries.end();
+    while( _size > _budget && entryI != _entries.begin() )
+    {
+        entryI--;
+        if( entryI->numReferences ) continue;
+        _size -= entryI->size;
+        entryI->asset->release();
+        _index.erase( entryI->resource );
+        _assets.erase( entryI->asset );
+        entryI = _entries.erase( entryI );
+    }
+}
+
+/**
+ * class behaviour
+ */
+
+engine::IAsset* AssetCache::acquire(engine::AssetType assetType, const char* resource, bool* isCreated)
+{
+    // cached asset
+    EntryMI entryMI = _index.find( resource );
+    if( entryMI != _index.end() )
+    {
+        EntryI entryI = entryMI->second;
+        if( entryI != _entries.begin() ) _entries.splice( _entries.begin(), _entries, entryI );
+        entryI->numReferences++;
+        if( isCreated ) *isCreated = false;
+        return entryI->asset;
+    }
+
+    // retrieve file size
+    unsigned int size = 0;
+    ccor::IResource* fileResource = getCore()->getResource( resource, "rb" );
+    if( fileResource )
+    {
+        fseek( fileResource->getFile(), 0, SEEK_END );
+        size = ftell( fileResource->getFile() );
+        fileResource->release();
+    }
+
+    // create asset
+    engine::IAsset* asset = Gameplay::iEngine->createAsset( assetType, resource );
+    assert( asset );
+    _entries.push_front( Entry( resource, asset, size ) );
+    _index.insert( EntryM::value_type( resource, _entries.begin() ) );
+    _assets.insert( AssetM::value_type( asset, _entries.begin() ) );
+    _size += size;
+    if( isCreated ) *isCreated = true;
+
+    // new asset may exceed budget
+    evict();
+
+    return asset;
+}
+
+void AssetCache::release(engine::IAsset* asset)
+{
+    AssetMI assetMI = _assets.find( asset );
+    assert( assetMI != _assets.end() );
+    assert( assetMI->second->numReferences > 0 );
+    assetMI->second->numReferences--;
+    if( assetMI->second->numReferences == 0 ) evict();
+}
+
+void AssetCache::clear(void)
+{
+    EntryI entryI = _entries.begin();
+    while( entryI != _entries.end() )
+    {
+        if( entryI->numReferences )
+        {
+            entryI++;
+            continue;
+        }
+        _size -= entryI->size;
+        entryI->asset->release();
+        _index.erase( entryI->resource );
+        _assets.erase( entryI->asset );
+        entryI = _entries.erase( entryI );
+    }
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+
+#ifndef ASSET_CACHE_INCLUDED
+#define ASSET_CACHE_INCLUDED
+
+#include "headers.h"
+
+/**
+ * asset cache : assets are shared by reference counting, unreferenced assets
+ * are kept resident (till the next mission) in LRU list, while the total size 
+ * of cached asset files fits into memory budget
+ */
+
+class AssetCache
+{
+private:
+    struct Entry
+    {
+    public:
+        std::string      resource;
+        engine::IAsset*  asset;
+        unsigned int     size;          // file size, estimation of asset memory
+        unsigned int     numReferences;
+    public:
+        Entry(const std::string& r, engine::IAsset* a, unsigned int s) : resource(r), asset(a), size(s), numReferences(1) {}
+    };
+    typedef std::list<Entry> EntryL;
+    typedef EntryL::iterator EntryI;
+    typedef std::map<std::string,EntryI> EntryM;
+    typedef EntryM::iterator EntryMI;
+    typedef std::map<engine::IAsset*,EntryI> AssetM;
+    typedef AssetM::iterator AssetMI;
+private:
+    unsigned int _budget;
+    unsigned int _size;    // total size of cached assets
+    EntryL       _entries; // LRU list, recently used entries first
+    EntryM       _index;   // LRU list entries by resource name
+    AssetM       _assets;  // LRU list entries by asset
+private:
+    void evict(void);
+public:
+    // class implementation
+    AssetCache(unsigned int budget);
+    ~AssetCache();
+public:
+    // returns shared asset, creates asset if it isn't cached (isCreated is set to true)
+    engine::IAsset* acquire(engine::AssetType assetType, const char* resource, bool* isCreated);
+    // releases asset reference, unreferenced asset is kept in cache while it fits budget
+    void release(engine::IAsset* asset);
+    // releases all unreferenced assets
+    void clear(void);
+};
+
+#endif
\ No newline at end of file
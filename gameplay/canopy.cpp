@@ -24,6 +24,14 @@ static engine::AnimSequence openingSequence =
     animStartTime, animEndTime, engine::ltNone, 0.0f 
 };
 
+/**
+ * visual LOD : beyond this distance canopy is rendered rigid, and without lines
+ */
+
+const float canopyVisualLODDistance = 15000.0f;
+
+CanopySimulator::CanopySimulatorV CanopySimulator::_canopies;
+
 /**
  * model management
  */
@@ -398,10 +406,18 @@ CanopySimulator::CanopySimulator(Actor* jumper, Gear* gear, bool sliderUp) :
     // sound actor
     //if( jumperIsPlayer ) 
 	new FlightSound( this );
+
+    // visual LOD
+    _visualStep      = _scene->getActivityStep() - 1;
+    _isVisualNear    = true;
+    _isLinesVisible  = true;
+    _visualInflation = -1.0f;
+    _canopies.push_back( this );
 }
 
 CanopySimulator::~CanopySimulator()
 {
+    _canopies.erase( std::find( _canopies.begin(), _canopies.end(), this ) );
 	
     // release PABs
     for( unsigned int i=0; i<_gearRecord->riserScheme->getNumPABs(); i++ ) if( _pabs[i] ) delete _pabs[i];
@@ -676,16 +692,20 @@ void CanopySimulator::connect(
     // create brakes
     float brakeAspect = 0.85f;
     engine::IFrame** canopyJoints = new engine::IFrame*[_gearRecord->riserScheme->getNumBrakes()];
+    const char** jointNames = new const char*[_gearRecord->riserScheme->getNumBrakes()];
     for( i=0; i<_gearRecord->riserScheme->getNumBrakes(); i++ )
     {
-        canopyJoints[i] = Gameplay::iEngine->findFrame( _canopyClump->getFrame(), _gearRecord->riserScheme->getJointName( database::RiserScheme::rtBrakeLeft, i ) );
+        jointNames[i] = _gearRecord->riserScheme->getJointName( database::RiserScheme::rtBrakeLeft, i );
     }
+    Gameplay::iEngine->findFrames( _canopyClump->getFrame(), _gearRecord->riserScheme->getNumBrakes(), jointNames, canopyJoints );
     _leftBrake = new BrakeSimulator( brakeAspect, _gearRecord->riserScheme->getNumBrakes(), _sliderUp ? getSliderJointRearLeft( _sliderClump ) : _rearLeftRiser, canopyJoints, _cordBatch, instanceId );
     for( i=0; i<_gearRecord->riserScheme->getNumBrakes(); i++ )
     {
-        canopyJoints[i] = Gameplay::iEngine->findFrame( _canopyClump->getFrame(), _gearRecord->riserScheme->getJointName( database::RiserScheme::rtBrakeRight, i ) );
+        jointNames[i] = _gearRecord->riserScheme->getJointName( database::RiserScheme::rtBrakeRight, i );
     }
+    Gameplay::iEngine->findFrames( _canopyClump->getFrame(), _gearRecord->riserScheme->getNumBrakes(), jointNames, canopyJoints );
     _rightBrake = new BrakeSimulator( brakeAspect, _gearRecord->riserScheme->getNumBrakes(), _sliderUp ? getSliderJointRearRight( _sliderClump ) : _rearRightRiser, canopyJoints, _cordBatch, instanceId );
+    delete[] jointNames;
     delete[] canopyJoints;
 
 	
@@ -815,7 +835,7 @@ void CanopySimulator::open(const PxTransform& pose, const PxVec3& velocity, floa
     _mcCanopy.setup( canopyLTM, viewLTM );
 
     // synchronize physics & rendering structures to achieve valid data for joint
-    _canopyClump->getFrame()->setMatrix( _mcCanopy.convert( wrap( _nxCanopy->getGlobalPose() ) ) );
+    _mcCanopy.synchronize( _canopyClump->getFrame(), _nxCanopy->getGlobalPose() );
     _canopyClump->getFrame()->getLTM();
 
     // initialize rough joints
@@ -981,22 +1001,24 @@ void CanopySimulator::onUpdateActivity(float dt)
         happen( this, EVENT_CANOPY_VELOCITY, &vel );
 
         // animate canopy, and synchronize canopy simulator & canopy model
-        float animTime = animStartTime * ( 1.0f - _inflation ) + animEndTime * _inflation;
-		//if (_inflation <= 0.26f) {
-			//animTime = powf(animTime, 1.6487212707f);
-		//}
-        _canopyClump->getAnimationController()->resetTrackTime( 0 );
-        _canopyClump->getAnimationController()->advance( animTime );
-        _canopyClump->getFrame()->setMatrix( _mcCanopy.convert( wrap( _nxCanopy->getGlobalPose() ) ) );
+        // (first canopy updated in this step does it for all canopies of scene)
+        if( _visualStep != _scene->getActivityStep() ) updateVisuals( _scene );
         _canopyClump->getFrame()->getLTM();
         
         // specific behaviour
         updateWarp( dt );
         updateSlider( dt );
-        updateProceduralAnimation( dt );
+        if( _isVisualNear ) updateProceduralAnimation( dt );
         _canopyClump->getFrame()->getLTM();
 
         // place cords
+        if( !_isVisualNear )
+        {
+            if( _isLinesVisible && !isCutAway ) hideLines();
+            return;
+        }
+        _isLinesVisible = true;
+
 		if (!isCutAway) {
 			for( unsigned int i=0; i<_numCords; i++ ) _cords[i]->update( dt );
 			if (_leftBrake) _leftBrake->update( dt );
@@ -1013,6 +1035,81 @@ void CanopySimulator::onUpdateActivity(float dt)
     }
 }
 
+void CanopySimulator::updateVisuals(Scene* scene)
+{
+    static std::vector<engine::IFrame*> frames;
+    static std::vector<const Matrix4f*> conversions;
+    static std::vector<Matrix4f>        poses;
+    frames.clear();
+    conversions.clear();
+    poses.clear();
+
+    // camera position is known since previous step
+    bool hasCamera = ( scene->getCamera() != NULL );
+    Vector3f cameraPos( 0,0,0 );
+    if( hasCamera )
+    {
+        Matrix4f cameraPose = scene->getCamera()->getPose();
+        cameraPos.set( cameraPose[3][0], cameraPose[3][1], cameraPose[3][2] );
+    }
+
+    CanopySimulator* canopy;
+    float            animTime;
+    for( unsigned int i=0; i<_canopies.size(); i++ )
+    {
+        canopy = _canopies[i];
+        if( canopy->_scene != scene || !canopy->isOpened() ) continue;
+        if( canopy->_visualStep == scene->getActivityStep() ) continue;
+        canopy->_visualStep = scene->getActivityStep();
+
+        // LOD decision
+        PxTransform pose = canopy->_nxCanopy->getGlobalPose();
+        canopy->_isVisualNear = !hasCamera || 
+                                ( wrap( pose.p ) - cameraPos ).length() < canopyVisualLODDistance;
+
+        // animation is evaluated for near canopies (it restores frames rotated by PABs),
+        // rigid distant canopies are evaluated only if inflation is changed
+        if( canopy->_isVisualNear || canopy->_visualInflation != canopy->_inflation )
+        {
+            animTime = animStartTime * ( 1.0f - canopy->_inflation ) + animEndTime * canopy->_inflation;
+            canopy->_canopyClump->getAnimationController()->resetTrackTime( 0 );
+            canopy->_canopyClump->getAnimationController()->advance( animTime );
+            canopy->_visualInflation = canopy->_isVisualNear ? -1.0f : canopy->_inflation;
+        }
+
+        frames.push_back( canopy->_canopyClump->getFrame() );
+        conversions.push_back( canopy->_mcCanopy.getConversion() );
+        poses.push_back( wrap( pose ) );
+    }
+
+    // synchronize canopy simulators & canopy models
+    if( frames.size() )
+    {
+        Gameplay::iEngine->synchronizeFrames( frames.size(), &frames[0], &conversions[0], &poses[0] );
+    }
+}
+
+void CanopySimulator::hideLines(void)
+{
+    // lines of distant canopy are collapsed into tiny cords at canopy
+    Vector3f pos = _canopyClump->getFrame()->getPos();
+    Vector3f end = pos + Vector3f( 0.0f, 0.1f, 0.0f );
+    if( _cordBatch )
+    {
+        Matrix4f matrix;
+        Jumper::placeCord( matrix, pos, end, 0.01f );
+        for( unsigned int i=0; i<_cordBatch->getBatchSize(); i++ ) _cordBatch->setMatrix( i, matrix );
+    }
+    if( _sliderUp )
+    {
+        Jumper::placeCord( _sliderCordFL, pos, end, 0.01f );
+        Jumper::placeCord( _sliderCordFR, pos, end, 0.01f );
+        Jumper::placeCord( _sliderCordRL, pos, end, 0.01f );
+        Jumper::placeCord( _sliderCordRR, pos, end, 0.01f );
+    }
+    _isLinesVisible = false;
+}
+
 static PxVec3 getResistanceForce(const PxVec3& normal, const PxVec3& vel, float K)
 {
     float normalVel = normal.dot( vel );
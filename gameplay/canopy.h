@@ -323,6 +323,13 @@ private:
     bool              _collideJumper;  // internal state flag
 private:
     CanopyRenderCallback* _renderCallback;
+private:
+    typedef std::vector<CanopySimulator*> CanopySimulatorV;
+    static CanopySimulatorV _canopies; // all canopies, for batched visual update
+    unsigned int      _visualStep;     // activity step of last visual update
+    bool              _isVisualNear;   // visual LOD : full canopy (true) or rigid canopy without lines (false)
+    bool              _isLinesVisible; // lines are placed (not collapsed by far LOD)
+    float             _visualInflation;// inflation of last evaluated animation (negative if not evaluated)
 protected:
     // Actor
     virtual void onUpdateActivity(float dt);
@@ -340,6 +347,8 @@ protected:
     void updateWarp(float dt);
     void updateSlider(float dt);
     void updateProceduralAnimation(float dt);
+    void hideLines(void);
+    static void updateVisuals(Scene* scene);
     void updateCollapse(float dt);
     void updateMalfunctionSignature(gui::IGuiWindow* signature, const wchar_t* description, float weight, const Vector3f& pos);
     void visualizeForce(PxVec3& pos, PxVec3& force);
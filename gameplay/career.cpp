@@ -22,6 +22,7 @@ Career::Career(const char* name)
     _homeX = _homeY = 0;
     _eventCallback = NULL;
     _eventCallbackData = NULL;
+    _eventRevision = 0;
 
     // initialize game walk-through meter
     initializeWalkthroughMeter();
@@ -53,10 +54,10 @@ Career::Career(const char* name)
     _virtues.equipment.reserve.age   = 0;
 
     // initialize events
-    _events.push_back( new RegularWork( this, true ) );
-    _events.push_back( new WeatherForecast( this ) );
-    _events.push_back( new Divine( this ) );
-    _events.push_back( new Night( this, true ) );
+    insertEvent( new RegularWork( this, true ) );
+    insertEvent( new WeatherForecast( this ) );
+    insertEvent( new Divine( this ) );
+    insertEvent( new Night( this, true ) );
 }
 
 Career::Career(TiXmlElement* node)
@@ -69,6 +70,7 @@ Career::Career(TiXmlElement* node)
     _homeX = _homeY = 0;
     _eventCallback = NULL;
     _eventCallbackData = NULL;
+    _eventRevision = 0;
 
     TiXmlNode* child = node->FirstChild(); assert( child );
     if( child != NULL ) do 
@@ -126,7 +128,7 @@ Career::Career(TiXmlElement* node)
                 {
                     Event* event = Event::createFromXml( this, static_cast<TiXmlElement*>( eventNode ) );
                     assert( event );
-                    _events.push_back( event );
+                    insertEvent( event );
                 }
                 eventNode = eventNode->NextSibling();
             }
@@ -320,9 +322,23 @@ bool Career::unequipGear() {
  * event management
  */
 
-void Career::addEvent(Event* event)
+void Career::insertEvent(Event* event)
 {
     _events.push_back( event );
+
+    EventClassI eventClassI = _eventClasses.find( event->getClassName() );
+    if( eventClassI == _eventClasses.end() )
+    {
+        eventClassI = _eventClasses.insert( EventClassT( event->getClassName(), EventClass() ) ).first;
+    }
+    eventClassI->second.events.push_back( event );
+    if( event->getFlags() & efActive ) eventClassI->second.numActiveEvents++;
+    _eventRevision++;
+}
+
+void Career::addEvent(Event* event)
+{
+    insertEvent( event );
     if( _eventCallback ) _eventCallback( event, _eventCallbackData );
 }
 
@@ -333,6 +349,13 @@ void Career::removeEvent(Event* event)
         if( _events[i] == event )
         {
             _events.erase( _events.begin() + i );
+            // remove from index
+            EventClassI eventClassI = _eventClasses.find( event->getClassName() );
+            assert( eventClassI != _eventClasses.end() );
+            std::vector<Event*>& classEvents = eventClassI->second.events;
+            classEvents.erase( std::find( classEvents.begin(), classEvents.end(), event ) );
+            if( event->getFlags() & efActive ) eventClassI->second.numActiveEvents--;
+            _eventRevision++;
             delete event;
             return;
         }
@@ -345,6 +368,48 @@ void Career::setEventCallback(EventCallback eventCallback, void* data)
     _eventCallbackData = data;
 }
 
+void Career::onChangeEventFlags(Event* event, unsigned int oldFlags)
+{
+    if( ( oldFlags & efActive ) != ( event->getFlags() & efActive ) )
+    {
+        EventClassI eventClassI = _eventClasses.find( event->getClassName() );
+        if( eventClassI != _eventClasses.end() )
+        {
+            if( event->getFlags() & efActive ) 
+            {
+                eventClassI->second.numActiveEvents++;
+            }
+            else
+            {
+                eventClassI->second.numActiveEvents--;
+            }
+        }
+    }
+    _eventRevision++;
+}
+
+unsigned int Career::getNumEvents(const char* className)
+{
+    EventClassI eventClassI = _eventClasses.find( className );
+    if( eventClassI == _eventClasses.end() ) return 0;
+    return (unsigned int)eventClassI->second.events.size();
+}
+
+Event* Career::getEvent(const char* className, unsigned int id)
+{
+    EventClassI eventClassI = _eventClasses.find( className );
+    assert( eventClassI != _eventClasses.end() );
+    assert( id>=0 && id<eventClassI->second.events.size() );
+    return eventClassI->second.events[id];
+}
+
+unsigned int Career::getNumActiveEvents(const char* className)
+{
+    EventClassI eventClassI = _eventClasses.find( className );
+    if( eventClassI == _eventClasses.end() ) return 0;
+    return eventClassI->second.numActiveEvents;
+}
+
 /**
  * game data management
  */
@@ -55,9 +55,12 @@ public:
 public:
     inline float& getDuration(void) { return _duration; }
     inline float& getTimeTo(void) { return _timeTo; }
-    inline unsigned int& getFlags(void) { return _flags; }
+    inline unsigned int getFlags(void) { return _flags; }
     inline unsigned int getDatabaseId(void) { return _databaseId; }
     inline gui::IGuiWindow* getWindow(void) { return _window; }
+public:
+    // changing of flags is reported to career (event index)
+    void setFlags(unsigned int flags);
 public:
     void saveToXml(TiXmlNode* node);
     static Event* createFromXml(Career* career, TiXmlElement* element);
@@ -143,6 +146,18 @@ private:
     typedef std::pair<std::string, GameData*> GameDataT;
     typedef std::map<std::string, GameData*> GameDataM;
     typedef GameDataM::iterator GameDataI;
+    // event index : events of class & number of active events of class
+    struct EventClass
+    {
+    public:
+        std::vector<Event*> events;
+        unsigned int        numActiveEvents;
+    public:
+        EventClass() : numActiveEvents(0) {}
+    };
+    typedef std::pair<std::string, EventClass> EventClassT;
+    typedef std::map<std::string, EventClass> EventClassM;
+    typedef EventClassM::iterator EventClassI;
 private:
     std::string          _name;
     Virtues              _virtues;
@@ -154,8 +169,11 @@ private:
     int                  _homeY;
     EventCallback        _eventCallback;
     void*                _eventCallbackData;
+    EventClassM          _eventClasses;
+    unsigned int         _eventRevision;
 private:
     void initializeWalkthroughMeter(void);
+    void insertEvent(Event* event);
 public:
     // class implementation
     Career(const char* name);
@@ -185,6 +203,13 @@ public:
     void addEvent(Event* event);
     void removeEvent(Event* event);    
     void setEventCallback(EventCallback eventCallback, void* data);
+    void onChangeEventFlags(Event* event, unsigned int oldFlags);
+public:
+    // event index (revision is changed when events are added, removed or their flags are changed)
+    unsigned int getNumEvents(const char* className);
+    Event* getEvent(const char* className, unsigned int id);
+    unsigned int getNumActiveEvents(const char* className);
+    inline unsigned int getEventRevision(void) { return _eventRevision; }
 public:
     // game data management
     void addGameData(const char* name, GameData* gameData);
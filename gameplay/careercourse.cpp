@@ -1633,12 +1633,12 @@ float CareerCourse::simulateCourse(float minutes, bool guiFeedback)
         }
         if( eventToHandle->getTimeTo() - eventToHandle->getDuration() == 0 )
         {            
-            eventToHandle->getFlags() = eventToHandle->getFlags() | efActive;
+            eventToHandle->setFlags( eventToHandle->getFlags() | efActive );
             eventToHandle->onBeginEvent( _geoscape );
         }
         if( eventToHandle->getTimeTo() == 0 )
         {
-            eventToHandle->getFlags() = eventToHandle->getFlags() | efFinished;
+            eventToHandle->setFlags( eventToHandle->getFlags() | efFinished );
             eventToHandle->onEndEvent( _geoscape );
             if( eventToHandle->getWindow()->getPanel()->getParent() )
             {
@@ -1674,16 +1674,8 @@ float CareerCourse::simulateCourse(float minutes, bool guiFeedback)
 
     // correction of time errors due to float type of time
     // search for nigth event
-    Event* night = NULL;
-    for( i=0; i<career->getNumEvents(); i++ )
-    {
-        if( strcmp( career->getEvent(i)->getClassName(), NIGHT_CLASS_NAME ) == 0 )
-        {
-            night = career->getEvent(i);
-            break;
-        }
-    }
-    assert( night );
+    assert( career->getNumEvents( NIGHT_CLASS_NAME ) );
+    Event* night = career->getEvent( NIGHT_CLASS_NAME, 0 );
     // night is inactive?
     if( night->getTimeTo() > night->getDuration() )
     {
@@ -8,6 +8,11 @@
 
 void Crowd::onUpdateActivity(float dt)
 {
+    // evaluate shared poses
+    for( unsigned int i=0; i<_poses.size(); i++ )
+    {
+        _poses[i].clump->getAnimationController()->advance( dt );
+    }
 }
 
 /**
@@ -22,6 +27,8 @@ Crowd::Crowd(Actor* parent, CrowdDesc* desc) : Actor( parent )
 
     _name = "Crowd";
     _desc = *desc;
+    // spectators have no physics
+    disablePhysics();
     _numWalkingActors = 0;
 
     // actualize extras frame hierarchy
@@ -34,16 +41,20 @@ Crowd::Crowd(Actor* parent, CrowdDesc* desc) : Actor( parent )
     _enclosure = new Enclosure( _desc.extras, 0.0f );
 
     // generate crowd actors
-    engine::IClump* cloneSource = _scene->findClump( "CrowdMale01" );
-    assert( cloneSource );
+    _cloneSource = _scene->findClump( "CrowdMale01" );
+    assert( _cloneSource );
     for( unsigned int i=0; i<_desc.numActors; i++ )
     {
-        new Spectator( this, cloneSource, _enclosure );
+        new Spectator( this, _cloneSource, _enclosure );
     }
 }
 
 Crowd::~Crowd()
 {
+    for( unsigned int i=0; i<_poses.size(); i++ )
+    {
+        _poses[i].clump->release();
+    }
     if( _enclosure ) delete _enclosure;
 }
 
@@ -62,4 +73,44 @@ void Crowd::endWalk(void)
 {
     _numWalkingActors--;
     assert( _numWalkingActors >= 0 );
+}
+
+engine::IAnimationController* Crowd::getPose(engine::AnimSequence* sequence, unsigned int phase)
+{
+    assert( phase < numPosePhases );
+
+    // search for existing pose
+    for( unsigned int i=0; i<_poses.size(); i+=numPosePhases )
+    {
+        if( _poses[i].sequence == sequence ) 
+        {
+            return _poses[i+phase].clump->getAnimationController();
+        }
+    }
+
+    // create poses for all phases of sequence
+    unsigned int firstPose = _poses.size();
+    float period = sequence->endTime - sequence->startTime;
+    for( unsigned int i=0; i<numPosePhases; i++ )
+    {
+        CrowdPose pose;
+        pose.clump = _cloneSource->clone( "CrowdPose" );
+        pose.sequence = sequence;
+
+        engine::IAnimationController* controller = pose.clump->getAnimationController();
+        for( unsigned int j=0; j<engine::maxAnimationTracks; j++ )
+        {
+            if( controller->getTrackAnimation( j ) ) controller->setTrackActivity( j, false );
+        }
+        controller->setTrackAnimation( 0, sequence );
+        controller->setTrackSpeed( 0, 1.0f );
+        controller->setTrackWeight( 0, 1.0f );
+        controller->setTrackActivity( 0, true );
+        controller->resetTrackTime( 0 );
+        controller->advance( period * float( i ) / float( numPosePhases ) );
+
+        _poses.push_back( pose );
+    }
+
+    return _poses[firstPose+phase].clump->getAnimationController();
 }
\ No newline at end of file
@@ -20,12 +20,31 @@ public:
     unsigned int    numWalkingActors;
 };
 
+/**
+ * crowd pose : animation sequence played once for all spectators of the same phase,
+ * pose holder is a clone of spectator model, that isn't added to stage
+ */
+
+struct CrowdPose
+{
+public:
+    engine::IClump*       clump;    // pose holder
+    engine::AnimSequence* sequence; // played sequence
+};
+
 class Crowd : public Actor
 {
+public:
+    // number of phases of each shared sequence
+    static const unsigned int numPosePhases = 4;
+private:
+    typedef std::vector<CrowdPose> CrowdPoses;
 private:
-    CrowdDesc    _desc;
-    Enclosure*   _enclosure;
-    unsigned int _numWalkingActors;
+    CrowdDesc       _desc;
+    Enclosure*      _enclosure;
+    unsigned int    _numWalkingActors;
+    engine::IClump* _cloneSource;
+    CrowdPoses      _poses;
 protected:
     // actor abstracts
     virtual void onUpdateActivity(float dt);
@@ -36,6 +55,8 @@ public:
     // class behaviour
     bool beginWalk(void);
     void endWalk(void);
+    // shared pose of given sequence in given phase (evaluated once per frame)
+    engine::IAnimationController* getPose(engine::AnimSequence* sequence, unsigned int phase);
 };
 
 /**
@@ -45,6 +66,24 @@ public:
 class Spectator : public Character
 {
 private:
+    /**
+     * shared idle action (copies shared pose of crowd)
+     */
+    class SharedIdle : public Character::Action
+    {
+    private:
+        engine::AnimSequence*         _sequence;
+        engine::IAnimationController* _pose;
+    public:
+        // class implementation
+        SharedIdle(engine::IClump* clump, engine::AnimSequence* sequence, engine::IAnimationController* pose, float blendTime);
+        // Action
+        virtual void update(float dt);
+        virtual void updatePhysics(void) {}
+    public:
+        // inlines
+        inline engine::AnimSequence* getSequence(void) { return _sequence; }
+    };
     /**
      * turn action
      */
@@ -93,6 +132,9 @@ private:
     float             _watchDelay;
     float             _watchTime;
     Vector3f          _watchPos;
+    unsigned int      _posePhase;
+private:
+    void shareIdle(engine::AnimSequence* sequence);
 protected:
     // atomic rendering
     static engine::IAtomic* onRenderAtomic(engine::IAtomic* atomic, void* data);
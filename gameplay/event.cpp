@@ -73,6 +73,13 @@ Event::~Event()
     _buttonTexture->release();
 }
 
+void Event::setFlags(unsigned int flags)
+{
+    unsigned int oldFlags = _flags;
+    _flags = flags;
+    _career->onChangeEventFlags( this, oldFlags );
+}
+
 /**
  * protected behaviour
  */
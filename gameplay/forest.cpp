@@ -116,8 +116,11 @@ Forest::Forest(Actor* parent, ForestDesc* desc) : Actor( parent )
     // copy descriptor
     _desc = *desc;    
 
+    // interaction with forest is simulated by mission
+    disablePhysics();
+
     // load asset
-    _asset = Gameplay::iEngine->createAsset( engine::atBinary, _desc.assetName.c_str() );
+    _asset = Gameplay::iGameplay->getAssetCache()->acquire( engine::atBinary, _desc.assetName.c_str(), NULL );
 
     // enumerate clumps
     callback::ClumpL clumps;    
@@ -298,6 +301,9 @@ Forest::~Forest()
     _scene->getStage()->remove( _canopyBatch );
     _trunkBatch->release();
     _canopyBatch->release();    
+
+    // release asset
+    Gameplay::iGameplay->getAssetCache()->release( _asset );
 }
 
 void Forest::onUpdateActivity(float dt)
@@ -41,6 +41,7 @@ Gameplay::Gameplay()
 
 	_renderTarget = NULL;
 	pxCooking = NULL;
+    _assetCache = NULL;
    
 	// zhulikotester
     //checkKey( "7LGQ-3F9H-C7LT-Q3W4-FR9F-CX9H", "WD-WMAJ94914315" );
@@ -79,6 +80,9 @@ Gameplay::~Gameplay()
             }
         }
     
+        // delete shared assets
+        if( _assetCache ) delete _assetCache;
+
         // delete careers
         saveCareers();
         for( unsigned int i=0; i<_careers.size(); i++ ) delete _careers[i];
@@ -440,6 +444,11 @@ void Gameplay::entityInit(Object * p)
 
 	getCore()->logMessage("Version: %ls (Clean)", ::version.getVersionString());
 
+    // create asset cache (budget is in megabytes)
+    int assetCacheBudget = 128;
+    details->Attribute( "assetCache", &assetCacheBudget );
+    _assetCache = new AssetCache( assetCacheBudget * 1024 * 1024 );
+
     // create input device
     _inputDevice = iInput->createInputDevice();
     createActionMap();
@@ -656,6 +665,7 @@ void Gameplay::entityAct(float dt)
         {
             delete activity;
         }
+        updatePacingState();
     }
 }
 
@@ -682,6 +692,15 @@ void Gameplay::pushActivity(Activity* activity)
 
     // current top activity become active
     activity->onBecomeActive();
+
+    updatePacingState();
+}
+
+void Gameplay::updatePacingState(void)
+{
+    // everything except of scene is paced as menu
+    bool isScene = _activities.size() && dynamic_cast<Scene*>( _activities.top() ) != NULL;
+    getCore()->setPacingState( ccor::pacingMenu, !isScene );
 }
 
 /**
@@ -755,6 +774,15 @@ engine::IClump* Gameplay::findClump(const char* name)
     return dynamic_cast<Preloaded*>( _preloaded )->findClump( name );
 }
 
+/**
+ * module local : shared assets
+ */
+
+AssetCache* Gameplay::getAssetCache(void)
+{
+    return _assetCache;
+}
+
 /**
  * module local : music & sound
  */
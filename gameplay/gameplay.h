@@ -15,6 +15,7 @@
 #include "render.h"
 #include "memstream.h"
 #include "actionmap.h"
+#include "assetcache.h"
 
 using namespace ccor;
 
@@ -46,6 +47,7 @@ private:
     input::MouseState		_mouseState;      // internal mouse buffer
 	input::JoyState			_joystickState;   // internal mouse buffer
     Activity*				_preloaded;       // preloaded activity
+    AssetCache*             _assetCache;      // assets shared between missions
     //PHYSX3
 	//NxPhysicsSDK*         _physicsSDK; // made static
     TiXmlDocument*        _config;
@@ -73,6 +75,7 @@ private:
     void generateLicensedCareerGear(Career* career);
     void generateUserCommunityEvents(void);
     void cleanupUserCommunityEvents(void);
+    void updatePacingState(void);
     void generateMissions(TiXmlElement* node, database::TournamentInfo* tournamentInfo);
 public:
     // class implementation
@@ -98,6 +101,8 @@ public:
     void saveCareers(void);
     // module local : preloaded resources
     engine::IClump* findClump(const char* name);
+    // module local : shared assets
+    AssetCache* getAssetCache(void);
     // module local : music
     void playSoundtrack(const char* resource);
     void stopSoundtrack(void);
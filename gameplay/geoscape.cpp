@@ -18,6 +18,13 @@ Geoscape::Geoscape(Career* career)
     _passedTime = 0.0f;
     _blinkingTime = 0.0f;
 
+    // location markers
+    _yellowLocation = Gameplay::iEngine->getTexture( "location1" ); assert( _yellowLocation );
+    _greenLocation = Gameplay::iEngine->getTexture( "location2" ); assert( _greenLocation );
+    _redLocation = Gameplay::iEngine->getTexture( "location3" ); assert( _redLocation );
+    _nightLocation = Gameplay::iEngine->getTexture( "location_night" ); assert( _nightLocation );
+    _markerStateIsValid = false;
+
     // create geoscape window
     _geoscape = Gameplay::iGui->createWindow( "Geoscape" ); assert( _geoscape );
     _geoscape->getPanel()->setRenderCallback( panelRenderCallback, this );
@@ -183,50 +190,45 @@ void Geoscape::updateActivity(float dt)
         }        
     }
 
-    // color location
+    // color location (when state of markers is changed)
     gui::IGuiPanel* actionPanel;
-    engine::ITexture* yellowLocation = Gameplay::iEngine->getTexture( "location1" ); assert( yellowLocation );
-    engine::ITexture* greenLocation = Gameplay::iEngine->getTexture( "location2" ); assert( greenLocation );
-    engine::ITexture* redLocation = Gameplay::iEngine->getTexture( "location3" ); assert( redLocation );
-	engine::ITexture* nightLocation = Gameplay::iEngine->getTexture( "location_night" ); assert( nightLocation );
-
-    bool nightEvent = false;
 	unsigned int i;
-    for( i=0; i<_career->getNumEvents(); i++ )
-    {
-        if( strcmp( _career->getEvent( i )->getClassName(), NIGHT_CLASS_NAME ) == 0 )            
-        {
-            if( _career->getEvent( i )->getFlags() & efActive )
-            {
-                nightEvent = true;
-                break;
-            }
-        }
-    }
-
 	DateTime datetime = getDateTime();
 
-    for( i=0; i<_locations.size(); i++ )
+    MarkerState markerState;
+    markerState.eventRevision  = _career->getEventRevision();
+    markerState.numLocations   = _locations.size();
+    markerState.playerLocation = getPlayerLocation();
+    markerState.injury         = ( _career->getVirtues()->evolution.health < 0.75f );
+    markerState.night          = ( datetime.hour < 6 || datetime.hour > 22 );
+
+    if( !_markerStateIsValid || !( _markerState == markerState ) )
     {
-        actionPanel = _locations[i]->getWindow()->getPanel()->find( "Action" ); assert( actionPanel );
-        if( _locations[i]->getPlayer() )
+        _markerState = markerState;
+        _markerStateIsValid = true;
+        for( i=0; i<_locations.size(); i++ )
         {
-            if( ( _career->getVirtues()->evolution.health < 0.75f ) )
+            actionPanel = _locations[i]->getWindow()->getPanel()->find( "Action" ); assert( actionPanel );
+            if( _locations[i]->getPlayer() )
             {
-                actionPanel->setTexture( redLocation );
+                if( markerState.injury )
+                {
+                    actionPanel->setTexture( _redLocation );
+                }
+                else if( markerState.night )
+                {
+                    actionPanel->setTexture( _nightLocation );
+                }
+                else
+                {
+                    actionPanel->setTexture( _greenLocation );
+                }
             }
-			else if ( datetime.hour < 6 || datetime.hour > 22 ) {
-				actionPanel->setTexture( nightLocation );
-			}
             else
             {
-                actionPanel->setTexture( greenLocation );
+                actionPanel->setTexture( _yellowLocation );
             }
         }
-        else
-        {
-            actionPanel->setTexture( yellowLocation );
-        }
     }
 
     // blink location
@@ -121,6 +121,29 @@ private:
             message(m), color(c), lifetime(lt) 
         {}
     };
+    /**
+     * state of location markers (markers are recolored, when state is changed)
+     */
+    struct MarkerState
+    {
+    public:
+        unsigned int eventRevision;
+        unsigned int numLocations;
+        Location*    playerLocation;
+        bool         injury;
+        bool         night;
+    public:
+        MarkerState() : eventRevision(0), numLocations(0), playerLocation(NULL), injury(false), night(false) {}
+    public:
+        inline bool operator == (const MarkerState& state) const
+        {
+            return eventRevision == state.eventRevision &&
+                   numLocations == state.numLocations &&
+                   playerLocation == state.playerLocation &&
+                   injury == state.injury &&
+                   night == state.night;
+        }
+    };
 private:
     Career*                   _career;
     bool                      _endOfActivity;
@@ -139,6 +162,12 @@ private:
     float                     _blinkingTime;
     std::vector<HistoryEntry> _history;
     std::vector<Gear>         _market; // market simulation
+    engine::ITexture*         _yellowLocation;
+    engine::ITexture*         _greenLocation;
+    engine::ITexture*         _redLocation;
+    engine::ITexture*         _nightLocation;
+    MarkerState               _markerState;
+    bool                      _markerStateIsValid;
 protected:
     // class implementation
     virtual ~Geoscape();
@@ -137,6 +137,7 @@ class MatrixConversion
 private:
     Vector3f _scale;
     Matrix4f _transformation;
+    Matrix4f _conversion; // transformation with scaled rows (scale of result is folded in)
 public:
     void setup(const Matrix4f& fromMatrix, const Matrix4f& toMatrix)
     {
@@ -147,17 +148,18 @@ public:
         orthoNormalize( fm );
         Matrix4f ifm = Gameplay::iEngine->invertMatrix( fm );
         _transformation = Gameplay::iEngine->transformMatrix( tm, ifm );
+        _conversion = _transformation;
+        scaleMatrix( _conversion, _scale );
     }
-    Matrix4f convert(const Matrix4f& fromMatrix)
+    inline Matrix4f convert(const Matrix4f& fromMatrix)
     {
-        Matrix4f result = Gameplay::iEngine->transformMatrix( _transformation, fromMatrix );
-        result[0][0] *= _scale[0], result[0][1] *= _scale[0], result[0][2] *= _scale[0];
-        result[1][0] *= _scale[1], result[1][1] *= _scale[1], result[1][2] *= _scale[1];
-        result[2][0] *= _scale[2], result[2][1] *= _scale[2], result[2][2] *= _scale[2];
-        return result;
+        return _conversion * fromMatrix;
     }
+    // writes converted pose into frame matrix, in one engine call
+    inline void synchronize(engine::IFrame* frame, const PxTransform& pose);
 public:
     Matrix4f getTransformation(void) { return _transformation; }
+    const Matrix4f* getConversion(void) { return &_conversion; }
 };
 
 // matrix multiplication
@@ -216,6 +218,13 @@ static inline Matrix4f wrap(const PxTransform& m)
     );
 }
 
+inline void MatrixConversion::synchronize(engine::IFrame* frame, const PxTransform& pose)
+{
+    Matrix4f poseMatrix = wrap( pose );
+    const Matrix4f* conversion = &_conversion;
+    Gameplay::iEngine->synchronizeFrames( 1, &frame, &conversion, &poseMatrix );
+}
+
 /*
 static inline NxMat34 wrap(const Matrix4f& rhm)
 {
@@ -162,7 +162,7 @@ void Jumper::AirplaneJump::update(float dt)
 			} else if (_jumper->getSpinalCord()->right) {
 				_phActor->addTorque(PxVec3(0,-2000.0f*dt,0));
 			}
-            _clump->getFrame()->setMatrix( _matrixConversion->convert( wrap( _phActor->getGlobalPose() ) ) );
+            _matrixConversion->synchronize( _clump->getFrame(), _phActor->getGlobalPose() );
         }
     }
     else
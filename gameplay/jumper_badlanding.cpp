@@ -90,7 +90,7 @@ void Jumper::BadLanding::update(float dt)
     _clump->getAnimationController()->setTrackSpeed( 0, animSpeed );
 
     // synchronize physics & render
-    _clump->getFrame()->setMatrix( _matrixConversion->convert( wrap( _phActor->getGlobalPose() ) ) );
+    _matrixConversion->synchronize( _clump->getFrame(), _phActor->getGlobalPose() );
     _clump->getFrame()->getLTM();
 }
 
@@ -252,7 +252,7 @@ void Jumper::CanopyOpening::update(float dt)
     if( _clump->getAnimationController()->isEndOfAnimation( 0 ) ) _endOfAction = true;
 
     // synchronize physics & render
-    _clump->getFrame()->setMatrix( _matrixConversion->convert( wrap( _phActor->getGlobalPose() ) ) );
+    _matrixConversion->synchronize( _clump->getFrame(), _phActor->getGlobalPose() );
     _clump->getFrame()->getLTM();
 }
 
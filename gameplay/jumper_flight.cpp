@@ -222,7 +222,7 @@ void Jumper::Flight::update(float dt)
     }
 
     // synchronize physics & render
-    _clump->getFrame()->setMatrix( _matrixConversion->convert( wrap( _phActor->getGlobalPose() ) ) );
+    _matrixConversion->synchronize( _clump->getFrame(), _phActor->getGlobalPose() );
     _clump->getFrame()->getLTM();
 
 
@@ -89,7 +89,7 @@ void Jumper::Landing::update(float dt)
     }
 
     // synchronize physics & render
-    _clump->getFrame()->setMatrix( _matrixConversion->convert( wrap( _phActor->getGlobalPose() ) ) );
+    _matrixConversion->synchronize( _clump->getFrame(), _phActor->getGlobalPose() );
     _clump->getFrame()->getLTM();
 
     // check if character is stopped
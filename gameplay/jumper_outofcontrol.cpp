@@ -85,7 +85,7 @@ void Jumper::OutOfControl::update(float dt)
     updateAnimation( dt * animSpeed );
     
     // synchronize physics & render
-    _clump->getFrame()->setMatrix( _matrixConversion->convert( wrap( _phActor->getGlobalPose() ) ) );
+    _matrixConversion->synchronize( _clump->getFrame(), _phActor->getGlobalPose() );
     _clump->getFrame()->getLTM();
 
     // sequence blending 
@@ -135,7 +135,7 @@ void Jumper::Pull::update(float dt)
 
 	updateProceduralAnimation( dt );
     // synchronize physics & render
-    _clump->getFrame()->setMatrix( _matrixConversion->convert( wrap( _phActor->getGlobalPose() ) ) );
+    _matrixConversion->synchronize( _clump->getFrame(), _phActor->getGlobalPose() );
     _clump->getFrame()->getLTM();
 
     // update controls
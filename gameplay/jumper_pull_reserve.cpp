@@ -96,7 +96,7 @@ void Jumper::PullReserve::update(float dt)
     updateAnimation( dt );
 
     // synchronize physics & render
-    _clump->getFrame()->setMatrix( _matrixConversion->convert( wrap( _phActor->getGlobalPose() ) ) );
+    _matrixConversion->synchronize( _clump->getFrame(), _phActor->getGlobalPose() );
     _clump->getFrame()->getLTM();
 
     // look for opening
@@ -121,7 +121,7 @@ void Jumper::RunningJump::update(float dt)
     }
     else
     {
-        _clump->getFrame()->setMatrix( _matrixConversion->convert( wrap( _phActor->getGlobalPose() ) ) );
+        _matrixConversion->synchronize( _clump->getFrame(), _phActor->getGlobalPose() );
     }
 
     if( _clump->getAnimationController()->isEndOfAnimation( 0 ) )
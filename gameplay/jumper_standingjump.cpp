@@ -100,7 +100,7 @@ void Jumper::StandingJump::update(float dt)
         }
         else
         {
-            _clump->getFrame()->setMatrix( _matrixConversion->convert( wrap( _phActor->getGlobalPose() ) ) );
+            _matrixConversion->synchronize( _clump->getFrame(), _phActor->getGlobalPose() );
         }
 		if( _jumper->getSpinalCord()->modifier) _endOfAction = true;
     }
@@ -536,7 +536,7 @@ void Jumper::Tracking::update(float dt)
 							pxmat.column3[0], pxmat.column3[1], pxmat.column3[2], pxmat.column3[3]);
 */
 	//_clump->getFrame()->setMatrix( _matrixConversion->convert( wrap(_phActor->getGlobalPose()) ) ); 
-	_clump->getFrame()->setMatrix( _matrixConversion->convert( wrap(result) ) ); 
+	_matrixConversion->synchronize( _clump->getFrame(), result );
     updateProceduralAnimation( dt );
     _clump->getFrame()->getLTM();
 
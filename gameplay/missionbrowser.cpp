@@ -41,6 +41,9 @@ void MissionBrowser::Camera::onUpdateActivity(float dt)
 
 void MissionBrowser::onUpdateActivity(float dt)
 {
+    // show thumbnails are loaded in background
+    if( _thumbnailCache->update() ) updateGui();
+
     // update footnote
     _footnoteTime -= dt;
     _footnoteTime = _footnoteTime < 0 ? 0 : _footnoteTime;
@@ -92,10 +95,25 @@ MissionBrowser::MissionBrowser(Scene* scene, const Matrix4f& cameraPose, float c
 
     _source.push( new TournamentSource( _scene->getLocation()->getDatabaseId(), scene->getCareer() ) );
     _topItem      = 0;
+    _lastTopItem  = 0;
+    _scrollBack   = false;
     _selectedItem = -1;
 
+    // cache of thumbnails (few pages of items)
+    _thumbnailCache = new ThumbnailCache( 6 * MBGUI_NUMITEMS );
+
     _footnote = Gameplay::iGui->createWindow( "Footnote" ); assert( _footnote );
     _footnoteTime = 0.0f;
+
+    // cache lookups of browser controls
+    static const char* itemNames[MBGUI_NUMITEMS] = { "Item01", "Item02", "Item03", "Item04", "Item05" };
+    _sliderHandle = gui::PanelHandle( _browser->getPanel(), "Slider" );
+    for( unsigned int i=0; i<MBGUI_NUMITEMS; i++ )
+    {
+        _itemHandles[i] = gui::PanelHandle( _browser->getPanel(), itemNames[i] );
+        gui::IGuiPanel* item = _itemHandles[i].resolve(); assert( item );
+        _thumbnailHandles[i] = gui::PanelHandle( item, "Thumbnail" );
+    }
 }
 
 MissionBrowser::~MissionBrowser()
@@ -106,6 +124,7 @@ MissionBrowser::~MissionBrowser()
         _source.pop();
     }
     releaseThumbnails();
+    delete _thumbnailCache;
     _browser->getPanel()->release();
     delete _camera;
 }
@@ -171,7 +190,7 @@ void MissionBrowser::messageCallback(gui::Message* message, void* userData)
     // mouse wheel event?
     if( message->event == gui::onMouseWheel )
     {
-        gui::IGuiPanel* slider =__this->_browser->getPanel()->find( "Slider" );
+        gui::IGuiPanel* slider = __this->_sliderHandle.resolve();
         assert( slider && slider->getSlider() );
         __this->_topItem += int( message->mouseX );
         slider->getSlider()->setPosition( float( __this->_topItem ) );
@@ -181,7 +200,7 @@ void MissionBrowser::messageCallback(gui::Message* message, void* userData)
     // slider event?
     if( message->event == gui::onSlide )
     {
-        gui::IGuiPanel* slider =__this->_browser->getPanel()->find( "Slider" );
+        gui::IGuiPanel* slider = __this->_sliderHandle.resolve();
         assert( slider && slider->getSlider() );
         __this->_topItem = unsigned int( slider->getSlider()->getPosition() );
         __this->updateGui();
@@ -229,7 +248,7 @@ void MissionBrowser::messageCallback(gui::Message* message, void* userData)
         else if( strcmp( message->origin->getName(), "ScrollUp" ) == 0 )
         {
             __this->_topItem--;
-            gui::IGuiPanel* slider =__this->_browser->getPanel()->find( "Slider" );
+            gui::IGuiPanel* slider = __this->_sliderHandle.resolve();
             assert( slider && slider->getSlider() );            
             slider->getSlider()->setPosition( float( __this->_topItem ) );
             __this->updateGui();
@@ -237,7 +256,7 @@ void MissionBrowser::messageCallback(gui::Message* message, void* userData)
         else if( strcmp( message->origin->getName(), "ScrollDown" ) == 0 )
         {
             __this->_topItem++;
-            gui::IGuiPanel* slider =__this->_browser->getPanel()->find( "Slider" );
+            gui::IGuiPanel* slider = __this->_sliderHandle.resolve();
             assert( slider && slider->getSlider() );            
             slider->getSlider()->setPosition( float( __this->_topItem ) );
             __this->updateGui();
@@ -260,8 +279,11 @@ void MissionBrowser::updateGui(void)
         _topItem = _source.top()->getNumItems() - MBGUI_NUMITEMS;
     }
 
+    // previous requests of thumbnails are obsolete
+    _thumbnailCache->cancelRequests();
+
     // retrieve slider
-    gui::IGuiPanel* slider = _browser->getPanel()->find( "Slider" );
+    gui::IGuiPanel* slider = _sliderHandle.resolve();
     assert( slider && slider->getSlider() );
 
     // update slider
@@ -275,29 +297,11 @@ void MissionBrowser::updateGui(void)
     for( unsigned int i=0; i<MBGUI_NUMITEMS; i++ )
     {        
         // slot item
-        gui::IGuiPanel* item = NULL;        
-        switch( i )
-        {
-        case 0: 
-            item = _browser->getPanel()->find( "Item01" );
-            break;
-        case 1:
-            item = _browser->getPanel()->find( "Item02" );
-            break;
-        case 2:
-            item = _browser->getPanel()->find( "Item03" );
-            break;
-        case 3:
-            item = _browser->getPanel()->find( "Item04" );
-            break;
-        case 4:
-            item = _browser->getPanel()->find( "Item05" );
-            break;
-        }
+        gui::IGuiPanel* item = _itemHandles[i].resolve();
         assert( item );
 
         // item controls
-        gui::IGuiPanel* thumbnail = item->find( "Thumbnail" ); assert( thumbnail );
+        gui::IGuiPanel* thumbnail = _thumbnailHandles[i].resolve(); assert( thumbnail );
         gui::IGuiPanel* name      = item->find( "Name" ); assert( name && name->getButton() );
         gui::IGuiPanel* wtf       = item->find( "WTF" ); assert( wtf );
 
@@ -345,6 +349,9 @@ void MissionBrowser::updateGui(void)
         }
     }
 
+    // prefetch next page of thumbnails
+    prefetchThumbnails();
+
     float missionTime = 0;
 
     // update weather icon
@@ -530,7 +537,7 @@ void MissionBrowser::updateGui(void)
     engine::ITexture* thumbnail = NULL;
     if( _selectedItem == -1 )
     {
-        thumbnail = getThumbnail( _source.top()->getDefaultThumbnail() ); assert( thumbnail );
+        thumbnail = getPlaceholder(); assert( thumbnail );
     }
     else
     {
@@ -542,28 +549,44 @@ void MissionBrowser::updateGui(void)
 
 engine::ITexture* MissionBrowser::getThumbnail(const char* resource)
 {
-    ThumbnailI thumbnailI = _thumbnails.find( resource );
-    if( thumbnailI == _thumbnails.end() )
-    {
-        engine::ITexture* texture = Gameplay::iEngine->createTexture( resource ); assert( texture );
-        _thumbnails.insert( Thumbnail( resource, texture ) );
-        return texture;
-    }
-    else
-    {
-        return thumbnailI->second;
-    }
+    // placeholder is shown until thumbnail is loaded
+    engine::ITexture* texture = _thumbnailCache->getThumbnail( resource );
+    if( texture ) return texture;
+    return getPlaceholder();
+}
+
+engine::ITexture* MissionBrowser::getPlaceholder(void)
+{
+    // placeholder & thumbnail of the same resource are the same texture
+    return _thumbnailCache->getPlaceholder( _source.top()->getDefaultThumbnail() );
 }
 
 void MissionBrowser::releaseThumbnails(void)
 {
-    for( ThumbnailI thumbnailI = _thumbnails.begin();
-                    thumbnailI != _thumbnails.end();
-                    thumbnailI++ )
+    _thumbnailCache->cancelRequests();
+    _thumbnailCache->clear();
+}
+
+void MissionBrowser::prefetchThumbnails(void)
+{
+    // scroll direction changes only when top item moves
+    // (arrival of thumbnails also refreshes gui, that isn't a scroll)
+    if( _topItem != _lastTopItem )
+    {
+        _scrollBack  = ( _topItem < _lastTopItem );
+        _lastTopItem = _topItem;
+    }
+
+    // next page in scroll direction
+    int numItems = int( _source.top()->getNumItems() );
+    int firstItem = _scrollBack ? _topItem - MBGUI_NUMITEMS : _topItem + MBGUI_NUMITEMS;
+    for( int i=0; i<MBGUI_NUMITEMS; i++ )
     {
-        thumbnailI->second->release();
+        if( firstItem + i >= 0 && firstItem + i < numItems )
+        {
+            _thumbnailCache->prefetch( _source.top()->getThumbnail( firstItem + i ) );
+        }
     }
-    _thumbnails.clear();
 }
 
 void MissionBrowser::setFootnote(const wchar_t* text, float time)
@@ -3,6 +3,7 @@
 #define MISSION_BROWSER_MODE_INCLUDED
 
 #include "headers.h"
+#include "thumbnailcache.h"
 #include "scene.h"
 #include "callback.h"
 #include "sensor.h"
@@ -85,9 +86,6 @@ class MissionBrowser : public Mode
 {
 private:
     typedef std::stack<BrowserSource*> BrowserSourceStack;
-    typedef std::pair<std::string,engine::ITexture*> Thumbnail;
-    typedef std::map<std::string,engine::ITexture*> Thumbnails;
-    typedef Thumbnails::iterator ThumbnailI;
 private:
     /**
      * local camera
@@ -111,12 +109,17 @@ private:
 private:
     Camera*            _camera;
     gui::IGuiWindow*   _browser;
-    Thumbnails         _thumbnails;
+    ThumbnailCache*    _thumbnailCache; // thumbnails of items & placeholders (default thumbnails)
+    int                _lastTopItem;    // to detect scroll direction
+    bool               _scrollBack;     // last scroll direction was towards first item
     BrowserSourceStack _source;
     int                _topItem;
     int                _selectedItem;
     gui::IGuiWindow*   _footnote;
     float              _footnoteTime;
+    gui::PanelHandle   _sliderHandle;
+    gui::PanelHandle   _itemHandles[MBGUI_NUMITEMS];
+    gui::PanelHandle   _thumbnailHandles[MBGUI_NUMITEMS];
 private:
     // gui messaging
     static void messageCallback(gui::Message* message, void* userData);
@@ -125,6 +128,8 @@ private:
     void updateGui(void);
     void onClickItem(unsigned int itemId);
     engine::ITexture* getThumbnail(const char* resource);
+    engine::ITexture* getPlaceholder(void);
+    void prefetchThumbnails(void);
     void releaseThumbnails(void);    
 public:
     // actor abstracts
@@ -237,7 +237,7 @@ void PilotchuteSimulator::onUpdateActivity(float dt)
     }
     else if( isDropped() )
     {        
-        _pilotClump->getFrame()->setMatrix( _mcPilotchute.convert( wrap( _phPilotchute->getGlobalPose() ) ) );
+        _mcPilotchute.synchronize( _pilotClump->getFrame(), _phPilotchute->getGlobalPose() );
         _pilotClump->getFrame()->getLTM();
 		if (_cordClump) {
 			Jumper::placeCord( _cordClump, _phConnectedFrame->getPos(), _pilotClump->getFrame()->getPos() );
@@ -1,4 +1,5 @@
 #include "pose.h"
+#include <xmmintrin.h>
 
 /**
  * class implementation
@@ -19,6 +20,39 @@ const char *Pose::jointnames[] = {"Head",			// head
 								  "RKluchitsa"		// rshoulder
 								  };
 
+/**
+ * module locals
+ */
+
+// out[i] = a[i] * antiprog + b[i] * prog, out may be the same array as a or b
+static inline void blendFloats(float *out, const float *a, const float *b, int n, float antiprog, float prog) {
+	__m128 anti4 = _mm_set1_ps(antiprog);
+	__m128 prog4 = _mm_set1_ps(prog);
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
+		_mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a + i), anti4), _mm_mul_ps(_mm_loadu_ps(b + i), prog4)));
+	}
+	for (; i < n; ++i) {
+		out[i] = (a[i] * antiprog) + (b[i] * prog);
+	}
+}
+
+// SoA airfoils of pose <-> AoS airfoils of pose
+static inline void packAirfoils(float *soa, const PxVec3 *airfoils, const float *areas) {
+	for (int i = 0; i < POSEANIM_JOINTS; ++i) {
+		soa[i] = airfoils[i].x;
+		soa[POSEANIM_JOINTS + i] = airfoils[i].y;
+		soa[POSEANIM_JOINTS*2 + i] = airfoils[i].z;
+		soa[POSEANIM_JOINTS*3 + i] = areas[i];
+	}
+}
+static inline void unpackAirfoils(const float *soa, PxVec3 *airfoils, float *areas) {
+	for (int i = 0; i < POSEANIM_JOINTS; ++i) {
+		airfoils[i] = PxVec3(soa[i], soa[POSEANIM_JOINTS + i], soa[POSEANIM_JOINTS*2 + i]);
+		areas[i] = soa[POSEANIM_JOINTS*3 + i];
+	}
+}
+
 Pose::Pose() {
 	this->A = 0;
 	this->L = 0;
@@ -56,14 +90,11 @@ void Pose::resetPose(double dt) {
 		this->force = (this->restPose->force * antiprog) + (this->targetPose->force * prog);
 		this->torque = (this->restPose->torque * antiprog) + (this->targetPose->torque * prog);
 
-		for (int i = 0; i < POSEANIM_JOINTS_ALL; ++i) {
-			if (i < POSEANIM_JOINTS) {
-				this->airfoils_now[i] = (this->restPose->airfoils[i] * antiprog) + (this->targetPose->airfoils[i] * prog);
-				this->airfoils_area_now[i] = (this->restPose->airfoils_area_now[i] * antiprog) + (this->targetPose->airfoils_area_now[i] * prog);
-			}
-			this->jointaxis[i] = (this->restPose->jointaxis[i] * antiprog) + (this->targetPose->jointaxis[i] * prog);
-			this->jointangles[i] = (this->restPose->jointangles[i] * antiprog) + (this->targetPose->jointangles[i] * prog);
-		}
+		// joint arrays are blended as flat float arrays (PxVec3 is a tight triple of floats)
+		blendFloats(&this->airfoils_now[0].x, &this->restPose->airfoils[0].x, &this->targetPose->airfoils[0].x, POSEANIM_JOINTS*3, antiprog, prog);
+		blendFloats(this->airfoils_area_now, this->restPose->airfoils_area_now, this->targetPose->airfoils_area_now, POSEANIM_JOINTS, antiprog, prog);
+		blendFloats(&this->jointaxis[0].x, &this->restPose->jointaxis[0].x, &this->targetPose->jointaxis[0].x, POSEANIM_JOINTS_ALL*3, antiprog, prog);
+		blendFloats(this->jointangles, this->restPose->jointangles, this->targetPose->jointangles, POSEANIM_JOINTS_ALL, antiprog, prog);
 
 		this->target_prog += this->target_rate * (float)dt;
 
@@ -90,6 +121,20 @@ void Pose::morphToPose(Pose *targetPose, float rate, bool force) {
 	this->target_prog = 0.0f;
 	this->target_rate = rate;
 }
+void Pose::compileAnims() {
+	this->keys.clear();
+
+	PoseAnim *d = &this->anims;
+	while (d != NULL) {
+		PoseKey key;
+		// embedded anim is addressed through the pose, so the keys remain valid for copies of pose
+		key.anim = (d == &this->anims) ? NULL : d;
+		packAirfoils(key.deltas, d->airfoils, d->airfoils_area);
+		this->keys.push_back(key);
+		d = d->next;
+	}
+}
+
 void Pose::controlPose(double dt) {
 	this->resetPose(dt);
 
@@ -99,21 +144,23 @@ void Pose::controlPose(double dt) {
 		//return;
 	}
 
+	if (this->keys.empty()) this->compileAnims();
+
+	// airfoils are accumulated in SoA form
+	float now[POSEANIM_DELTAS];
+	packAirfoils(now, this->airfoils_now, this->airfoils_area_now);
+
 	// traverse anims
-	PoseAnim *d = &this->anims;
-	while (d != NULL) {
+	for (unsigned int k = 0; k < this->keys.size(); ++k) {
+		const PoseKey &key = this->keys[k];
+		PoseAnim *d = (key.anim != NULL) ? key.anim : &this->anims;
+
 		// blocks
 		if (d->only_if_not_zero != NULL) {
-			if (*d->only_if_not_zero == 0.0f) {
-				d = d->next;
-				continue;
-			}
+			if (*d->only_if_not_zero == 0.0f) continue;
 		}
 		if (d->only_if_zero != NULL) {
-			if (*d->only_if_zero != 0.0f) {
-				d = d->next;
-				continue;
-			}
+			if (*d->only_if_zero != 0.0f) continue;
 		}
 
 		// store previous animation value
@@ -160,15 +207,10 @@ void Pose::controlPose(double dt) {
 		
 		// control!
 		d->value = value;
-		for (int i = 0; i < POSEANIM_JOINTS; ++i) {
-			// move airfoils
-			if (!d->airfoils[i].isZero()) {
-				this->airfoils_now[i] += d->airfoils[i] * value;
-			}
-			// set areas
-			if (d->airfoils_area[i] != 0.0f) {
-				this->airfoils_area_now[i] += d->airfoils_area[i] * value;
-			}
+		// move airfoils & set areas
+		__m128 value4 = _mm_set1_ps(value);
+		for (int i = 0; i < POSEANIM_DELTAS; i += 4) {
+			_mm_storeu_ps(now + i, _mm_add_ps(_mm_loadu_ps(now + i), _mm_mul_ps(_mm_loadu_ps(key.deltas + i), value4)));
 		}
 
 		// set lift
@@ -187,9 +229,9 @@ void Pose::controlPose(double dt) {
 		if (!d->force.isZero()) {
 			this->force += d->force * value;
 		}
-		d = d->next;
 	}
 
+	unpackAirfoils(now, this->airfoils_now, this->airfoils_area_now);
 
 
 }
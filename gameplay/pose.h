@@ -6,6 +6,7 @@
 #define POSEANIM_JOINTS	6		// number of joints (for physics)
 #define POSEANIM_JOINTS_ALL	10	// number of joints (for physics + only visual (knees, etc))
 #define POSEANIM_VARS	16		// number of PoseAnim vars
+#define POSEANIM_DELTAS	(POSEANIM_JOINTS*4)	// number of airfoil changes of PoseAnim (x, y, z & area per joint)
 
 enum {
 	POSEANIM_OP_MAX,	// variable of highest value is used
@@ -64,6 +65,14 @@ public:
 	~PoseAnim();
 };
 
+// PoseAnim compiled for evaluation: airfoil changes are stored in SoA form 
+// (x[], y[], z[], area[]), so they are accumulated for all joints at once
+class PoseKey {
+public:
+	PoseAnim *anim;					// source animation (NULL for anims embedded into pose)
+	float deltas[POSEANIM_DELTAS];	// CHANGE in airfoil positions & areas
+};
+
 class Pose {
 public:
 	float A;							// surface area [m^2] (unused)
@@ -90,6 +99,10 @@ public:
 
 	PoseAnim anims;
 
+	// anims in contiguous array, compiled by first controlPose() (anims shouldn't be changed after)
+	std::vector<PoseKey> keys;
+	void compileAnims();
+
 	// pose with no animation alterations
 	Pose *restPose;
 
@@ -0,0 +1,199 @@
+
+#include "headers.h"
+#include "prefetcher.h"
+
+// size of block of file, read at once (to report progress)
+static const unsigned int prefetchBlockSize = 256 * 1024;
+
+/**
+ * background thread
+ */
+
+DWORD Prefetcher::threadProc(LPVOID lpParameter)
+{
+    Prefetcher* __this = reinterpret_cast<Prefetcher*>( lpParameter );
+
+    while( true )
+    {
+        // pick next file to read
+        EnterCriticalSection( &__this->_criticalSection );
+        if( __this->_terminate )
+        {
+            LeaveCriticalSection( &__this->_criticalSection );
+            return 0;
+        }
+        File* file = NULL;
+        for( unsigned int i=0; i<__this->_files.size(); i++ )
+        {
+            if( !__this->_files[i]->started ) 
+            {
+                file = __this->_files[i];
+                break;
+            }
+        }
+        if( file == NULL )
+        {
+            LeaveCriticalSection( &__this->_criticalSection );
+            return 0;
+        }
+        // wait for memory, if budget is exceeded (single file is read in any case)
+        if( __this->_memoryUsed > 0 && __this->_memoryUsed + file->size > __this->_memoryBudget )
+        {
+            LeaveCriticalSection( &__this->_criticalSection );
+            WaitForSingleObject( __this->_releaseEvent, 10 );
+            continue;
+        }
+        file->started = true;
+        __this->_memoryUsed += file->size;
+        LeaveCriticalSection( &__this->_criticalSection );
+
+        // read file
+        char* data = NULL;
+        ccor::IResource* resource = getCore()->getResource( file->resourceName.c_str(), "rb" );
+        if( resource )
+        {
+            data = new char[file->size];
+            unsigned int offset = 0;
+            while( offset < file->size )
+            {
+                unsigned int blockSize = file->size - offset;
+                if( blockSize > prefetchBlockSize ) blockSize = prefetchBlockSize;
+                if( fread( data + offset, 1, blockSize, resource->getFile() ) != blockSize ) break;
+                offset += blockSize;
+                file->bytesRead = offset;
+            }
+            resource->release();
+            if( offset < file->size )
+            {
+                delete[] data;
+                data = NULL;
+            }
+        }
+
+        EnterCriticalSection( &__this->_criticalSection );
+        file->data = data;
+        file->ready = true;
+        LeaveCriticalSection( &__this->_criticalSection );
+    }
+}
+
+/**
+ * class implementation
+ */
+
+Prefetcher::Prefetcher(unsigned int memoryBudget)
+{
+    _memoryBudget = memoryBudget;
+    _memoryUsed = 0;
+    _terminate = false;
+    InitializeCriticalSection( &_criticalSection );
+    _releaseEvent = CreateEvent( NULL, FALSE, FALSE, NULL );
+}
+
+Prefetcher::~Prefetcher()
+{
+    terminate();
+    CloseHandle( _releaseEvent );
+    DeleteCriticalSection( &_criticalSection );
+    for( unsigned int i=0; i<_files.size(); i++ )
+    {
+        if( _files[i]->data ) delete[] _files[i]->data;
+        delete _files[i];
+    }
+}
+
+void Prefetcher::terminate(void)
+{
+    EnterCriticalSection( &_criticalSection );
+    _terminate = true;
+    LeaveCriticalSection( &_criticalSection );
+    SetEvent( _releaseEvent );
+    for( unsigned int i=0; i<_threads.size(); i++ )
+    {
+        WaitForSingleObject( _threads[i], INFINITE );
+        CloseHandle( _threads[i] );
+    }
+    _threads.clear();
+}
+
+/**
+ * class behaviour
+ */
+
+unsigned int Prefetcher::request(const char* resourceName)
+{
+    assert( _threads.size() == 0 );
+
+    // retrieve file size
+    unsigned int size = 0;
+    ccor::IResource* resource = getCore()->getResource( resourceName, "rb" );
+    if( resource )
+    {
+        fseek( resource->getFile(), 0, SEEK_END );
+        size = ftell( resource->getFile() );
+        resource->release();
+    }
+
+    _files.push_back( new File( resourceName, size ) );
+    return _files.size() - 1;
+}
+
+void Prefetcher::start(unsigned int numThreads)
+{
+    assert( _threads.size() == 0 );
+    assert( numThreads > 0 );
+
+    DWORD threadId;
+    for( unsigned int i=0; i<numThreads; i++ )
+    {
+        HANDLE threadHandle = CreateThread( NULL, 0, threadProc, this, 0, &threadId );
+        assert( threadHandle );
+        _threads.push_back( threadHandle );
+    }
+}
+
+unsigned int Prefetcher::getSize(unsigned int fileId)
+{
+    assert( fileId < _files.size() );
+    return _files[fileId]->size;
+}
+
+float Prefetcher::getProgress(unsigned int fileId)
+{
+    assert( fileId < _files.size() );
+    if( _files[fileId]->size == 0 ) return isReady( fileId ) ? 1.0f : 0.0f;
+    return float( _files[fileId]->bytesRead ) / float( _files[fileId]->size );
+}
+
+bool Prefetcher::isReady(unsigned int fileId)
+{
+    assert( fileId < _files.size() );
+    EnterCriticalSection( &_criticalSection );
+    bool result = _files[fileId]->ready;
+    LeaveCriticalSection( &_criticalSection );
+    return result;
+}
+
+const void* Prefetcher::getData(unsigned int fileId)
+{
+    assert( isReady( fileId ) );
+    return _files[fileId]->data;
+}
+
+void Prefetcher::release(unsigned int fileId)
+{
+    assert( isReady( fileId ) );
+    EnterCriticalSection( &_criticalSection );
+    if( _files[fileId]->data ) 
+    {
+        delete[] _files[fileId]->data;
+        _files[fileId]->data = NULL;
+    }
+    if( !_files[fileId]->released )
+    {
+        _memoryUsed -= _files[fileId]->size;
+        _files[fileId]->released = true;
+    }
+    LeaveCriticalSection( &_criticalSection );
+    SetEvent( _releaseEvent );
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+
+#ifndef FILE_PREFETCHER_INCLUDED
+#define FILE_PREFETCHER_INCLUDED
+
+#include "headers.h"
+
+/**
+ * file prefetcher : contents of requested files are read concurrently by few 
+ * background threads, in order of requests, up to limit of memory occupied
+ * by files; consumer takes files in any order (i.e. in order of requests) 
+ * and releases them, to make memory available for reading of next files
+ */
+
+class Prefetcher
+{
+private:
+    struct File
+    {
+    public:
+        std::string  resourceName;
+        unsigned int size;
+        char*        data;
+        unsigned int bytesRead;
+        bool         started;
+        bool         ready;
+        bool         released;
+    public:
+        File(const char* rn, unsigned int s) : 
+            resourceName(rn), size(s), data(NULL), bytesRead(0), started(false), ready(false), released(false) 
+        {}
+    };
+private:
+    std::vector<File*>  _files;
+    std::vector<HANDLE> _threads;
+    unsigned int        _memoryBudget;
+    unsigned int        _memoryUsed;
+    bool                _terminate;
+    CRITICAL_SECTION    _criticalSection;
+    HANDLE              _releaseEvent;
+private:
+    static DWORD WINAPI threadProc(LPVOID lpParameter);
+    void terminate(void);
+public:
+    // class implementation
+    Prefetcher(unsigned int memoryBudget);
+    ~Prefetcher();
+public:
+    // requests file, returns file id (all requests should be made before start)
+    unsigned int request(const char* resourceName);
+    // starts reading of requested files
+    void start(unsigned int numThreads);
+    // file properties
+    unsigned int getSize(unsigned int fileId);
+    float getProgress(unsigned int fileId);
+    bool isReady(unsigned int fileId);
+    // contents of ready file, NULL if file can't be read
+    const void* getData(unsigned int fileId);
+    // releases contents of file
+    void release(unsigned int fileId);
+};
+
+#endif
\ No newline at end of file
@@ -8,12 +8,22 @@
 #include "../common/istring.h"
 #include "currenttime.h"
 
+/**
+ * preloading properties
+ */
+
+const unsigned int preloadNumThreads   = 2;
+const unsigned int preloadMemoryBudget = 64 * 1024 * 1024;
+
 /**
  * class implementation
  */
 
 Preloaded::Preloaded()
 {
+    _prefetcher = NULL;
+    _currentAsset = 0;
+
     // create window
     _loadingWindow = Gameplay::iGui->createWindow( "Loading" );
     gui::IGuiPanel* panel = _loadingWindow->getPanel()->find( "LoadingMessage" ); assert( panel );
@@ -65,15 +75,55 @@ Preloaded::~Preloaded()
 
 void Preloaded::updateActivity(float dt)
 {
+    // files of assets are read concurrently, 
+    // but assets are created one after another, in order of container
+    Prefetcher prefetcher( preloadMemoryBudget );
+    for( unsigned int i=0; i<_preloadedAssets.size(); i++ )
+    {
+        prefetcher.request( _preloadedAssets[i].resourceName );
+    }
+    prefetcher.start( preloadNumThreads );
+    _prefetcher = &prefetcher;
+
     // act preloading
     for( unsigned int i=0; i<_preloadedAssets.size(); i++ )
     {
-        if( _preloadedAssets[i].asset ) continue;        
+        _currentAsset = i;
+        if( _preloadedAssets[i].asset ) 
+        {
+            prefetcher.release( i );
+            continue;
+        }
+        // wait for asset file
+        while( !prefetcher.isReady( i ) )
+        {
+            progressCallback( 
+                wstrformat( 
+                    Gameplay::iLanguage->getUnicodeString(4), 
+                    asciizToUnicode( _preloadedAssets[i].resourceName ).c_str() 
+                ).c_str(), 
+                0.0f, 
+                this 
+            );
+        }
         // load asset
-        _preloadedAssets[i].asset = Gameplay::iEngine->createAsset(
-            _preloadedAssets[i].assetType,
-            _preloadedAssets[i].resourceName
-        );
+        if( prefetcher.getData( i ) )
+        {
+            _preloadedAssets[i].asset = Gameplay::iEngine->createAssetFromMemory(
+                _preloadedAssets[i].assetType,
+                _preloadedAssets[i].resourceName,
+                prefetcher.getData( i ),
+                prefetcher.getSize( i )
+            );
+        }
+        else
+        {
+            _preloadedAssets[i].asset = Gameplay::iEngine->createAsset(
+                _preloadedAssets[i].assetType,
+                _preloadedAssets[i].resourceName
+            );
+        }
+        prefetcher.release( i );
         // rename content clumps
         callback::ClumpL clumpL;
         callback::ClumpI clumpI;
@@ -85,6 +135,7 @@ void Preloaded::updateActivity(float dt)
         // preprocess asset
         xpp::preprocessXAsset( _preloadedAssets[i].asset );
     }
+    _prefetcher = NULL;
 
     // start credits
     Gameplay::iGameplay->pushActivity( new Credits() );
@@ -94,6 +145,9 @@ void Preloaded::progressCallback(const wchar_t* description, float progress, voi
 {
     Preloaded* __this = reinterpret_cast<Preloaded*>( userData );
 
+    // combined progress of preloading
+    if( __this->_prefetcher ) progress = __this->getProgress( progress );
+
     // update & render Gui
     __this->_loadingMessage->setText( wstrformat( L"%s...%2.1f%%", description, progress*100 ).c_str() );
     Gameplay::iEngine->getDefaultCamera()->beginScene( 
@@ -108,6 +162,23 @@ void Preloaded::progressCallback(const wchar_t* description, float progress, voi
     Gameplay::iAudio->updateStreamSounds();
 }
 
+float Preloaded::getProgress(float assetProgress)
+{
+    // each asset is weighted by its file size, reading & creation are halves of asset progress
+    float progress = 0.0f;
+    float totalWeight = 0.0f;
+    for( unsigned int i=0; i<_preloadedAssets.size(); i++ )
+    {
+        float weight = float( _prefetcher->getSize( i ) ) + 1.0f;
+        float creationProgress = 0.0f;
+        if( i < _currentAsset ) creationProgress = 1.0f;
+        if( i == _currentAsset ) creationProgress = assetProgress;
+        progress += weight * 0.5f * ( _prefetcher->getProgress( i ) + creationProgress );
+        totalWeight += weight;
+    }
+    return progress / totalWeight;
+}
+
 bool Preloaded::endOfActivity(void)
 {
     return false;
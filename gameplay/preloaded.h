@@ -8,6 +8,7 @@
 #include "../shared/gui.h"
 
 #include "activity.h"
+#include "prefetcher.h"
 
 using namespace ccor;
 
@@ -41,8 +42,11 @@ private:
     gui::IGuiWindow*            _loadingWindow;
     gui::IGuiStaticText*        _loadingMessage;
     std::vector<PreloadedAsset> _preloadedAssets;
+    Prefetcher*                 _prefetcher;   // reads files of assets while preloading
+    unsigned int                _currentAsset; // asset is created now
 private:
     static void progressCallback(const wchar_t* description, float progress, void* userData);
+    float getProgress(float assetProgress);
 protected:
     virtual ~Preloaded();
 public:
@@ -9,6 +9,13 @@
 #include "mission.h"
 #include "interrupt.h"
 #include "forest.h"
+#include "smokepool.h"
+
+/**
+ * unloading properties
+ */
+
+const float unloadTimeSlice = 0.01f; // time given for scene unloading per frame, seconds
 
 /**
  * class implementation
@@ -20,6 +27,10 @@ Scene::Scene(Career* career, Location* location, float holdingTime)
 
     _isLoaded       = false;
     _endOfActivity  = false;
+    _isUnloading    = false;
+    _isUnloaded     = false;
+    _numUnloadSteps = 0;
+    _unloadStep     = 0;
     _career         = career;
     _holdingTime    = holdingTime;
     _passedTime     = 0;
@@ -42,7 +53,9 @@ Scene::Scene(Career* career, Location* location, float holdingTime)
     _lastCameraPose.set( 1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1 );
     _timeSpeed = _timeSpeedMultiplier = 1.0f;    
     _windTime = 0.0f;
+    _wind = PxVec3( 0,0,0 );
     _modeQuery = NULL;
+    _activityStep = 0;
 
     _switchHUDTimeout = 0.0f;
     _isHUDEnabled     = true;
@@ -84,11 +97,20 @@ Scene::Scene(Career* career, Location* location, float holdingTime)
 
     setCamera( NULL );
 
+    // initial wind
+    updateWind();
+
     // gui stuff
     _loadingWindow = Gameplay::iGui->createWindow( "Loading" );
 
     // create clip sensor
     _clipRay = new Sensor;
+
+    // create pool of smoke emitters
+    int smokePoolCapacity = 32;
+    TiXmlElement* details = Gameplay::iGameplay->getConfigElement( "details" ); assert( details );
+    details->Attribute( "smokePool", &smokePoolCapacity );
+    _smokePool = new SmokePool( smokePoolCapacity > 0 ? smokePoolCapacity : 0 );
 }
 
 Scene::~Scene()
@@ -96,71 +118,186 @@ Scene::~Scene()
     // clipping  helper
     delete _clipRay;
 
-    // release loading window
-    _loadingWindow->getPanel()->release();
-
     // release physics
     if( _phTerrainVerts ) delete[] _phTerrainVerts;
     if( _phTerrainTriangles ) delete[] _phTerrainTriangles;
     //if( _phTerrainMaterials ) delete[] _phTerrainMaterials;
 
+    // release everything, that isn't released by time-sliced unloading
+    while( !unload() );
+
+    // smoke actors are released, so the pool holds idle emitters only
+    delete _smokePool;
+
+    // release loading window
+    if( _isUnloading ) Gameplay::iGui->getDesktop()->removePanel( _loadingWindow->getPanel() );
+    _loadingWindow->getPanel()->release();
+
+    if( _reverberation ) delete _reverberation;
+
+    assert( _camera == NULL );
+}
+
+/**
+ * unloading : scene resources are released in order of dependency,
+ * (modes & actors before PhysX scene, renderings before stage asset),
+ * each call releases a portion of resources
+ */
+
+bool Scene::unload(void)
+{
     // release modes
-    while( _modes.size() )
+    if( _modes.size() )
     {
         _modes.top()->onSuspend();
         delete _modes.top();
         _modes.pop();
         if( _modes.size() ) _modes.top()->onResume();
+        return false;
     }
 
 	// release network
-	if (network != NULL) {
+	if( network != NULL )
+    {
 		network->stopSending();
 		delete network;
+        network = NULL;
+        return false;
 	}
 
-    // release scenery actors
-    delete _scenery;
+    // release scenery actors, one by one (in order of Actor destructor)
+    if( _scenery )
+    {
+        ActorV children = _scenery->getChildren();
+        if( children.size() )
+        {
+            delete *children.begin();
+        }
+        else
+        {
+            delete _scenery;
+            _scenery = NULL;
+        }
+        return false;
+    }
 
-	if( _phScene ) _phScene->release();
+	if( _phScene ) 
+    {
+        _phScene->release();
+        _phScene = NULL;
+        return false;
+    }
 
-    for( EnclosureI enclosureI = _enclosures.begin();
-                    enclosureI != _enclosures.end();
-                    enclosureI++ )
+    if( _enclosures.size() )
+    {
+        for( EnclosureI enclosureI = _enclosures.begin();
+                        enclosureI != _enclosures.end();
+                        enclosureI++ )
+        {
+            delete enclosureI->second;
+        }
+        _enclosures.clear();
+        return false;
+    }
+
+    if( _grass || _grassTexture || _rain || _rainTexture )
     {
-        delete enclosureI->second;
+        if( _grass ) 
+        {
+            _stage->remove( _grass );
+            _grass->release();
+            _grass = NULL;
+        }
+        if( _grassTexture ) _grassTexture->release();
+        _grassTexture = NULL;
+        if( _rain ) 
+        {
+            _stage->remove( _rain );
+            _rain->release();
+            _rain = NULL;
+        }
+        if( _rainTexture ) _rainTexture->release();
+        _rainTexture = NULL;
+        return false;
     }
 
-    if( _grass ) 
+    // release assets, one by one
+    if( _localAssets.size() )
     {
-        _stage->remove( _grass );
-        _grass->release();
+        Gameplay::iGameplay->getAssetCache()->release( _localAssets.front() );
+        _localAssets.pop_front();
+        return false;
     }
-    if( _grassTexture ) _grassTexture->release();
-    if( _rain ) 
+    if( _extrasAsset ) 
     {
-        _stage->remove( _rain );
-        _rain->release();
+        // occluders are copied from extras, stage may outlive this scene in asset cache
+        if( _stage ) _stage->removeOccluders();
+        _extrasAsset->release();
+        _extrasAsset = NULL;
+        return false;
+    }
+    if( _stageAsset ) 
+    {
+        _stageAsset->release();
+        _stageAsset = NULL;
+        _stage = NULL;
+        return false;
+    }
+    if( _panoramaAsset ) 
+    {
+        _panoramaAsset->release();
+        _panoramaAsset = NULL;
+        _panorama = NULL;
+        return false;
     }
-    if( _rainTexture ) _rainTexture->release();
 
-    for( AssetI assetI=_localAssets.begin(); assetI!=_localAssets.end(); assetI++ )
+    if( _localTextures.size() )
     {
-        (*assetI)->release();
+        for( TextureI textureI = _localTextures.begin();
+                      textureI != _localTextures.end(); 
+                      textureI++ )
+        {
+            (*textureI)->release();
+        }
+        _localTextures.clear();
+        return false;
     }
-    if( _extrasAsset ) _extrasAsset->release();
-    if( _stageAsset ) _stageAsset->release();
-    if( _panoramaAsset ) _panoramaAsset->release();
-    for( TextureI textureI = _localTextures.begin();
-                  textureI != _localTextures.end(); 
-                  textureI++ )
+
+    return true;
+}
+
+void Scene::updateUnloading(void)
+{
+    // start unloading
+    if( !_isUnloading )
     {
-        (*textureI)->release();
+        _isUnloading = true;
+        _numUnloadSteps = _modes.size() + _scenery->getChildren().size() + _localAssets.size() + 9;
+        _unloadStep = 0;
+        Gameplay::iGui->getDesktop()->insertPanel( _loadingWindow->getPanel() );
+        _loadingWindow->align( gui::atBottom, 4, gui::atCenter, 0 );
     }
 
-    if( _reverberation ) delete _reverberation;
+    // release resources during time slice
+    LARGE_INTEGER frequency, startCounter, counter;
+    QueryPerformanceFrequency( &frequency );
+    QueryPerformanceCounter( &startCounter );
+    do
+    {
+        if( unload() )
+        {
+            _isUnloaded = true;
+            _unloadStep = _numUnloadSteps;
+            break;
+        }
+        _unloadStep++;
+        QueryPerformanceCounter( &counter );
+    }
+    while( float( counter.QuadPart - startCounter.QuadPart ) < unloadTimeSlice * float( frequency.QuadPart ) );
 
-    assert( _camera == NULL );
+    // transition screen
+    float progress = _unloadStep < _numUnloadSteps ? float( _unloadStep ) / float( _numUnloadSteps ) : 1.0f;
+    progressCallback( Gameplay::iLanguage->getUnicodeString( _locationInfo->nameId ), progress, this );
 }
 
 /**
@@ -364,8 +501,9 @@ void Scene::load(void)
     database::LocationInfo::AssetInfo* assetInfo = locationInfo->localAssets;
     while( assetInfo->name != NULL )
     {
-        // load asset
-        engine::IAsset* asset = Gameplay::iEngine->createAsset( engine::atXFile, assetInfo->resource );
+        // load asset (or take it from cache, if location was visited before)
+        bool isCreated;
+        engine::IAsset* asset = Gameplay::iGameplay->getAssetCache()->acquire( engine::atXFile, assetInfo->resource, &isCreated );
         assert( asset );
         // rename clumps
         asset->forAllClumps( callback::enumerateClumps, &clumps );        
@@ -374,7 +512,7 @@ void Scene::load(void)
             (*( clumpI ))->setName( assetInfo->name );
         }
         // preprocess asset
-        xpp::preprocessXAsset( asset );
+        if( isCreated ) xpp::preprocessXAsset( asset );
         // insert asset in scene storage
         _localAssets.push_back( asset );
         clumps.clear();
@@ -486,6 +624,27 @@ void Scene::load(void)
         exitPoint++;
     }
 
+    // initialize occluders : authored low-poly proxy of solid scenery, lying inside
+    // of visual meshes (collision geometry may exceed them, so it would cull visible objects)
+    int occlusion = 1;
+    details->Attribute( "occlusion", &occlusion );
+    if( occlusion )
+    {
+        for( clumpI = clumps.begin(); clumpI != clumps.end(); clumpI++ )
+        {
+            if( strcmp( (*clumpI)->getName(), "OccluderGeometry" ) == 0 )
+            {
+                (*clumpI)->getFrame()->getLTM();
+                atomicL.clear();
+                (*clumpI)->forAllAtomics( callback::enumerateAtomics, &atomicL );
+                for( atomicI = atomicL.begin(); atomicI != atomicL.end(); atomicI++ )
+                {
+                    _stage->addOccluder( *atomicI );
+                }
+            }
+        }
+    }
+
     // initialize physics
     initializePhysics();
 
@@ -763,6 +922,13 @@ void Scene::updateActivity(float dt)
         return;
     }
 
+    // scene is completed, release it during several frames
+    if( _endOfActivity )
+    {
+        updateUnloading();
+        return;
+    }
+
     // tune scene reverberation
     #ifdef GAMEPLAY_DEVELOPER_EDITION
         if( _reverberation )
@@ -849,6 +1015,9 @@ void Scene::updateActivity(float dt)
     // wind time
     _windTime += dt * getCore()->getRandToolkit()->getUniform( 0.0f, 0.25f ) *
                       getCore()->getRandToolkit()->getUniform( 0.0f, 0.25f ); 
+    updateWind();
+
+    _activityStep++;
 
     // update scenery
     _scenery->updateActivity( dt );
@@ -944,7 +1113,7 @@ void Scene::updateActivity(float dt)
 
 bool Scene::endOfActivity(void)
 {
-    return _endOfActivity;
+    return _endOfActivity && _isUnloaded;
 }
 
 void Scene::onBecomeActive(void)
@@ -1144,11 +1313,14 @@ static float blast(float t)
     return sin(t) + 0.0625f * sin( 10 * t ) + 0.1f * sin( 150 * t );
 }
 
-PxVec3 Scene::getWindAtPoint(const PxVec3& point)
+void Scene::updateWind(void)
 {
-    if( !database::LocationInfo::getRecord( _location->getDatabaseId() )->wind ) 
+    // wind is uniform in space, so it is evaluated once per step,
+    // and shared by all consumers (canopies, jumpers, smoke, rain, etc.)
+    if( !_locationInfo->wind ) 
     {
-        return PxVec3( 0,0,0 );
+        _wind = PxVec3( 0,0,0 );
+        return;
     }
 
     float windAmbient   = _location->getWindAmbient();
@@ -1160,7 +1332,12 @@ PxVec3 Scene::getWindAtPoint(const PxVec3& point)
     PxVec3 windN = wrap( _location->getWindDirection() );
     windN.normalize();
 
-    return windN * windMagnitude;
+    _wind = windN * windMagnitude;
+}
+
+PxVec3 Scene::getWindAtPoint(const PxVec3& point)
+{
+    return _wind;
 }
 
 void Scene::addParticleSystem(engine::IParticleSystem* psys)
@@ -66,6 +66,7 @@ const Matrix4f defaultPose( 1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1 );
 const Vector3f defaultVel( 0,0,0 );
 
 class Actor;
+class SmokePool;
 
 typedef std::vector<Actor*> ActorV;
 typedef ActorV::iterator ActorI;
@@ -77,6 +78,7 @@ protected:
     Scene*      _scene;    // scene
     Actor*      _parent;   // parent actor
     ActorV      _children; // team of children actors
+    bool        _hasPhysics; // actor & its children are updated with physics steps
 	
 	Airfoil **_airfoils;		// airfoils
 	int _airfoilsC;			// airfoil count
@@ -99,6 +101,8 @@ public:
     void happen(Actor* initiator, unsigned int eventId, void* eventData = NULL);
     void updateActivity(float dt);
     void updatePhysics(void);
+    // excludes actor & its children from physics steps (by default, they are updated each step)
+    void disablePhysics(void);
 
 	ActorV getChildren() { return _children; }
 	// airfoil functions
@@ -165,6 +169,10 @@ protected:
 protected:
     bool                _isLoaded;
     bool                _endOfActivity;
+    bool                _isUnloading;    // scene is released during several frames
+    bool                _isUnloaded;     // scene resources are released
+    unsigned int        _numUnloadSteps; // estimated number of unloading steps
+    unsigned int        _unloadStep;     // current unloading step
     Career*             _career;
     Location*           _location;    
     float               _holdingTime;
@@ -192,6 +200,7 @@ protected:
     float               _switchHUDTimeout;  // timeout for switch HUD action
     bool                _isHUDEnabled;      // HUD flag
     float               _windTime;          // wind simulation time
+    PxVec3              _wind;              // wind snapshot, evaluated once per step
     Actor*              _scenery;           // scenery co-ordinator, it holds common actors
     Actor*              _camera;            // current camera actor
     Matrix4f            _lastCameraPose;    // subj
@@ -201,6 +210,8 @@ protected:
     ParticleSystemL     _particleSystems;   // particle emitters
     SmokeTrailL         _smokeTrails;
     Sensor*             _clipRay;
+    unsigned int        _activityStep;      // counter of activity steps
+    SmokePool*          _smokePool;         // reusable emitters of smoke actors
 private:
     database::LocationInfo*                _locationInfo;    // subj.
     database::LocationInfo::Weather*       _locationWeather; // graphics weather options;
@@ -237,6 +248,9 @@ private:
     // decomposition of class behaviour
     void load(void);
     void initializePhysics(void);
+    void updateWind(void);
+    bool unload(void);
+    void updateUnloading(void);
 public:
     // physics handlers
 	//PHYSX3
@@ -306,6 +320,8 @@ public:
     inline PxMaterial* getPhMovingFleshMaterial(void) { return _phMovingFleshMaterial; }
     inline PxMaterial* getPhClothMaterial(void) { return _phClothMaterial; }
     inline bool isHUDEnabled(void) { return _isHUDEnabled; }
+    inline unsigned int getActivityStep(void) { return _activityStep; }
+    inline SmokePool* getSmokePool(void) { return _smokePool; }
     inline database::LocationInfo* getLocationInfo(void) { return _locationInfo; }
     inline database::LocationInfo::Weather* getLocationWeather(void) { return _locationWeather; }
     inline database::LocationInfo::Reverberation* getReverberation(void) { return _reverberation; }
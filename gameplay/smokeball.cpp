@@ -1,6 +1,7 @@
 
 #include "headers.h"
 #include "smokeball.h"
+#include "smokepool.h"
 #include "imath.h"
 
 /**
@@ -23,33 +24,14 @@ SmokeBall::SmokeBall(Actor* parent, SmokeBallDesc* desc) : Actor( parent )
     // save descriptor
     _desc = *desc;
 
+    // smokeball is decorative
+    disablePhysics();
+
     // reset flag
     _userFlag = false;
 
-    // load texture
-    engine::ITexture* texture;
-    texture = Gameplay::iEngine->getTexture( "smoke" );
-    if( !texture )
-    {
-        texture = Gameplay::iEngine->createTexture( "./res/particles/smoke.dds" );
-        texture->setMinFilter( engine::ftLinear );
-        texture->setMagFilter( engine::ftLinear );
-        texture->setMipFilter( engine::ftLinear );
-        assert( texture );
-    }
-
-    // create shader
-    _shader = Gameplay::iEngine->createShader( 1, "SmokeBallShader" ); assert( _shader );
-    _shader->setFlags( engine::sfAlphaBlending | engine::sfAlphaTesting | engine::sfLighting );
-    _shader->setAlphaTestFunction( engine::cfGreater );
-    _shader->setAlphaTestRef( 0 );
-    _shader->setLayerTexture( 0, texture );
-    _shader->setSrcBlend( engine::bmSrcAlpha );
-    _shader->setDestBlend( engine::bmInvSrcAlpha );
-    _shader->setBlendOp( engine::bpAdd );
-
-    // create particle system
-    _particleSystem = Gameplay::iEngine->createParticleSystem( _desc.numParticles, _shader, _desc.radius );
+    // acquire particle system (all particles are initialized below)
+    _particleSystem = _scene->getSmokePool()->acquireParticleSystem( _desc.numParticles, _desc.radius );
     assert( _particleSystem );
     _scene->addParticleSystem( _particleSystem );
 
@@ -122,8 +104,7 @@ SmokeBall::SmokeBall(Actor* parent, SmokeBallDesc* desc) : Actor( parent )
 SmokeBall::~SmokeBall()
 {
     _scene->removeParticleSystem( _particleSystem );
-    _particleSystem->release();
-    _shader->release();
+    _scene->getSmokePool()->releaseParticleSystem( _particleSystem, _desc.radius );
 }
 
 /** 
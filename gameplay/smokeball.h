@@ -29,7 +29,6 @@ class SmokeBall : public Actor
 {
 private:
     SmokeBallDesc            _desc;
-    engine::IShader*         _shader;
     engine::IParticleSystem* _particleSystem;
     Vector3f                 _sphereCenter;
     float                    _sphereRadius;
@@ -1,6 +1,7 @@
 
 #include "headers.h"
 #include "smokejet.h"
+#include "smokepool.h"
 #include "imath.h"
 
 /**
@@ -13,29 +14,8 @@ SmokeJet::SmokeJet(Jumper* jumper, Vector4f color, SmokeJetMode mode) : Actor( j
     _mode   = mode;
     _name   = "SmokeJet";
 
-    // load texture
-    engine::ITexture* texture;
-    texture = Gameplay::iEngine->getTexture( "smoketrail" );
-    if( !texture )
-    {
-        texture = Gameplay::iEngine->createTexture( "./res/particles/smoketrail.dds" );
-        texture->setMinFilter( engine::ftAnisotropic );
-        texture->setMagFilter( engine::ftLinear );
-        texture->setMipFilter( engine::ftLinear );
-        texture->setMaxAnisotropy( 8 );
-        assert( texture );
-    }
-
-    // create smoke trail shader
-    _shader = Gameplay::iEngine->createShader( 1, "SmokeBallShader" ); assert( _shader );
-    _shader->setFlags( engine::sfAlphaBlending | engine::sfAlphaTesting | engine::sfLighting );
-    _shader->setAlphaTestFunction( engine::cfGreater );
-    _shader->setAlphaTestRef( 0 );
-    _shader->setLayerTexture( 0, texture );
-    _shader->setSrcBlend( engine::bmSrcAlpha );
-    _shader->setDestBlend( engine::bmInvSrcAlpha );
-    _shader->setBlendOp( engine::bpAdd );
-    _shader->addReference();
+    // smokejet is decorative
+    disablePhysics();
 
     // create smoke trail scheme
     _scheme.numParticles = 256;
@@ -53,8 +33,8 @@ SmokeJet::SmokeJet(Jumper* jumper, Vector4f color, SmokeJetMode mode) : Actor( j
     _scheme.uv[3].set( 0.0f, 0.0f );
     _scheme.ambient = color;
 
-    // create smoke trail from scheme
-    _smokeTrail = Gameplay::iEngine->createSmokeTrail( _shader, &_scheme );
+    // acquire smoke trail for scheme (reused trail is empty & disabled)
+    _smokeTrail = _scene->getSmokePool()->acquireSmokeTrail( &_scheme );
 
     // start emission
     onUpdateActivity( 0.0f );
@@ -66,8 +46,7 @@ SmokeJet::SmokeJet(Jumper* jumper, Vector4f color, SmokeJetMode mode) : Actor( j
 SmokeJet::~SmokeJet()
 {
     _scene->removeSmokeTrail( _smokeTrail );
-    _smokeTrail->release();
-    _shader->release();
+    _scene->getSmokePool()->releaseSmokeTrail( _smokeTrail, &_scheme );
 }
 
 /**
@@ -18,7 +18,6 @@ private:
     SmokeJetMode             _mode;
     Jumper*                  _jumper;
     engine::SmokeTrailScheme _scheme;
-    engine::IShader*         _shader;
     engine::IRendering*      _smokeTrail;
     bool                     _enabled;
 public:
@@ -0,0 +1,210 @@
+
+#include "headers.h"
+#include "smokepool.h"
+
+/**
+ * class implementation
+ */
+
+SmokePool::SmokePool(unsigned int capacity)
+{
+    _capacity = capacity;
+    _smokeBallShader = NULL;
+    _smokeJetShader = NULL;
+}
+
+SmokePool::~SmokePool()
+{
+    // release idle emitters before shaders (emitters don't reference them)
+    for( IdleParticleSystemI idleI = _idleParticleSystems.begin();
+                             idleI != _idleParticleSystems.end();
+                             idleI++ )
+    {
+        idleI->particleSystem->release();
+    }
+    _idleParticleSystems.clear();
+    for( IdleSmokeTrailI idleI = _idleSmokeTrails.begin();
+                         idleI != _idleSmokeTrails.end();
+                         idleI++ )
+    {
+        idleI->smokeTrail->release();
+    }
+    _idleSmokeTrails.clear();
+
+    if( _smokeBallShader ) _smokeBallShader->release();
+    if( _smokeJetShader ) _smokeJetShader->release();
+
+    getCore()->logMessage( 
+        "Smoke pool: %d reuses, %d misses, %d discards", 
+        _statistics.numReuses, _statistics.numMisses, _statistics.numDiscards
+    );
+}
+
+/**
+ * private behaviour
+ */
+
+unsigned int SmokePool::getNumIdleEmitters(void)
+{
+    return _idleParticleSystems.size() + _idleSmokeTrails.size();
+}
+
+bool SmokePool::isCompatible(engine::SmokeTrailScheme* scheme1, engine::SmokeTrailScheme* scheme2)
+{
+    // ambient color may be changed by property of smoke trail, so it isn't compared
+    engine::SmokeTrailScheme scheme = *scheme2;
+    scheme.ambient = scheme1->ambient;
+    return memcmp( scheme1, &scheme, sizeof(engine::SmokeTrailScheme) ) == 0;
+}
+
+/**
+ * shaders
+ */
+
+engine::IShader* SmokePool::getSmokeBallShader(void)
+{
+    if( !_smokeBallShader )
+    {
+        // load texture
+        engine::ITexture* texture;
+        texture = Gameplay::iEngine->getTexture( "smoke" );
+        if( !texture )
+        {
+            texture = Gameplay::iEngine->createTexture( "./res/particles/smoke.dds" );
+            texture->setMinFilter( engine::ftLinear );
+            texture->setMagFilter( engine::ftLinear );
+            texture->setMipFilter( engine::ftLinear );
+            assert( texture );
+        }
+
+        // create shader
+        _smokeBallShader = Gameplay::iEngine->createShader( 1, "SmokeBallShader" ); assert( _smokeBallShader );
+        _smokeBallShader->setFlags( engine::sfAlphaBlending | engine::sfAlphaTesting | engine::sfLighting );
+        _smokeBallShader->setAlphaTestFunction( engine::cfGreater );
+        _smokeBallShader->setAlphaTestRef( 0 );
+        _smokeBallShader->setLayerTexture( 0, texture );
+        _smokeBallShader->setSrcBlend( engine::bmSrcAlpha );
+        _smokeBallShader->setDestBlend( engine::bmInvSrcAlpha );
+        _smokeBallShader->setBlendOp( engine::bpAdd );
+        _smokeBallShader->addReference();
+    }
+    return _smokeBallShader;
+}
+
+engine::IShader* SmokePool::getSmokeJetShader(void)
+{
+    if( !_smokeJetShader )
+    {
+        // load texture
+        engine::ITexture* texture;
+        texture = Gameplay::iEngine->getTexture( "smoketrail" );
+        if( !texture )
+        {
+            texture = Gameplay::iEngine->createTexture( "./res/particles/smoketrail.dds" );
+            texture->setMinFilter( engine::ftAnisotropic );
+            texture->setMagFilter( engine::ftLinear );
+            texture->setMipFilter( engine::ftLinear );
+            texture->setMaxAnisotropy( 8 );
+            assert( texture );
+        }
+
+        // create smoke trail shader
+        _smokeJetShader = Gameplay::iEngine->createShader( 1, "SmokeBallShader" ); assert( _smokeJetShader );
+        _smokeJetShader->setFlags( engine::sfAlphaBlending | engine::sfAlphaTesting | engine::sfLighting );
+        _smokeJetShader->setAlphaTestFunction( engine::cfGreater );
+        _smokeJetShader->setAlphaTestRef( 0 );
+        _smokeJetShader->setLayerTexture( 0, texture );
+        _smokeJetShader->setSrcBlend( engine::bmSrcAlpha );
+        _smokeJetShader->setDestBlend( engine::bmInvSrcAlpha );
+        _smokeJetShader->setBlendOp( engine::bpAdd );
+        _smokeJetShader->addReference();
+    }
+    return _smokeJetShader;
+}
+
+/**
+ * particle systems
+ */
+
+engine::IParticleSystem* SmokePool::acquireParticleSystem(unsigned int numParticles, float alphaSortDepth)
+{
+    for( IdleParticleSystemI idleI = _idleParticleSystems.begin();
+                             idleI != _idleParticleSystems.end();
+                             idleI++ )
+    {
+        if( idleI->particleSystem->getNumParticles() == numParticles &&
+            idleI->alphaSortDepth == alphaSortDepth )
+        {
+            engine::IParticleSystem* particleSystem = idleI->particleSystem;
+            _idleParticleSystems.erase( idleI );
+            _statistics.numReuses++;
+            return particleSystem;
+        }
+    }
+
+    _statistics.numMisses++;
+    engine::IParticleSystem* particleSystem = Gameplay::iEngine->createParticleSystem( 
+        numParticles, getSmokeBallShader(), alphaSortDepth 
+    );
+    assert( particleSystem );
+    return particleSystem;
+}
+
+void SmokePool::releaseParticleSystem(engine::IParticleSystem* particleSystem, float alphaSortDepth)
+{
+    if( getNumIdleEmitters() < _capacity )
+    {
+        IdleParticleSystem idle;
+        idle.particleSystem = particleSystem;
+        idle.alphaSortDepth = alphaSortDepth;
+        _idleParticleSystems.push_back( idle );
+    }
+    else
+    {
+        _statistics.numDiscards++;
+        particleSystem->release();
+    }
+}
+
+/**
+ * smoke trails
+ */
+
+engine::IRendering* SmokePool::acquireSmokeTrail(engine::SmokeTrailScheme* scheme)
+{
+    for( IdleSmokeTrailI idleI = _idleSmokeTrails.begin();
+                         idleI != _idleSmokeTrails.end();
+                         idleI++ )
+    {
+        if( isCompatible( &idleI->scheme, scheme ) )
+        {
+            engine::IRendering* smokeTrail = idleI->smokeTrail;
+            _idleSmokeTrails.erase( idleI );
+            smokeTrail->setProperty( "ambientColor", Vector3f( scheme->ambient[0], scheme->ambient[1], scheme->ambient[2] ) );
+            _statistics.numReuses++;
+            return smokeTrail;
+        }
+    }
+
+    _statistics.numMisses++;
+    engine::IRendering* smokeTrail = Gameplay::iEngine->createSmokeTrail( getSmokeJetShader(), scheme );
+    assert( smokeTrail );
+    return smokeTrail;
+}
+
+void SmokePool::releaseSmokeTrail(engine::IRendering* smokeTrail, engine::SmokeTrailScheme* scheme)
+{
+    if( getNumIdleEmitters() < _capacity )
+    {
+        smokeTrail->setProperty( "reset", 0.0f );
+        IdleSmokeTrail idle;
+        idle.smokeTrail = smokeTrail;
+        idle.scheme = *scheme;
+        _idleSmokeTrails.push_back( idle );
+    }
+    else
+    {
+        _statistics.numDiscards++;
+        smokeTrail->release();
+    }
+}
\ No newline at end of file
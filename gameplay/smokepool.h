@@ -0,0 +1,76 @@
+
+#ifndef SMOKE_POOL_INCLUDED
+#define SMOKE_POOL_INCLUDED
+
+#include "headers.h"
+#include "gameplay.h"
+
+/**
+ * smoke pool : keeps particle systems & smoke trails of destroyed smoke actors,
+ * so the next smoke actors of the scene reuse them (with their particle storage),
+ * instead of creating new ones; idle emitters are bounded by capacity of pool,
+ * the surplus is released immediately
+ */
+
+class SmokePool
+{
+public:
+    struct Statistics
+    {
+    public:
+        unsigned int numReuses;   // emitters taken from pool
+        unsigned int numMisses;   // emitters created due to lack of suitable idle emitter
+        unsigned int numDiscards; // emitters released due to capacity of pool
+    public:
+        Statistics() : numReuses(0), numMisses(0), numDiscards(0) {}
+    };
+private:
+    struct IdleParticleSystem
+    {
+    public:
+        engine::IParticleSystem* particleSystem;
+        float                    alphaSortDepth;
+    };
+    struct IdleSmokeTrail
+    {
+    public:
+        engine::IRendering*      smokeTrail;
+        engine::SmokeTrailScheme scheme;
+    };
+    typedef std::list<IdleParticleSystem> IdleParticleSystemL;
+    typedef IdleParticleSystemL::iterator IdleParticleSystemI;
+    typedef std::list<IdleSmokeTrail> IdleSmokeTrailL;
+    typedef IdleSmokeTrailL::iterator IdleSmokeTrailI;
+private:
+    unsigned int        _capacity;            // max. number of idle emitters
+    engine::IShader*    _smokeBallShader;     // shared by particle systems of pool
+    engine::IShader*    _smokeJetShader;      // shared by smoke trails of pool
+    IdleParticleSystemL _idleParticleSystems;
+    IdleSmokeTrailL     _idleSmokeTrails;
+    Statistics          _statistics;
+private:
+    unsigned int getNumIdleEmitters(void);
+    static bool isCompatible(engine::SmokeTrailScheme* scheme1, engine::SmokeTrailScheme* scheme2);
+public:
+    // class implementation
+    SmokePool(unsigned int capacity);
+    ~SmokePool();
+public:
+    // shaders, owned by pool
+    engine::IShader* getSmokeBallShader(void);
+    engine::IShader* getSmokeJetShader(void);
+    // particle systems, created with smoke ball shader;
+    // particles of reused system are left as they were, caller should initialize them
+    engine::IParticleSystem* acquireParticleSystem(unsigned int numParticles, float alphaSortDepth);
+    void releaseParticleSystem(engine::IParticleSystem* particleSystem, float alphaSortDepth);
+    // smoke trails, created with smoke jet shader;
+    // reused trail is reset (no particles, emission is disabled) & colored by scheme
+    engine::IRendering* acquireSmokeTrail(engine::SmokeTrailScheme* scheme);
+    void releaseSmokeTrail(engine::IRendering* smokeTrail, engine::SmokeTrailScheme* scheme);
+public:
+    // inlines
+    inline unsigned int getCapacity(void) { return _capacity; }
+    inline const Statistics* getStatistics(void) { return &_statistics; }
+};
+
+#endif
\ No newline at end of file
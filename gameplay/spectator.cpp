@@ -40,6 +40,20 @@ const float wishWatchTimeMax  = 10.0f;
 const float wishRelaxTimeMin  = 1.0f;
 const float wishRelaxTimeMax  = 10.0f;
 
+/**
+ * shared idle
+ */
+
+void Spectator::shareIdle(engine::AnimSequence* sequence)
+{
+    SharedIdle* sharedIdle = dynamic_cast<SharedIdle*>( _action );
+    if( sharedIdle && sharedIdle->getSequence() == sequence ) return;
+
+    Crowd* crowd = dynamic_cast<Crowd*>( _parent ); assert( crowd );
+    delete _action;
+    _action = new SharedIdle( _clump, sequence, crowd->getPose( sequence, _posePhase ), 0.2f );
+}
+
 /**
  * actor abstracts
  */
@@ -72,12 +86,7 @@ void Spectator::onUpdateActivity(float dt)
     {
     case wishRelax: {
         // setup corresponding action
-        if( !actionIs(Idle) || 
-            _clump->getAnimationController()->getTrackAnimation(0) != &idleSequence )
-        {
-            delete _action;
-            _action = new Character::Idle( _clump, &idleSequence, 0.2f, 1.0f );
-        }
+        shareIdle( &idleSequence );
         // decrease relax time
         _relaxTime -= dt;
         if( _relaxTime < 0 ) _endOfWish = true;
@@ -144,12 +153,7 @@ void Spectator::onUpdateActivity(float dt)
         }
         else
         {
-            if( !actionIs(Idle) ||
-                _clump->getAnimationController()->getTrackAnimation( 0 ) != &watchSequence )
-            {
-                delete _action;
-                _action = new Character::Idle( _clump, &watchSequence, 0.2f, 1.0f );
-            }
+            shareIdle( &watchSequence );
         }
         // decrease watch time
         _watchTime -= dt;
@@ -282,8 +286,12 @@ Spectator::Spectator(Crowd* crowd, engine::IClump* cloneSource, Enclosure* enclo
     );
     _clump->getFrame()->getLTM();
 
+    // choose phase of shared poses
+    _posePhase = unsigned int( getCore()->getRandToolkit()->getUniform( 0, float( Crowd::numPosePhases ) ) );
+    _posePhase = _posePhase < Crowd::numPosePhases ? _posePhase : Crowd::numPosePhases - 1;
+
     // setup idle action
-    _action = new Character::Idle( _clump, &idleSequence, 0.2f, 1.0f );
+    _action = new SharedIdle( _clump, &idleSequence, crowd->getPose( &idleSequence, _posePhase ), 0.2f );
 
     // setup wish
     _wish = wishRelax;
@@ -0,0 +1,53 @@
+
+#include "headers.h"
+#include "crowd.h"
+
+/**
+ * shared idle action for spectator:
+ * pose is evaluated by crowd once for all spectators of the same sequence & phase, 
+ * spectator only copies it, so spectators are differs by root frame transformation;
+ * per-instance evaluation is reserved for blending into shared pose
+ */
+
+Spectator::SharedIdle::SharedIdle(engine::IClump* clump, engine::AnimSequence* sequence, engine::IAnimationController* pose, float blendTime) :
+    Character::Action( clump )
+{
+    assert( pose );
+
+    _blendTime = blendTime;
+    _sequence  = sequence;
+    _pose      = pose;
+
+    engine::IAnimationController* controller = _clump->getAnimationController();
+
+    // capture blend source
+    controller->captureBlendSrc();
+
+    // reset animation mixer (own tracks are not played, while pose is shared)
+    for( unsigned int i=0; i<engine::maxAnimationTracks; i++ )
+    {
+        if( controller->getTrackAnimation( i ) ) controller->setTrackActivity( i, false );
+    }
+
+    // capture blend destination
+    controller->copyPose( _pose );
+    controller->captureBlendDst();
+    controller->blend( 0.0f );
+}
+
+void Spectator::SharedIdle::update(float dt)
+{
+    if( _actionTime != _actionTime ) _actionTime = 0.0f; // break NAN
+
+    _actionTime += dt;
+
+    engine::IAnimationController* controller = _clump->getAnimationController();
+    controller->copyPose( _pose );
+
+    // blend phase? shared pose is moving, so blend destination is captured every time
+    if( _actionTime < _blendTime )
+    {
+        controller->captureBlendDst();
+        controller->blend( _actionTime / _blendTime );
+    }
+}
\ No newline at end of file
@@ -0,0 +1,242 @@
+
+#include "headers.h"
+#include "thumbnailcache.h"
+#include "gameplay.h"
+
+/**
+ * background thread
+ */
+
+DWORD ThumbnailCache::threadProc(LPVOID lpParameter)
+{
+    ThumbnailCache* __this = reinterpret_cast<ThumbnailCache*>( lpParameter );
+
+    while( true )
+    {
+        WaitForSingleObject( __this->_requestEvent, INFINITE );
+
+        // read all requested files
+        while( true )
+        {
+            std::string resource;
+            EnterCriticalSection( &__this->_criticalSection );
+            if( __this->_terminate || __this->_requests.empty() )
+            {
+                bool terminate = __this->_terminate;
+                LeaveCriticalSection( &__this->_criticalSection );
+                if( terminate ) return 0;
+                break;
+            }
+            resource = __this->_requests.front();
+            __this->_requests.pop_front();
+            LeaveCriticalSection( &__this->_criticalSection );
+
+            File file;
+            file.resource = resource;
+            ccor::IResource* fileResource = getCore()->getResource( resource.c_str(), "rb" );
+            if( fileResource )
+            {
+                fseek( fileResource->getFile(), 0, SEEK_END );
+                file.size = ftell( fileResource->getFile() );
+                fseek( fileResource->getFile(), 0, SEEK_SET );
+                file.data = new char[file.size];
+                if( fread( file.data, 1, file.size, fileResource->getFile() ) != file.size )
+                {
+                    delete[] file.data;
+                    file.data = NULL;
+                    file.size = 0;
+                }
+                fileResource->release();
+            }
+
+            EnterCriticalSection( &__this->_criticalSection );
+            __this->_files.push_back( file );
+            LeaveCriticalSection( &__this->_criticalSection );
+        }
+    }
+}
+
+/**
+ * class implementation
+ */
+
+ThumbnailCache::ThumbnailCache(unsigned int capacity)
+{
+    assert( capacity > 0 );
+    _capacity = capacity;
+    _terminate = false;
+    InitializeCriticalSection( &_criticalSection );
+    _requestEvent = CreateEvent( NULL, FALSE, FALSE, NULL );
+    _threadHandle = CreateThread( NULL, 0, threadProc, this, 0, &_threadId );
+    assert( _threadHandle );
+}
+
+ThumbnailCache::~ThumbnailCache()
+{
+    // terminate background thread
+    EnterCriticalSection( &_criticalSection );
+    _terminate = true;
+    LeaveCriticalSection( &_criticalSection );
+    SetEvent( _requestEvent );
+    WaitForSingleObject( _threadHandle, INFINITE );
+    CloseHandle( _threadHandle );
+    CloseHandle( _requestEvent );
+    DeleteCriticalSection( &_criticalSection );
+
+    // discard files, those textures are not created
+    for( std::list<File>::iterator fileI = _files.begin(); fileI != _files.end(); fileI++ )
+    {
+        if( fileI->data ) delete[] fileI->data;
+    }
+
+    clear();
+}
+
+/**
+ * private behaviour
+ */
+
+void ThumbnailCache::request(const char* resource, bool urgent)
+{
+    if( _requested.find( resource ) != _requested.end() ) return;
+    _requested.insert( resource );
+
+    EnterCriticalSection( &_criticalSection );
+    if( urgent ) 
+    {
+        _requests.push_front( resource );
+    }
+    else
+    {
+        _requests.push_back( resource );
+    }
+    LeaveCriticalSection( &_criticalSection );
+    SetEvent( _requestEvent );
+}
+
+void ThumbnailCache::touch(EntryI entryI)
+{
+    if( entryI != _entries.begin() ) _entries.splice( _entries.begin(), _entries, entryI );
+}
+
+/**
+ * class behaviour
+ */
+
+engine::ITexture* ThumbnailCache::getThumbnail(const char* resource)
+{
+    PinnedI pinnedI = _pinned.find( resource );
+    if( pinnedI != _pinned.end() ) return pinnedI->second;
+
+    EntryMI entryMI = _index.find( resource );
+    if( entryMI != _index.end() )
+    {
+        touch( entryMI->second );
+        return entryMI->second->texture;
+    }
+
+    request( resource, true );
+    return NULL;
+}
+
+engine::ITexture* ThumbnailCache::getPlaceholder(const char* resource)
+{
+    PinnedI pinnedI = _pinned.find( resource );
+    if( pinnedI != _pinned.end() ) return pinnedI->second;
+
+    // thumbnail of the same resource is moved out of LRU list
+    engine::ITexture* texture = NULL;
+    EntryMI entryMI = _index.find( resource );
+    if( entryMI != _index.end() )
+    {
+        texture = entryMI->second->texture;
+        _entries.erase( entryMI->second );
+        _index.erase( entryMI );
+    }
+    if( texture == NULL )
+    {
+        texture = Gameplay::iEngine->createTexture( resource ); assert( texture );
+    }
+
+    _pinned.insert( PinnedT( resource, texture ) );
+    return texture;
+}
+
+void ThumbnailCache::prefetch(const char* resource)
+{
+    if( _pinned.find( resource ) != _pinned.end() ) return;
+    if( _index.find( resource ) != _index.end() ) return;
+    request( resource, false );
+}
+
+void ThumbnailCache::cancelRequests(void)
+{
+    EnterCriticalSection( &_criticalSection );
+    for( unsigned int i=0; i<_requests.size(); i++ )
+    {
+        _requested.erase( _requests[i] );
+    }
+    _requests.clear();
+    LeaveCriticalSection( &_criticalSection );
+}
+
+bool ThumbnailCache::update(void)
+{
+    // take files are read by background thread
+    std::list<File> files;
+    EnterCriticalSection( &_criticalSection );
+    files.swap( _files );
+    LeaveCriticalSection( &_criticalSection );
+
+    if( files.empty() ) return false;
+
+    for( std::list<File>::iterator fileI = files.begin(); fileI != files.end(); fileI++ )
+    {
+        _requested.erase( fileI->resource );
+        if( _index.find( fileI->resource ) != _index.end() ||
+            _pinned.find( fileI->resource ) != _pinned.end() )
+        {
+            if( fileI->data ) delete[] fileI->data;
+            continue;
+        }
+
+        engine::ITexture* texture = NULL;
+        if( fileI->data )
+        {
+            texture = Gameplay::iEngine->createTextureFromMemory( fileI->resource.c_str(), fileI->data, fileI->size );
+            delete[] fileI->data;
+        }
+        if( texture == NULL )
+        {
+            getCore()->logMessage( "Failed to load thumbnail: \"%s\"", fileI->resource.c_str() );
+        }
+
+        _entries.push_front( Entry( fileI->resource, texture ) );
+        _index.insert( EntryT( fileI->resource, _entries.begin() ) );
+
+        // evict least recently used thumbnails
+        while( _entries.size() > _capacity )
+        {
+            if( _entries.back().texture ) _entries.back().texture->release();
+            _index.erase( _entries.back().resource );
+            _entries.pop_back();
+        }
+    }
+
+    return true;
+}
+
+void ThumbnailCache::clear(void)
+{
+    for( EntryI entryI = _entries.begin(); entryI != _entries.end(); entryI++ )
+    {
+        if( entryI->texture ) entryI->texture->release();
+    }
+    _entries.clear();
+    _index.clear();
+    for( PinnedI pinnedI = _pinned.begin(); pinnedI != _pinned.end(); pinnedI++ )
+    {
+        pinnedI->second->release();
+    }
+    _pinned.clear();
+}
\ No newline at end of file
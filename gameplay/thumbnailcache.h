@@ -0,0 +1,81 @@
+
+#ifndef THUMBNAIL_CACHE_INCLUDED
+#define THUMBNAIL_CACHE_INCLUDED
+
+#include "headers.h"
+
+/**
+ * thumbnail cache : thumbnail files are read by background thread,
+ * textures are created by main thread (device isn't multithreaded),
+ * recently used textures are kept in LRU list of limited capacity,
+ * placeholders are pinned out of LRU list (single texture per resource)
+ */
+
+class ThumbnailCache
+{
+private:
+    struct File
+    {
+    public:
+        std::string  resource;
+        char*        data;
+        unsigned int size;
+    public:
+        File() : data(NULL), size(0) {}
+        File(const std::string& r, char* d, unsigned int s) : resource(r), data(d), size(s) {}
+    };
+    struct Entry
+    {
+    public:
+        std::string       resource;
+        engine::ITexture* texture; // NULL if thumbnail can't be loaded
+    public:
+        Entry(const std::string& r, engine::ITexture* t) : resource(r), texture(t) {}
+    };
+    typedef std::list<Entry> EntryL;
+    typedef EntryL::iterator EntryI;
+    typedef std::pair<std::string,EntryI> EntryT;
+    typedef std::map<std::string,EntryI> EntryM;
+    typedef EntryM::iterator EntryMI;
+    typedef std::set<std::string> RequestS;
+    typedef std::pair<std::string,engine::ITexture*> PinnedT;
+    typedef std::map<std::string,engine::ITexture*> PinnedM;
+    typedef PinnedM::iterator PinnedI;
+private:
+    unsigned int            _capacity;
+    EntryL                  _entries;   // LRU list, recently used entries first
+    EntryM                  _index;     // LRU list entries by resource name
+    RequestS                _requested; // resources, requested but not created yet
+    PinnedM                 _pinned;    // placeholders, never evicted
+    // shared with background thread
+    CRITICAL_SECTION        _criticalSection;
+    HANDLE                  _requestEvent;
+    HANDLE                  _threadHandle;
+    DWORD                   _threadId;
+    bool                    _terminate;
+    std::deque<std::string> _requests;  // queue of files to read
+    std::list<File>         _files;     // files are read
+private:
+    static DWORD WINAPI threadProc(LPVOID lpParameter);
+    void request(const char* resource, bool urgent);
+    void touch(EntryI entryI);
+public:
+    // class implementation
+    ThumbnailCache(unsigned int capacity);
+    ~ThumbnailCache();
+public:
+    // returns texture of thumbnail, or NULL if thumbnail is not loaded yet (loading is requested)
+    engine::ITexture* getThumbnail(const char* resource);
+    // returns texture of placeholder, placeholder is loaded immediately & pinned until clear()
+    engine::ITexture* getPlaceholder(const char* resource);
+    // requests thumbnail loading in advance
+    void prefetch(const char* resource);
+    // drops requests, that are not started yet
+    void cancelRequests(void);
+    // creates textures of read files, returns true if some thumbnails became available
+    bool update(void);
+    // releases all cached & pinned textures
+    void clear(void);
+};
+
+#endif
\ No newline at end of file
@@ -21,6 +21,9 @@ Traffic::Traffic(Actor* parent, TrafficDesc* desc) : Actor( parent )
     assert( desc->source );
 
     _desc = *desc;
+
+    // traffic is animated only
+    disablePhysics();
     
     // clone
     _clump = _desc.source->clone( "TrafficObject" ); assert( _clump );
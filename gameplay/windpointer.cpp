@@ -54,6 +54,7 @@ void WindPointer::onUpdateActivity(float dt)
 
 WindPointer::WindPointer(Actor* parent) : Actor( parent )
 {
+    disablePhysics();
     _signature = Gameplay::iGui->createWindow( "WindSignature" ); assert( _signature );
     _windSpeed = _signature->getPanel()->find( "WindSpeed" ); assert( _windSpeed && _windSpeed->getStaticText() );
     Gameplay::iGui->getDesktop()->insertPanel( _signature->getPanel() );
@@ -223,6 +223,7 @@ LRESULT CALLBACK MainWnd::MainWndProc(HWND hWnd, UINT message, WPARAM wParam, LP
         // translate application activation message
         else if( msg.message == WM_ACTIVATEAPP )
         {
+            _mainwnd->icore->setPacingState( ccor::pacingBackground, wParam==FALSE );
             if (wParam)
             {
                 _mainwnd->centerCursor();
@@ -295,6 +296,10 @@ LRESULT CALLBACK MainWnd::MainWndProc(HWND hWnd, UINT message, WPARAM wParam, LP
                  msg.message == WM_SYSCOMMAND 
                )
         {
+            if( msg.message == WM_SIZE )
+            {
+                _mainwnd->icore->setPacingState( ccor::pacingMinimized, wParam==SIZE_MINIMIZED );
+            }
             _mainwnd->saveWindowCenter();
             _mainwnd->icore->activate(
                 mainwnd::TriggerMainwnd::tid,
@@ -205,6 +205,36 @@ enum EntityLifeTime {
 };
 
 
+// Log message severity
+enum LogLevel {
+    logDebug,       // verbose diagnostics, filtered out by default
+    logInfo,        // regular messages
+    logWarning,     // warnings
+    logError,       // errors
+    logException    // exceptions, never filtered and never rate-limited
+};
+
+
+// Frame pacing states, the frame rate is limited by the last active state
+enum PacingState {
+    pacingGameplay,     // always active
+    pacingMenu,         // menus & loading screens
+    pacingBackground,   // application is not in foreground
+    pacingMinimized     // main window is minimized
+};
+
+
+// Frame time statistics of core act() cycle (over the last frames)
+struct FrameStatistics {
+    float targetRate;   // current frame rate limit, 0 if unlimited
+    float meanTime;     // mean frame time, sec
+    float deviation;    // standard deviation of frame time, sec
+    float minTime;      // min frame time, sec
+    float maxTime;      // max frame time, sec
+    float sleepTime;    // mean time spent in pacing sleep per frame, sec
+};
+
+
 // Trigger creation flags
 enum TriggerFlags {
     trigImmediate   = 0x1,  // immediate trigger
@@ -840,6 +870,65 @@ public:
      */
     virtual void __stdcall logMessageV(const char * fmt, va_list vl) = 0;
 
+    /**
+     * Write message of specified severity to the log.
+     * Message below the log level is rejected before it is formatted.
+     * @param level Message severity
+     * @param fmt Message format string
+     */
+    inline void __cdecl logMessage(LogLevel level, const char * fmt, ...);
+
+    /**
+     * Write message of specified severity to the log
+     * @param level Message severity
+     * @param fmt Message format string
+     * @param vl Message parameters (volatile argument list)
+     */
+    virtual void __stdcall logMessageLV(LogLevel level, const char * fmt, va_list vl) = 0;
+
+    /**
+     * Get minimal severity of messages that are written to the log
+     */
+    virtual LogLevel __stdcall getLogLevel() = 0;
+
+    /**
+     * Set minimal severity of messages that are written to the log
+     */
+    virtual void __stdcall setLogLevel(LogLevel level) = 0;
+
+    /**
+     * Wait until all messages are written to the log file.
+     * Messages are written by background thread, so call this function
+     * before reading the log file or terminating the process abnormally.
+     */
+    virtual void __stdcall flushLog() = 0;
+
+    /**
+     * Copy the most recent log messages (used for crash reports)
+     * @param buffer Memory to copy messages in, result is zero-terminated
+     * @param size Size of buffer
+     * @return Number of characters copied
+     */
+    virtual unsigned int __stdcall copyRecentLog(char * buffer, unsigned int size) = 0;
+
+//
+// Frame pacing
+//
+
+    /**
+     * Activate or deactivate frame pacing state.
+     * Each state has its own target frame rate (pacing.* in core param pack).
+     * @param state Pacing state (pacingGameplay is always active)
+     * @param active Whether the state is active
+     */
+    virtual void __stdcall setPacingState(PacingState state, bool active) = 0;
+
+    /**
+     * Get frame time statistics
+     * @param stats Structure to store statistics in
+     */
+    virtual void __stdcall getFrameStatistics(FrameStatistics * stats) = 0;
+
 //
 // System functions & other
 //
@@ -1771,5 +1860,13 @@ inline void __cdecl ICore::logMessage(const char * fmt, ...) {
     va_end(args);
 }
 
+inline void __cdecl ICore::logMessage(LogLevel level, const char * fmt, ...) {
+    if (level < getLogLevel()) return;
+    va_list args;
+    va_start(args,fmt);
+    logMessageLV(level,fmt,args);
+    va_end(args);
+}
+
 }
 #endif
@@ -677,6 +677,12 @@ public:
     virtual void __stdcall captureBlendSrc(void) = 0;
     virtual void __stdcall captureBlendDst(void) = 0;
     virtual void __stdcall blend(float interpolator) = 0;
+public:
+    /**
+     * pose sharing : copies evaluated pose of controller of the same animation set
+     * (clone of the same clump), this is cheaper than evaluating the pose again
+     */
+    virtual void __stdcall copyPose(IAnimationController* source) = 0;
 public:
     /**
      * weight set manipulation
@@ -947,6 +953,13 @@ public:
      */
     virtual Vector4f __stdcall getAmbient(unsigned int lightset = 0) = 0;
     virtual void __stdcall setPostRenderCallback(BSPRenderCallback callback, void* data) = 0;
+    /**
+     * occlusion culling: triangles of occluder atomic (low-poly proxy of the
+     * solid scenery) are copied in world space, sectors hidden behind them
+     * are skipped by rendering
+     */
+    virtual void __stdcall addOccluder(IAtomic* atomic) = 0;
+    virtual void __stdcall removeOccluders(void) = 0;
 };
 
 typedef IBSP* (*IBSPCallBack)(IBSP* bsp, void* data);
@@ -1191,6 +1204,23 @@ public:
     unsigned int atomicsRendered;      // actually rendered atomics;
     unsigned int alphaObjectsRendered; // actually rendered alpha-objects
     unsigned int shaderCacheHits;      // caching hits for shaders
+    unsigned int bspOccluded;          // bsp sectors rejected by occlusion culling
+    unsigned int batchSectorsOccluded; // batch sectors rejected by occlusion culling
+    unsigned int atomicsOccluded;      // atomics rejected by occlusion culling
+    unsigned int transientLocks;       // locks of transient geometry buffers
+    unsigned int transientDiscards;    // wraps of transient geometry buffers
+    unsigned int transientVertexBytes; // vertex data allocated in transient buffer
+    unsigned int transientIndexBytes;  // index data allocated in transient buffer
+    unsigned int transientFramePeak;   // peak of transient data allocated per frame (in bytes)
+    unsigned int particleUpdates;      // simulation steps of particle systems
+    unsigned int particleUpdatesSkipped; // simulations postponed by particle budget
+    unsigned int particlesSimulated;   // particles processed by simulation steps
+    unsigned int particleSystemsCulled; // particle systems rejected by frustrum
+    unsigned int spriteQuads;          // glow & flare quads rendered by sprite batch
+    unsigned int spriteBatches;        // draw calls of sprite batch
+    unsigned int effectFrameBlocks;    // uploads of per-frame parameter blocks of effects
+    unsigned int effectParameterSets;  // parameters set by water & waterfall effects
+    unsigned int animationPoseCopies;  // poses shared by animation controllers
 };
 
 class IEngine : public ccor::IBase
@@ -1220,6 +1250,9 @@ public:
     virtual ITexture* __stdcall createRenderTarget(int width, int height, int depth, const char* textureName) = 0;
     virtual ITexture* __stdcall createCubeRenderTarget(int size, int depth, const char* textureName) = 0;
     virtual ITexture* __stdcall createTexture(const char* resourcePath) = 0;
+    // creates texture from contents of texture file (read in advance, i.e. by background thread),
+    // returns NULL if contents are truncated or aren't DDS
+    virtual ITexture* __stdcall createTextureFromMemory(const char* resourcePath, const void* data, unsigned int size) = 0;
     virtual ITexture* __stdcall createDUDVFromNormalMap(ITexture* normalMap, const char* dudvName) = 0;
     virtual IShader* __stdcall createShader(int numLayers, const char* shaderName) = 0;
     virtual IFrame* __stdcall createFrame(const char* frameName) = 0;
@@ -1235,6 +1268,8 @@ public:
     virtual IRayIntersection* __stdcall createRayIntersection(void) = 0;
     virtual ISphereIntersection* __stdcall createSphereIntersection(void) = 0;    
     virtual IAsset* __stdcall createAsset(AssetType assetType, const char* resourcePath) = 0;
+    // creates asset from contents of resource file (read in advance, i.e. by background thread)
+    virtual IAsset* __stdcall createAssetFromMemory(AssetType assetType, const char* resourcePath, const void* data, unsigned int size) = 0;
     virtual ILoader* __stdcall createLoader(AssetType assetType, const char* resourcePath) = 0;
     virtual IParticleSystem* __stdcall createParticleSystem(unsigned int numParticles, engine::IShader* shader, float alphaSortDepth) = 0;
     virtual IRendering* __stdcall createGrass(const char* resourcePath, IAtomic* templateAtomic, ITexture* texture, GrassScheme* grassScheme, float fadeStart, float fadeEnd) = 0;
@@ -1256,6 +1291,11 @@ public:
      * utilites     
      */
     virtual IFrame* __stdcall findFrame(IFrame* root, const char* frameName) = 0;
+    // resolves a set of names in one call, unresolved names give NULL frames
+    virtual void __stdcall findFrames(IFrame* root, unsigned int numFrames, const char** frameNames, IFrame** frames) = 0;
+    // sets matrices of frames to conversions[i] * poses[i] (physics-to-render synchronization),
+    // conversions may be shared by several frames
+    virtual void __stdcall synchronizeFrames(unsigned int numFrames, IFrame** frames, const Matrix4f** conversions, const Matrix4f* poses) = 0;
     virtual IAtomic* __stdcall getAtomic(IClump* clump, IFrame* frame) = 0;
     virtual Mesh* __stdcall createMesh(unsigned int numVertices, unsigned int numTriangles, unsigned int numUVs) = 0;
     virtual void __stdcall releaseMesh(Mesh* mesh) = 0;
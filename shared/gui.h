@@ -136,6 +136,8 @@ public:
     virtual void __stdcall insertPanel(IGuiPanel* panel) = 0;
     virtual void __stdcall removePanel(IGuiPanel* panel) = 0;
     virtual IGuiPanel* __stdcall find(const char* name) = 0;
+    // revision of panel hierarchy (changed when panel or its children are inserted, removed or renamed)
+    virtual unsigned int __stdcall getRevision(void) = 0;
     /**
      * properties
      */
@@ -167,6 +169,35 @@ public:
     virtual IGuiSlider* __stdcall getSlider(void) = 0;
 };
 
+/**
+ * panel handle : cached result of IGuiPanel::find(), handle is resolved again
+ * only when hierarchy of root panel is changed, name should be a static string
+ */
+
+class PanelHandle
+{
+private:
+    IGuiPanel*   _root;
+    const char*  _name;
+    IGuiPanel*   _panel;
+    unsigned int _revision;
+public:
+    PanelHandle() : _root(NULL), _name(NULL), _panel(NULL), _revision(0) {}
+    PanelHandle(IGuiPanel* root, const char* name) : _root(root), _name(name), _panel(NULL), _revision(0) {}
+public:
+    inline IGuiPanel* resolve(void)
+    {
+        if( _root == NULL ) return NULL;
+        unsigned int revision = _root->getRevision();
+        if( _revision != revision )
+        {
+            _panel = _root->find( _name );
+            _revision = revision;
+        }
+        return _panel;
+    }
+};
+
 /**
  * static text
  */